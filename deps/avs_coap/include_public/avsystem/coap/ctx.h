@@ -32,6 +32,55 @@ typedef struct {
      * Number of incoming retransmissions. For CoAP/TCP it's always 0.
      */
     uint32_t incoming_retransmissions_count;
+
+    /**
+     * Number of packets received from the socket, including retransmissions
+     * and malformed ones. For CoAP/TCP it's always 0.
+     */
+    uint32_t incoming_packets_count;
+
+    /**
+     * Number of round-trip time samples taken from exchanges acknowledged
+     * without any retransmissions ("strong" RTT estimator input). Only
+     * gathered by CoAP/UDP contexts with RTT estimation enabled, see
+     * @ref avs_coap_udp_ctx_set_rtt_estimation ; always 0 otherwise.
+     */
+    uint32_t strong_rtt_samples_count;
+
+    /**
+     * Number of round-trip time samples taken from exchanges acknowledged
+     * after one or two retransmissions ("weak" RTT estimator input). Only
+     * gathered by CoAP/UDP contexts with RTT estimation enabled; always 0
+     * otherwise.
+     */
+    uint32_t weak_rtt_samples_count;
+
+    /**
+     * Retransmission timeout calculated by the strong RTT estimator, or zero
+     * if no strong RTT samples were taken yet.
+     */
+    avs_time_duration_t strong_rto;
+
+    /**
+     * Retransmission timeout calculated by the weak RTT estimator, or zero
+     * if no weak RTT samples were taken yet.
+     */
+    avs_time_duration_t weak_rto;
+
+    /**
+     * Overall retransmission timeout, used as a base for the initial timeout
+     * of each new confirmable CoAP/UDP message when RTT estimation is
+     * enabled. Zero if RTT estimation is not enabled.
+     */
+    avs_time_duration_t overall_rto;
+
+    /**
+     * Current number of confirmable messages that are allowed to be
+     * outstanding at the same time. Only reported by CoAP/UDP contexts with
+     * congestion control enabled, see
+     * @ref avs_coap_udp_ctx_set_congestion_control ; always 0 otherwise.
+     */
+    uint32_t congestion_window;
 } avs_coap_stats_t;
 
 typedef struct avs_coap_request_header {
@@ -291,6 +291,35 @@ avs_coap_options_dynamic_init(avs_coap_options_t *opts) {
             opts, AVS_COAP_DYNAMIC_OPTIONS_DEFAULT_SIZE);
 }
 
+/**
+ * Initializes an @ref avs_coap_options_t object as a heap-allocated copy of
+ * @p template_opts .
+ *
+ * This is intended for options that are the same for many messages, e.g.
+ * Uri-Path options of a registration: they may be serialized once into
+ * @p template_opts and then reused for each outgoing message, so that only
+ * options specific to that message need to be encoded.
+ *
+ * @param opts           Uninitialized options object. Note: this function
+ *                       MUST NOT be called on an already initialized object.
+ *                       Doing so MAY result in resource leaks.
+ *
+ * @param template_opts  Options to copy. Not modified.
+ *
+ * @param extra_capacity Number of bytes to reserve in @p opts on top of the
+ *                       size of @p template_opts , to avoid reallocation
+ *                       when adding further options.
+ *
+ * @returns <c>AVS_OK</c> for success, or <c>avs_errno(AVS_ENOMEM)</c> if there
+ *          is not enough memory. After this function returns, it is safe to
+ *          call @ref avs_coap_options_cleanup on @p opts , regardless of the
+ *          initialization result.
+ */
+avs_error_t avs_coap_options_dynamic_init_from_template(
+        avs_coap_options_t *opts,
+        const avs_coap_options_t *template_opts,
+        size_t extra_capacity);
+
 /**
  * Removes all options with given @p option_number added to @p opts.
  */
@@ -198,6 +198,74 @@ int avs_coap_udp_ctx_set_forced_incoming_mtu(avs_coap_ctx_t *ctx,
 int avs_coap_udp_ctx_set_tx_params(avs_coap_ctx_t *ctx,
                                    const avs_coap_udp_tx_params_t *tx_params);
 
+/**
+ * Enables or disables adaptive retransmission timeout estimation on
+ * a CoAP/UDP context.
+ *
+ * When enabled, the context measures the time between sending confirmable
+ * messages and receiving acknowledgements to them, and uses these samples to
+ * adapt the initial retransmission timeout, in a way similar to the CoCoA
+ * algorithm (draft-ietf-core-cocoa):
+ *
+ * - exchanges acknowledged without any retransmissions feed the "strong"
+ *   estimator, exchanges acknowledged after one or two retransmissions feed
+ *   the "weak" one; both are calculated as in RFC 6298,
+ *
+ * - the overall timeout (initially ACK_TIMEOUT) is a weighted average of
+ *   the estimators' outputs, and ages towards the 1-3 second range if no new
+ *   samples are taken,
+ *
+ * - the overall timeout replaces ACK_TIMEOUT when calculating the initial
+ *   timeout of each new message; ACK_RANDOM_FACTOR still applies,
+ *
+ * - the backoff factor applied on each retransmission is 3 if the overall
+ *   timeout is below 1 second, 1.5 if it is above 3 seconds and 2 otherwise.
+ *
+ * The current estimator state is reported by @ref avs_coap_get_stats.
+ * Values derived from transmission params, such as EXCHANGE_LIFETIME, are not
+ * affected.
+ *
+ * Disabling the estimation restores the static behavior and resets the
+ * estimator state.
+ *
+ * @param ctx     CoAP/UDP context to operate on.
+ * @param enabled true to enable RTT estimation, false to disable it.
+ *
+ * @returns 0 on success, or -1 if @p ctx is not a CoAP/UDP context created
+ *          by @ref avs_coap_udp_ctx_create.
+ */
+int avs_coap_udp_ctx_set_rtt_estimation(avs_coap_ctx_t *ctx, bool enabled);
+
+/**
+ * Enables or disables congestion control of outstanding confirmable messages
+ * on a CoAP/UDP context.
+ *
+ * By default, at most NSTART confirmable messages may be outstanding at the
+ * same time; further ones are held until earlier exchanges finish. With
+ * congestion control enabled, this limit becomes a congestion window that:
+ *
+ * - starts at NSTART,
+ *
+ * - grows by one each time as many messages as the current window size were
+ *   acknowledged without retransmissions, up to @p max_nstart,
+ *
+ * - is halved, but not below NSTART, whenever a message needs to be
+ *   retransmitted for the first time.
+ *
+ * The current window is reported by @ref avs_coap_get_stats.
+ *
+ * @param ctx        CoAP/UDP context to operate on.
+ * @param max_nstart Upper bound of the congestion window, or 0 to disable
+ *                   congestion control and go back to a fixed NSTART. MUST
+ *                   NOT be less than NSTART of the current transmission
+ *                   params.
+ *
+ * @returns 0 on success, or -1 if @p ctx is not a CoAP/UDP context created
+ *          by @ref avs_coap_udp_ctx_create or @p max_nstart is invalid.
+ */
+int avs_coap_udp_ctx_set_congestion_control(avs_coap_ctx_t *ctx,
+                                            size_t max_nstart);
+
 /**
  * Gets CoAP/UDP context transmission params.
  *
@@ -58,8 +58,12 @@ void avs_coap_ctx_cleanup(avs_coap_ctx_t **ctx) {
             avs_coap_exchange_cancel(*ctx, coap_base->server_exchanges->id);
         }
 #ifdef WITH_AVS_COAP_OBSERVE
-        while (coap_base->observes) {
-            avs_coap_observe_cancel(*ctx, coap_base->observes->id);
+        if (coap_base->observes) {
+            AVS_SORTED_SET_ELEM(avs_coap_observe_t) observe;
+            while ((observe = AVS_SORTED_SET_FIRST(coap_base->observes))) {
+                avs_coap_observe_cancel(*ctx, observe->id);
+            }
+            AVS_SORTED_SET_DELETE(&coap_base->observes);
         }
 #endif // WITH_AVS_COAP_OBSERVE
 #ifdef WITH_AVS_COAP_STREAMING_API
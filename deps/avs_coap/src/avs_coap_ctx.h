@@ -14,6 +14,7 @@
 #include <avsystem/commons/avs_list.h>
 #include <avsystem/commons/avs_prng.h>
 #include <avsystem/commons/avs_shared_buffer.h>
+#include <avsystem/commons/avs_sorted_set.h>
 
 #include <avsystem/coap/async.h>
 #include <avsystem/coap/ctx.h>
@@ -71,8 +72,11 @@ struct avs_coap_base {
     AVS_LIST(struct avs_coap_exchange) server_exchanges;
 
 #ifdef WITH_AVS_COAP_OBSERVE
-    /** Active observations. */
-    AVS_LIST(avs_coap_observe_t) observes;
+    /**
+     * Active observations, ordered by token. Created lazily when the first
+     * observation is started or restored.
+     */
+    AVS_SORTED_SET(avs_coap_observe_t) observes;
 #endif // WITH_AVS_COAP_OBSERVE
 
     /** PRNG context. */
@@ -143,6 +147,9 @@ static inline void _avs_coap_base_init(avs_coap_base_t *base,
     base->last_exchange_id = AVS_COAP_EXCHANGE_ID_INVALID;
     base->client_exchanges = NULL;
     base->server_exchanges = NULL;
+#ifdef WITH_AVS_COAP_OBSERVE
+    base->observes = NULL;
+#endif // WITH_AVS_COAP_OBSERVE
     base->prng_ctx = prng_ctx;
     base->socket = NULL;
     base->in_buffer = in_buffer;
@@ -228,13 +235,10 @@ _avs_coap_find_server_exchange_by_id(avs_coap_ctx_t *ctx,
 #ifdef WITH_AVS_COAP_OBSERVE
 static inline bool _avs_coap_is_observe(avs_coap_ctx_t *ctx,
                                         const avs_coap_token_t *token) {
-    AVS_LIST(avs_coap_observe_t) it;
-    AVS_LIST_FOREACH(it, _avs_coap_get_base(ctx)->observes) {
-        if (avs_coap_token_equal(&it->id.token, token)) {
-            return true;
-        }
-    }
-    return false;
+    const avs_coap_observe_id_t id = {
+        .token = *token
+    };
+    return _avs_coap_observe_find(ctx, &id) != NULL;
 }
 #endif // WITH_AVS_COAP_OBSERVE
 
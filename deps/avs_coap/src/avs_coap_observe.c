@@ -11,6 +11,8 @@
 
 #ifdef WITH_AVS_COAP_OBSERVE
 
+#    include <string.h>
+
 #    include <avsystem/commons/avs_errno.h>
 #    include <avsystem/commons/avs_persistence.h>
 
@@ -26,7 +28,23 @@
 
 VISIBILITY_SOURCE_BEGIN
 
-static AVS_LIST(avs_coap_observe_t)
+static int observe_cmp(const void *left_, const void *right_) {
+    const avs_coap_token_t *left =
+            &((const avs_coap_observe_t *) left_)->id.token;
+    const avs_coap_token_t *right =
+            &((const avs_coap_observe_t *) right_)->id.token;
+    if (left->size != right->size) {
+        return left->size < right->size ? -1 : 1;
+    }
+    return memcmp(left->bytes, right->bytes, left->size);
+}
+
+static inline const avs_coap_observe_t *
+observe_query(const avs_coap_observe_id_t *id) {
+    return AVS_CONTAINER_OF(id, avs_coap_observe_t, id);
+}
+
+static AVS_SORTED_SET_ELEM(avs_coap_observe_t)
 create_observe(avs_coap_observe_id_t id,
                const avs_coap_request_header_t *req,
                avs_coap_observe_cancel_handler_t *cancel_handler,
@@ -34,9 +52,10 @@ create_observe(avs_coap_observe_id_t id,
     const size_t options_capacity =
             _avs_coap_options_request_key_size(&req->options);
 
-    AVS_LIST(avs_coap_observe_t) observe =
-            (AVS_LIST(avs_coap_observe_t)) AVS_LIST_NEW_BUFFER(
-                    sizeof(avs_coap_observe_t) + options_capacity);
+    AVS_SORTED_SET_ELEM(avs_coap_observe_t) observe =
+            (AVS_SORTED_SET_ELEM(avs_coap_observe_t))
+                    AVS_SORTED_SET_ELEM_NEW_BUFFER(sizeof(avs_coap_observe_t)
+                                                   + options_capacity);
     if (!observe) {
         LOG_OOM();
         return NULL;
@@ -59,16 +78,28 @@ create_observe(avs_coap_observe_id_t id,
     return observe;
 }
 
-static AVS_LIST(avs_coap_observe_t) *
-find_observe_ptr_by_id(avs_coap_ctx_t *ctx, const avs_coap_observe_id_t *id) {
-    AVS_LIST(avs_coap_observe_t) *observe_ptr;
-    AVS_LIST_FOREACH_PTR(observe_ptr, &_avs_coap_get_base(ctx)->observes) {
-        if (avs_coap_token_equal(&(*observe_ptr)->id.token, &id->token)) {
-            return observe_ptr;
-        }
+avs_coap_observe_t *_avs_coap_observe_find(avs_coap_ctx_t *ctx,
+                                           const avs_coap_observe_id_t *id) {
+    avs_coap_base_t *coap_base = _avs_coap_get_base(ctx);
+    if (!coap_base->observes) {
+        return NULL;
     }
+    return AVS_SORTED_SET_FIND(coap_base->observes, observe_query(id));
+}
 
-    return NULL;
+static avs_error_t insert_observe(avs_coap_base_t *coap_base,
+                                  AVS_SORTED_SET_ELEM(avs_coap_observe_t)
+                                          observe) {
+    if (!coap_base->observes
+            && !(coap_base->observes =
+                         AVS_SORTED_SET_NEW(avs_coap_observe_t, observe_cmp))) {
+        LOG_OOM();
+        return avs_errno(AVS_ENOMEM);
+    }
+    if (AVS_SORTED_SET_INSERT(coap_base->observes, observe) != observe) {
+        AVS_UNREACHABLE("observation with the same ID already exists");
+    }
+    return AVS_OK;
 }
 
 avs_error_t
@@ -83,7 +114,7 @@ avs_coap_observe_start(avs_coap_ctx_t *ctx,
         return avs_errno(AVS_EINVAL);
     }
 
-    AVS_LIST(avs_coap_observe_t) observe =
+    AVS_SORTED_SET_ELEM(avs_coap_observe_t) observe =
             create_observe(id, req, cancel_handler, handler_arg);
     if (!observe) {
         return avs_errno(AVS_ENOMEM);
@@ -92,7 +123,7 @@ avs_coap_observe_start(avs_coap_ctx_t *ctx,
     avs_error_t err = ctx->vtable->accept_observation(ctx, observe);
 
     if (avs_is_err(err)) {
-        avs_free(observe);
+        AVS_SORTED_SET_ELEM_DELETE_DETACHED(&observe);
         return err;
     }
 
@@ -101,21 +132,17 @@ avs_coap_observe_start(avs_coap_ctx_t *ctx,
 
     LOG(DEBUG, _("Observe start: ") "%s", AVS_COAP_TOKEN_HEX(&id.token));
 
-    AVS_LIST_INSERT(&_avs_coap_get_base(ctx)->observes, observe);
-    return AVS_OK;
-}
-
-static avs_coap_observe_t *find_observe_by_id(avs_coap_ctx_t *ctx,
-                                              const avs_coap_observe_id_t *id) {
-    AVS_LIST(avs_coap_observe_t) *observe_ptr = find_observe_ptr_by_id(ctx, id);
-    return observe_ptr ? *observe_ptr : NULL;
+    if (avs_is_err((err = insert_observe(_avs_coap_get_base(ctx), observe)))) {
+        AVS_SORTED_SET_ELEM_DELETE_DETACHED(&observe);
+    }
+    return err;
 }
 
 avs_error_t
 _avs_coap_observe_setup_notify(avs_coap_ctx_t *ctx,
                                const avs_coap_observe_id_t *id,
                                avs_coap_observe_notify_t *out_notify) {
-    avs_coap_observe_t *observe = find_observe_by_id(ctx, id);
+    avs_coap_observe_t *observe = _avs_coap_observe_find(ctx, id);
     if (!observe) {
         LOG(DEBUG, _("observation ") "%s" _(" does not exist"),
             AVS_COAP_TOKEN_HEX(&id->token));
@@ -134,11 +161,11 @@ _avs_coap_observe_setup_notify(avs_coap_ctx_t *ctx,
 
 avs_error_t avs_coap_observe_cancel(avs_coap_ctx_t *ctx,
                                     avs_coap_observe_id_t id) {
-    AVS_LIST(avs_coap_observe_t) *observe_ptr = NULL;
+    AVS_SORTED_SET_ELEM(avs_coap_observe_t) observe = NULL;
     if (ctx) {
-        observe_ptr = find_observe_ptr_by_id(ctx, &id);
+        observe = _avs_coap_observe_find(ctx, &id);
     }
-    if (!observe_ptr) {
+    if (!observe) {
         LOG(TRACE, _("observation ") "%s" _(" does not exist"),
             AVS_COAP_TOKEN_HEX(&id.token));
         return avs_errno(AVS_EINVAL);
@@ -146,11 +173,11 @@ avs_error_t avs_coap_observe_cancel(avs_coap_ctx_t *ctx,
 
     LOG(DEBUG, _("Observe cancel: ") "%s", AVS_COAP_TOKEN_HEX(&id.token));
 
-    avs_coap_observe_t *observe = AVS_LIST_DETACH(observe_ptr);
+    AVS_SORTED_SET_DETACH(_avs_coap_get_base(ctx)->observes, observe);
     if (observe->cancel_handler) {
         observe->cancel_handler(id, observe->cancel_handler_arg);
     }
-    AVS_LIST_DELETE(&observe);
+    AVS_SORTED_SET_ELEM_DELETE_DETACHED(&observe);
     return AVS_OK;
 }
 
@@ -188,7 +215,7 @@ avs_error_t avs_coap_observe_persist(avs_coap_ctx_t *ctx,
     if (avs_persistence_direction(persistence) != AVS_PERSISTENCE_STORE) {
         return avs_errno(AVS_EINVAL);
     }
-    avs_coap_observe_t *observe = find_observe_by_id(ctx, &id);
+    avs_coap_observe_t *observe = _avs_coap_observe_find(ctx, &id);
     if (!observe) {
         LOG(ERROR,
             _("Cannot persist observation ") "%s" _(": it does not exist"),
@@ -233,7 +260,7 @@ avs_error_t avs_coap_observe_restore_with_id(
     uint32_t last_observe_option_value;
     uint8_t request_code;
     uint16_t options_size = 0;
-    AVS_LIST(avs_coap_observe_t) observe;
+    AVS_SORTED_SET_ELEM(avs_coap_observe_t) observe;
     avs_error_t err = persistence_common_fields(persistence, &id.token,
                                                 &last_observe_option_value,
                                                 &request_code, &options_size);
@@ -241,15 +268,16 @@ avs_error_t avs_coap_observe_restore_with_id(
         return err;
     }
 
-    if (find_observe_by_id(ctx, &id)) {
+    if (_avs_coap_observe_find(ctx, &id)) {
         LOG(ERROR, _("Observe ") "%s" _(" already exists"),
             AVS_COAP_TOKEN_HEX(&id.token));
         // persistence data likely malformed
         return avs_errno(AVS_EBADMSG);
     }
 
-    observe = (AVS_LIST(avs_coap_observe_t)) AVS_LIST_NEW_BUFFER(
-            sizeof(avs_coap_observe_t) + options_size);
+    observe = (AVS_SORTED_SET_ELEM(avs_coap_observe_t))
+            AVS_SORTED_SET_ELEM_NEW_BUFFER(sizeof(avs_coap_observe_t)
+                                           + options_size);
     if (!observe) {
         LOG_OOM();
         return avs_errno(AVS_ENOMEM);
@@ -266,13 +294,13 @@ avs_error_t avs_coap_observe_restore_with_id(
     observe->request_key.size = options_size;
     if (avs_is_err((err = avs_persistence_bytes(persistence,
                                                 observe->options_storage,
-                                                options_size)))) {
-        AVS_LIST_DELETE(&observe);
+                                                options_size)))
+            || avs_is_err((err = insert_observe(coap_base, observe)))) {
+        AVS_SORTED_SET_ELEM_DELETE_DETACHED(&observe);
         return err;
     }
     LOG(DEBUG, _("Observe (restored) start: ") "%s",
         AVS_COAP_TOKEN_HEX(&id.token));
-    AVS_LIST_INSERT(&coap_base->observes, observe);
     if (out_id) {
         *out_id = id;
     }
@@ -49,6 +49,13 @@ typedef struct {
     uint32_t observe_option_value;
 } avs_coap_observe_notify_t;
 
+/**
+ * Returns the active observation identified by @p id, or NULL if there is
+ * none. Lookup cost is logarithmic in the number of active observations.
+ */
+avs_coap_observe_t *_avs_coap_observe_find(avs_coap_ctx_t *ctx,
+                                           const avs_coap_observe_id_t *id);
+
 avs_error_t
 _avs_coap_observe_setup_notify(avs_coap_ctx_t *ctx,
                                const avs_coap_observe_id_t *id,
@@ -241,6 +241,19 @@ bool _avs_coap_options_valid(const avs_coap_options_t *opts) {
     return true;
 }
 
+avs_error_t avs_coap_options_dynamic_init_from_template(
+        avs_coap_options_t *opts,
+        const avs_coap_options_t *template_opts,
+        size_t extra_capacity) {
+    avs_error_t err = avs_coap_options_dynamic_init_with_size(
+            opts, template_opts->size + extra_capacity);
+    if (avs_is_ok(err)) {
+        err = _avs_coap_options_copy_into(opts, template_opts);
+        assert(avs_is_ok(err));
+    }
+    return err;
+}
+
 void avs_coap_options_remove_by_number(avs_coap_options_t *opts,
                                        uint16_t option_number) {
     avs_coap_option_iterator_t optit = _avs_coap_optit_begin(opts);
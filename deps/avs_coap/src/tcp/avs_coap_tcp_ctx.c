@@ -433,11 +433,29 @@ pack_payload_from_opts_buffer(avs_coap_tcp_cached_msg_t *inout_msg,
     _avs_coap_tcp_pack_payload(inout_msg, payload_ptr, data_size);
 }
 
-static avs_error_t recv_to_internal_buffer_with_bytes_limit(
-        avs_coap_tcp_ctx_t *ctx, size_t limit, size_t *out_bytes_read) {
+/**
+ * opt_cache.buffer is allocated with AVS_COAP_MAX_TOKEN_LENGTH bytes more than
+ * the configured options size. That headroom is only used when receiving the
+ * token together with whatever follows it (see receive_token()), so that
+ * after consuming the token, the space available for options is the same as
+ * if the token was received separately.
+ */
+static inline size_t opt_cache_capacity(const avs_coap_tcp_opt_cache_t *cache) {
+    return avs_buffer_capacity(cache->buffer) - AVS_COAP_MAX_TOKEN_LENGTH;
+}
+
+static inline size_t
+opt_cache_space_left(const avs_coap_tcp_opt_cache_t *cache) {
+    const size_t data_size = avs_buffer_data_size(cache->buffer);
+    const size_t capacity = opt_cache_capacity(cache);
+    return data_size < capacity ? capacity - data_size : 0;
+}
+
+static avs_error_t recv_to_internal_buffer_impl(avs_coap_tcp_ctx_t *ctx,
+                                                size_t bytes_to_read,
+                                                size_t *out_bytes_read) {
+    assert(bytes_to_read <= avs_buffer_space_left(ctx->opt_cache.buffer));
     size_t bytes_read = 0;
-    const size_t space_left = avs_buffer_space_left(ctx->opt_cache.buffer);
-    const size_t bytes_to_read = AVS_MIN(space_left, limit);
     avs_error_t err =
             coap_tcp_recv_data(ctx,
                                avs_buffer_raw_insert_ptr(ctx->opt_cache.buffer),
@@ -453,6 +471,13 @@ static avs_error_t recv_to_internal_buffer_with_bytes_limit(
     return AVS_OK;
 }
 
+static avs_error_t recv_to_internal_buffer_with_bytes_limit(
+        avs_coap_tcp_ctx_t *ctx, size_t limit, size_t *out_bytes_read) {
+    return recv_to_internal_buffer_impl(
+            ctx, AVS_MIN(opt_cache_space_left(&ctx->opt_cache), limit),
+            out_bytes_read);
+}
+
 static void ignore_data_for_current_msg(avs_coap_tcp_ctx_t *ctx) {
     const size_t bytes_in_buffer = avs_buffer_data_size(ctx->opt_cache.buffer);
     const size_t bytes_to_ignore =
@@ -521,44 +546,56 @@ static avs_error_t receive_header(avs_coap_tcp_ctx_t *ctx) {
     return AVS_OK;
 }
 
-static avs_error_t receive_token(avs_coap_tcp_ctx_t *ctx) {
-    size_t bytes_read;
-
-    size_t remaining_token_bytes =
-            ctx->cached_msg.content.token.size
-            - avs_buffer_data_size(ctx->opt_cache.buffer);
+static avs_error_t receive_token(avs_coap_tcp_ctx_t *ctx,
+                                 bool *out_options_data_received) {
+    const size_t token_size = ctx->cached_msg.content.token.size;
+    const size_t bytes_buffered = avs_buffer_data_size(ctx->opt_cache.buffer);
 
-    if (remaining_token_bytes) {
-        avs_error_t err = recv_to_internal_buffer_with_bytes_limit(
-                ctx, remaining_token_bytes, &bytes_read);
+    if (bytes_buffered < token_size) {
+        // Ask for the rest of the message instead of just the token, so that
+        // options (and possibly the beginning of payload) that are already
+        // available don't require another recv call.
+        const size_t remaining_token_bytes = token_size - bytes_buffered;
+        avs_error_t err = recv_to_internal_buffer_impl(
+                ctx,
+                AVS_MIN(ctx->cached_msg.remaining_bytes - bytes_buffered,
+                        remaining_token_bytes
+                                + opt_cache_capacity(&ctx->opt_cache)),
+                NULL);
         if (avs_is_err(err)) {
             return err;
         }
-        if (remaining_token_bytes != bytes_read) {
+        const size_t data_size = avs_buffer_data_size(ctx->opt_cache.buffer);
+        if (data_size < token_size) {
             return _avs_coap_err(AVS_COAP_ERR_MORE_DATA_REQUIRED);
         }
+        *out_options_data_received = (data_size > token_size);
     }
 
     memcpy(ctx->cached_msg.content.token.bytes,
-           avs_buffer_data(ctx->opt_cache.buffer),
-           ctx->cached_msg.content.token.size);
-    avs_buffer_reset(ctx->opt_cache.buffer);
-    ctx->cached_msg.remaining_bytes -= ctx->cached_msg.content.token.size;
+           avs_buffer_data(ctx->opt_cache.buffer), token_size);
+    avs_buffer_consume_bytes(ctx->opt_cache.buffer, token_size);
+    ctx->cached_msg.remaining_bytes -= token_size;
     return AVS_OK;
 }
 
-static avs_error_t receive_options(avs_coap_tcp_ctx_t *ctx) {
+/**
+ * If @p may_receive is false, options data has already been received together
+ * with the token in this call, and options are only parsed from what is
+ * already in opt_cache.buffer.
+ */
+static avs_error_t receive_options(avs_coap_tcp_ctx_t *ctx, bool may_receive) {
     // cached_msg.remaining_bytes indicates how many bytes of the message wasn't
     // parsed, but some of them may be already received and present in
     // opt_cache.buffer.
     assert(ctx->cached_msg.remaining_bytes
-           > avs_buffer_data_size(ctx->opt_cache.buffer));
+           >= avs_buffer_data_size(ctx->opt_cache.buffer));
     size_t bytes_to_receive = ctx->cached_msg.remaining_bytes
                               - avs_buffer_data_size(ctx->opt_cache.buffer);
-    avs_error_t err =
-            recv_to_internal_buffer_with_bytes_limit(ctx, bytes_to_receive,
-                                                     NULL);
-    if (avs_is_err(err)) {
+    avs_error_t err;
+    if (may_receive && bytes_to_receive
+            && avs_is_err((err = recv_to_internal_buffer_with_bytes_limit(
+                                   ctx, bytes_to_receive, NULL)))) {
         return err;
     }
 
@@ -576,7 +613,7 @@ static avs_error_t receive_options(avs_coap_tcp_ctx_t *ctx) {
              * be ignored.
              */
             if (avs_buffer_data_size(ctx->opt_cache.buffer)
-                    == avs_buffer_capacity(ctx->opt_cache.buffer)) {
+                    == opt_cache_capacity(&ctx->opt_cache)) {
                 return _avs_coap_err(AVS_COAP_ERR_TRUNCATED_MESSAGE_RECEIVED);
             }
             return err;
@@ -660,6 +697,7 @@ static avs_error_t
 receive_to_internal_buffer_and_handle(avs_coap_tcp_ctx_t *ctx,
                                       avs_coap_borrowed_msg_t *out_request) {
     avs_error_t err = AVS_OK;
+    bool options_data_received = false;
     switch (ctx->opt_cache.state) {
     case AVS_COAP_TCP_OPT_CACHE_STATE_RECEIVING_HEADER:
         err = receive_header(ctx);
@@ -669,7 +707,7 @@ receive_to_internal_buffer_and_handle(avs_coap_tcp_ctx_t *ctx,
         ctx->opt_cache.state = AVS_COAP_TCP_OPT_CACHE_STATE_RECEIVING_TOKEN;
     // fall-through
     case AVS_COAP_TCP_OPT_CACHE_STATE_RECEIVING_TOKEN:
-        err = receive_token(ctx);
+        err = receive_token(ctx, &options_data_received);
         if (avs_is_err(err)) {
             return err;
         }
@@ -677,7 +715,7 @@ receive_to_internal_buffer_and_handle(avs_coap_tcp_ctx_t *ctx,
     // fall-through
     case AVS_COAP_TCP_OPT_CACHE_STATE_RECEIVING_OPTIONS:
         if (ctx->cached_msg.remaining_bytes) {
-            err = receive_options(ctx);
+            err = receive_options(ctx, !options_data_received);
             if (err.category == AVS_COAP_ERR_CATEGORY
                     && (err.code == AVS_COAP_ERR_TRUNCATED_MESSAGE_RECEIVED
                         || err.code == AVS_COAP_ERR_MALFORMED_OPTIONS
@@ -943,7 +981,8 @@ avs_coap_ctx_t *avs_coap_tcp_ctx_create(avs_sched_t *sched,
         return NULL;
     }
 
-    const size_t buf_size = max_opts_size + sizeof(AVS_COAP_PAYLOAD_MARKER);
+    const size_t buf_size = max_opts_size + sizeof(AVS_COAP_PAYLOAD_MARKER)
+                            + AVS_COAP_MAX_TOKEN_LENGTH;
 
     if (avs_buffer_create(&ctx->opt_cache.buffer, buf_size)) {
         avs_free(ctx);
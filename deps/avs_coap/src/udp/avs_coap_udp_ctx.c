@@ -178,6 +178,19 @@ static uint16_t generate_id(avs_coap_udp_ctx_t *ctx) {
     return ctx->last_msg_id++;
 }
 
+/**
+ * @returns Maximum number of simultaneously outstanding confirmable messages:
+ *          either NSTART, or the congestion window if congestion control is
+ *          enabled.
+ */
+static size_t nstart_limit(const avs_coap_udp_ctx_t *ctx) {
+    if (!ctx->congestion.max_window) {
+        return ctx->tx_params.nstart;
+    }
+    // NSTART may have been changed after enabling congestion control
+    return AVS_MAX(ctx->congestion.window, ctx->tx_params.nstart);
+}
+
 static size_t current_nstart(const avs_coap_udp_ctx_t *ctx) {
     size_t started = 0;
 
@@ -195,12 +208,13 @@ static size_t current_nstart(const avs_coap_udp_ctx_t *ctx) {
 
 static size_t effective_nstart(const avs_coap_udp_ctx_t *ctx) {
     // equivalent to:
-    // AVS_MIN(ctx->tx_params.nstart, AVS_LIST_SIZE(ctx->unconfirmed_messages))
+    // AVS_MIN(nstart_limit(ctx), AVS_LIST_SIZE(ctx->unconfirmed_messages))
+    const size_t limit = nstart_limit(ctx);
     size_t result = 0;
     AVS_LIST(avs_coap_udp_unconfirmed_msg_t) msg;
     AVS_LIST_FOREACH(msg, ctx->unconfirmed_messages) {
         ++result;
-        if (result >= ctx->tx_params.nstart) {
+        if (result >= limit) {
             break;
         }
     }
@@ -416,6 +430,50 @@ static inline const char *send_result_string(avs_coap_send_result_t result) {
     return "<unknown>";
 }
 
+static size_t unconfirmed_pool_packet_capacity(const avs_coap_udp_ctx_t *ctx) {
+    return ctx->base.out_buffer->capacity;
+}
+
+static AVS_LIST(avs_coap_udp_unconfirmed_msg_t)
+alloc_unconfirmed(avs_coap_udp_ctx_t *ctx, size_t msg_size) {
+    const size_t pool_capacity = unconfirmed_pool_packet_capacity(ctx);
+    if (msg_size <= pool_capacity && ctx->unconfirmed_pool) {
+        --ctx->unconfirmed_pool_size;
+        return AVS_LIST_DETACH(&ctx->unconfirmed_pool);
+    }
+
+    // Messages that are going to be sent right away get a buffer suitable for
+    // reuse once they are done. Held ones only take as much memory as they
+    // need, as there may be arbitrarily many of them.
+    size_t packet_capacity = msg_size;
+    if (msg_size <= pool_capacity
+            && current_nstart(ctx) < nstart_limit(ctx)) {
+        packet_capacity = pool_capacity;
+    }
+    AVS_LIST(avs_coap_udp_unconfirmed_msg_t) unconfirmed =
+            (AVS_LIST(avs_coap_udp_unconfirmed_msg_t)) AVS_LIST_NEW_BUFFER(
+                    sizeof(avs_coap_udp_unconfirmed_msg_t) + packet_capacity);
+    if (unconfirmed) {
+        unconfirmed->packet_capacity = packet_capacity;
+    }
+    return unconfirmed;
+}
+
+static void
+release_unconfirmed(avs_coap_udp_ctx_t *ctx,
+                    AVS_LIST(avs_coap_udp_unconfirmed_msg_t) *unconfirmed_ptr) {
+    assert(!AVS_LIST_NEXT(*unconfirmed_ptr));
+    if ((*unconfirmed_ptr)->packet_capacity
+                    == unconfirmed_pool_packet_capacity(ctx)
+            && ctx->unconfirmed_pool_size < nstart_limit(ctx)) {
+        AVS_LIST_INSERT(&ctx->unconfirmed_pool, *unconfirmed_ptr);
+        *unconfirmed_ptr = NULL;
+        ++ctx->unconfirmed_pool_size;
+    } else {
+        AVS_LIST_DELETE(unconfirmed_ptr);
+    }
+}
+
 static void resume_next_unconfirmed(avs_coap_udp_ctx_t *ctx) {
     AVS_LIST(avs_coap_udp_unconfirmed_msg_t) *unconfirmed_ptr =
             find_first_held_unconfirmed_ptr(ctx);
@@ -455,7 +513,7 @@ static void resume_next_unconfirmed(avs_coap_udp_ctx_t *ctx) {
             (void) call_send_result_handler(
                     ctx, unconfirmed, NULL, AVS_COAP_SEND_RESULT_FAIL,
                     _avs_coap_err(AVS_COAP_ERR_TIME_INVALID));
-            AVS_LIST_DELETE(&unconfirmed);
+            release_unconfirmed(ctx, &unconfirmed);
         }
 
         return;
@@ -465,6 +523,7 @@ static void resume_next_unconfirmed(avs_coap_udp_ctx_t *ctx) {
             AVS_LIST_DETACH(unconfirmed_ptr);
     unconfirmed->hold = false;
     unconfirmed->next_retransmit = next_retransmit;
+    unconfirmed->first_sent = avs_time_monotonic_now();
 
     LOG(DEBUG, _("msg ") "%s" _(" resumed"),
         AVS_COAP_TOKEN_HEX(&unconfirmed->msg.token));
@@ -476,7 +535,7 @@ static void resume_next_unconfirmed(avs_coap_udp_ctx_t *ctx) {
     if (avs_is_err(send_err)) {
         (void) call_send_result_handler(ctx, unconfirmed, NULL,
                                         AVS_COAP_SEND_RESULT_FAIL, send_err);
-        AVS_LIST_DELETE(&unconfirmed);
+        release_unconfirmed(ctx, &unconfirmed);
     } else {
         // the msg may need to be retransmitted before other started ones
         AVS_LIST_INSERT(find_unconfirmed_insert_ptr(ctx, unconfirmed),
@@ -486,7 +545,8 @@ static void resume_next_unconfirmed(avs_coap_udp_ctx_t *ctx) {
 
 static void resume_unconfirmed_messages(avs_coap_udp_ctx_t *ctx) {
     // nothing can be resumed
-    if (current_nstart(ctx) >= ctx->tx_params.nstart) {
+    const size_t limit = nstart_limit(ctx);
+    if (current_nstart(ctx) >= limit) {
         return;
     }
 
@@ -495,7 +555,7 @@ static void resume_unconfirmed_messages(avs_coap_udp_ctx_t *ctx) {
     const size_t held_msgs = all_msgs - resumed_msgs;
 
     const size_t msgs_to_resume =
-            AVS_MIN(ctx->tx_params.nstart - resumed_msgs, held_msgs);
+            AVS_MIN(limit - resumed_msgs, held_msgs);
     LOG(DEBUG, "%u/%u" _(" msgs held; resuming ") "%u", (unsigned) held_msgs,
         (unsigned) all_msgs, (unsigned) msgs_to_resume);
 
@@ -542,7 +602,7 @@ static void try_cleanup_unconfirmed(avs_coap_udp_ctx_t *ctx,
                         unconfirmed);
     } else {
         reschedule_retransmission_job(ctx);
-        AVS_LIST_DELETE(&unconfirmed);
+        release_unconfirmed(ctx, &unconfirmed);
     }
 }
 
@@ -627,6 +687,52 @@ detach_unconfirmed_by_token(avs_coap_udp_ctx_t *ctx,
     return NULL;
 }
 
+static void grow_congestion_window(avs_coap_udp_ctx_t *ctx) {
+    if (!ctx->congestion.max_window) {
+        return;
+    }
+    // additive increase: one message per window's worth of clean ACKs
+    if (++ctx->congestion.acks_since_update >= ctx->congestion.window
+            && ctx->congestion.window < ctx->congestion.max_window) {
+        ++ctx->congestion.window;
+        ctx->congestion.acks_since_update = 0;
+        LOG(DEBUG, _("congestion window grown to ") "%u",
+            (unsigned) ctx->congestion.window);
+    }
+}
+
+static void shrink_congestion_window(avs_coap_udp_ctx_t *ctx) {
+    if (!ctx->congestion.max_window) {
+        return;
+    }
+    // multiplicative decrease, down to NSTART
+    ctx->congestion.window =
+            AVS_MAX(ctx->congestion.window / 2, ctx->tx_params.nstart);
+    ctx->congestion.acks_since_update = 0;
+    LOG(DEBUG, _("congestion window shrunk to ") "%u",
+        (unsigned) ctx->congestion.window);
+}
+
+static void on_ack_received(avs_coap_udp_ctx_t *ctx,
+                            avs_coap_udp_unconfirmed_msg_t *unconfirmed) {
+    if (unconfirmed->hold
+            || !avs_time_monotonic_valid(unconfirmed->first_sent)) {
+        return;
+    }
+    if (ctx->rto_state.enabled) {
+        _avs_coap_udp_rtt_sample(
+                ctx,
+                avs_time_monotonic_diff(avs_time_monotonic_now(),
+                                        unconfirmed->first_sent),
+                unconfirmed->retransmissions);
+    }
+    if (!unconfirmed->retransmissions) {
+        grow_congestion_window(ctx);
+    }
+    // duplicate ACKs must not be taken into account
+    unconfirmed->first_sent = AVS_TIME_MONOTONIC_INVALID;
+}
+
 static void
 confirm_unconfirmed(avs_coap_udp_ctx_t *ctx,
                     AVS_LIST(avs_coap_udp_unconfirmed_msg_t) *msg_ptr,
@@ -733,6 +839,10 @@ retransmit_next_message_without_reschedule(avs_coap_udp_ctx_t *ctx) {
         return;
     }
     ++ctx->stats.outgoing_retransmissions_count;
+    if (!unconfirmed->retransmissions++) {
+        // the message, or its ACK, was most likely lost
+        shrink_congestion_window(ctx);
+    }
 
     avs_time_monotonic_t next_retransmit =
             avs_time_monotonic_add(unconfirmed->next_retransmit,
@@ -777,10 +887,10 @@ enqueue_unconfirmed(avs_coap_udp_ctx_t *ctx,
 
     // do not send the message unless there is no other one waiting to be sent
     // that is held for longer than this one
-    assert(ctx->tx_params.nstart > 0);
+    const size_t limit = nstart_limit(ctx);
+    assert(limit > 0);
     unconfirmed->hold =
-            (AVS_LIST_NTH(ctx->unconfirmed_messages, ctx->tx_params.nstart - 1)
-             != NULL);
+            (AVS_LIST_NTH(ctx->unconfirmed_messages, limit - 1) != NULL);
 
     // use current time for all held jobs to not cause accidental reordering
     // due to ACK_RANDOM_FACTOR
@@ -799,11 +909,11 @@ enqueue_unconfirmed(avs_coap_udp_ctx_t *ctx,
     }
 
     unconfirmed->next_retransmit = next_retransmit;
+    unconfirmed->first_sent = avs_time_monotonic_now();
 
     if (unconfirmed->hold) {
         LOG(DEBUG, _("msg ") "%s" _(" held due to NSTART = ") "%u",
-            AVS_COAP_TOKEN_HEX(&unconfirmed->msg.token),
-            (unsigned) ctx->tx_params.nstart);
+            AVS_COAP_TOKEN_HEX(&unconfirmed->msg.token), (unsigned) limit);
     } else {
         avs_error_t err =
                 coap_udp_send_serialized_msg(ctx, &unconfirmed->msg,
@@ -828,8 +938,7 @@ static avs_error_t create_unconfirmed(
     const size_t msg_size = _avs_coap_udp_msg_size(msg);
 
     AVS_LIST(avs_coap_udp_unconfirmed_msg_t) unconfirmed_msg =
-            (AVS_LIST(avs_coap_udp_unconfirmed_msg_t)) AVS_LIST_NEW_BUFFER(
-                    sizeof(avs_coap_udp_unconfirmed_msg_t) + msg_size);
+            alloc_unconfirmed(ctx, msg_size);
     if (!unconfirmed_msg) {
         return avs_errno(AVS_ENOMEM);
     }
@@ -837,7 +946,8 @@ static avs_error_t create_unconfirmed(
     *unconfirmed_msg = (avs_coap_udp_unconfirmed_msg_t) {
         .send_result_handler = send_result_handler,
         .send_result_handler_arg = send_result_handler_arg,
-        .packet_size = msg_size
+        .packet_size = msg_size,
+        .packet_capacity = unconfirmed_msg->packet_capacity
     };
 
     avs_error_t err;
@@ -845,7 +955,7 @@ static avs_error_t create_unconfirmed(
     if (avs_is_err((err = _avs_coap_udp_initial_retry_state(
                             ctx, &unconfirmed_msg->retry_state)))) {
         LOG(ERROR, _("PRNG failed"));
-        AVS_LIST_CLEAR(&unconfirmed_msg);
+        release_unconfirmed(ctx, &unconfirmed_msg);
         return err;
     }
 
@@ -854,7 +964,7 @@ static avs_error_t create_unconfirmed(
                                                  msg_size)))) {
         LOG(ERROR,
             _("Could not serialize the message as a valid CoAP/UDP packet"));
-        AVS_LIST_CLEAR(&unconfirmed_msg);
+        release_unconfirmed(ctx, &unconfirmed_msg);
         return err;
     }
 
@@ -958,18 +1068,19 @@ coap_udp_send_message(avs_coap_ctx_t *ctx_,
         .payload_size = msg->payload_size
     };
 
-    size_t shared_buffer_msg_size;
-    avs_error_t err =
-            _avs_coap_udp_msg_serialize(&shared_buffer_msg, out_buffer,
-                                        ctx->base.out_buffer->capacity,
-                                        &shared_buffer_msg_size);
-    if (avs_is_err(err)) {
-        goto end;
-    }
-
+    avs_error_t err = AVS_OK;
     if (type == AVS_COAP_UDP_TYPE_CONFIRMABLE) {
         // The user actually cares about message delivery.
-        // We need to store the packet for possible retransmissions.
+        // We need to store the packet for possible retransmissions, so it is
+        // serialized directly into the retransmission buffer - there is no
+        // need to build it in the shared buffer first. The size limit still
+        // applies, as for any other message.
+        if (_avs_coap_udp_msg_size(&shared_buffer_msg)
+                > ctx->base.out_buffer->capacity) {
+            err = _avs_coap_err(AVS_COAP_ERR_MESSAGE_TOO_BIG);
+            goto end;
+        }
+
         AVS_LIST(avs_coap_udp_unconfirmed_msg_t) unconfirmed = NULL;
         err = create_unconfirmed(ctx, &shared_buffer_msg, &unconfirmed,
                                  send_result_handler, send_result_handler_arg);
@@ -982,15 +1093,22 @@ coap_udp_send_message(avs_coap_ctx_t *ctx_,
         if (avs_is_err(err)) {
             // don't call try_cleanup_unconfirmed to avoid calling user-defined
             // handler
-            AVS_LIST_DELETE(&unconfirmed);
+            release_unconfirmed(ctx, &unconfirmed);
         }
     } else {
         assert(type != AVS_COAP_UDP_TYPE_CONFIRMABLE);
         // NON/ACK/RST messages ignore NSTART - they are not considered
         // "outstanding interactions" according to RFC7252, 4.7 Congestion
         // Control.
-        err = coap_udp_send_serialized_msg(ctx, &shared_buffer_msg, out_buffer,
-                                           shared_buffer_msg_size);
+        size_t shared_buffer_msg_size;
+        if (avs_is_ok((err = _avs_coap_udp_msg_serialize(
+                               &shared_buffer_msg, out_buffer,
+                               ctx->base.out_buffer->capacity,
+                               &shared_buffer_msg_size)))) {
+            err = coap_udp_send_serialized_msg(ctx, &shared_buffer_msg,
+                                               out_buffer,
+                                               shared_buffer_msg_size);
+        }
     }
 
 end:
@@ -1009,6 +1127,7 @@ static avs_error_t coap_udp_recv_msg(avs_coap_udp_ctx_t *ctx,
         LOG(TRACE, _("recv failed"));
         return err;
     }
+    ++ctx->stats.incoming_packets_count;
 
     err = _avs_coap_udp_msg_parse(out_msg, buf, packet_size);
     if (avs_is_err(err)) {
@@ -1150,6 +1269,7 @@ static avs_error_t handle_response(avs_coap_udp_ctx_t *ctx,
 
     case AVS_COAP_UDP_TYPE_ACKNOWLEDGEMENT:
         // Piggybacked Response
+        on_ack_received(ctx, *unconfirmed_ptr);
         break;
 
     case AVS_COAP_UDP_TYPE_RESET:
@@ -1210,6 +1330,7 @@ static avs_error_t handle_empty(avs_coap_udp_ctx_t *ctx,
     case AVS_COAP_UDP_TYPE_ACKNOWLEDGEMENT:
         // Separate ACK
         if (unconfirmed_ptr) {
+            on_ack_received(ctx, *unconfirmed_ptr);
             if (avs_coap_code_is_request((*unconfirmed_ptr)->msg.header.code)) {
                 // we still need to wait for a response
                 ack_request(ctx, unconfirmed_ptr);
@@ -1446,6 +1567,7 @@ static void coap_udp_cleanup(avs_coap_ctx_t *ctx_) {
         try_cleanup_unconfirmed(ctx, unconfirmed, NULL,
                                 AVS_COAP_SEND_RESULT_CANCEL, AVS_OK);
     }
+    AVS_LIST_CLEAR(&ctx->unconfirmed_pool);
     avs_free(ctx);
 }
 
@@ -1456,7 +1578,12 @@ static avs_coap_base_t *coap_udp_get_base(avs_coap_ctx_t *ctx_) {
 
 static avs_coap_stats_t coap_udp_get_stats(avs_coap_ctx_t *ctx_) {
     avs_coap_udp_ctx_t *ctx = (avs_coap_udp_ctx_t *) ctx_;
-    return ctx->stats;
+    avs_coap_stats_t stats = ctx->stats;
+    _avs_coap_udp_rtt_fill_stats(ctx, &stats);
+    if (ctx->congestion.max_window) {
+        stats.congestion_window = (uint32_t) nstart_limit(ctx);
+    }
+    return stats;
 }
 
 static avs_error_t coap_udp_setsock(avs_coap_ctx_t *ctx,
@@ -1584,6 +1711,58 @@ int avs_coap_udp_ctx_set_tx_params(avs_coap_ctx_t *ctx,
     return 0;
 }
 
+int avs_coap_udp_ctx_set_rtt_estimation(avs_coap_ctx_t *ctx, bool enabled) {
+    if (!ctx || ctx->vtable != &COAP_UDP_VTABLE) {
+        LOG(ERROR, _("avs_coap_udp_ctx_set_rtt_estimation() called on a NULL "
+                     "or non-UDP context"));
+        return -1;
+    }
+
+    avs_coap_udp_ctx_t *udp_ctx = (avs_coap_udp_ctx_t *) ctx;
+    if (udp_ctx->rto_state.enabled != enabled) {
+        const avs_coap_udp_rtt_estimator_t empty_estimator = {
+            .srtt = AVS_TIME_DURATION_INVALID,
+            .rttvar = AVS_TIME_DURATION_INVALID,
+            .rto = AVS_TIME_DURATION_INVALID
+        };
+        udp_ctx->rto_state = (avs_coap_udp_rto_state_t) {
+            .enabled = enabled,
+            .strong = empty_estimator,
+            .weak = empty_estimator,
+            .overall_rto = AVS_TIME_DURATION_INVALID,
+            .last_update = AVS_TIME_MONOTONIC_INVALID
+        };
+        udp_ctx->stats.strong_rtt_samples_count = 0;
+        udp_ctx->stats.weak_rtt_samples_count = 0;
+    }
+    return 0;
+}
+
+int avs_coap_udp_ctx_set_congestion_control(avs_coap_ctx_t *ctx,
+                                            size_t max_nstart) {
+    if (!ctx || ctx->vtable != &COAP_UDP_VTABLE) {
+        LOG(ERROR, _("avs_coap_udp_ctx_set_congestion_control() called on a "
+                     "NULL or non-UDP context"));
+        return -1;
+    }
+
+    avs_coap_udp_ctx_t *udp_ctx = (avs_coap_udp_ctx_t *) ctx;
+    if (max_nstart && max_nstart < udp_ctx->tx_params.nstart) {
+        LOG(ERROR, _("maximum congestion window smaller than NSTART"));
+        return -1;
+    }
+
+    udp_ctx->congestion.max_window = max_nstart;
+    udp_ctx->congestion.window =
+            AVS_MIN(AVS_MAX(udp_ctx->congestion.window,
+                            udp_ctx->tx_params.nstart),
+                    AVS_MAX(max_nstart, udp_ctx->tx_params.nstart));
+    udp_ctx->congestion.acks_since_update = 0;
+    // the limit might have grown, allowing held messages to be sent
+    reschedule_retransmission_job(udp_ctx);
+    return 0;
+}
+
 const avs_coap_udp_tx_params_t *
 avs_coap_udp_ctx_get_tx_params(avs_coap_ctx_t *ctx) {
     if (!ctx || ctx->vtable != &COAP_UDP_VTABLE) {
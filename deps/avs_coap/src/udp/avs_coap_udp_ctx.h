@@ -61,16 +61,68 @@ typedef struct {
     /** Time at which this packet has to be retransmitted next time. */
     avs_time_monotonic_t next_retransmit;
 
+    /**
+     * Time at which this packet was sent for the first time. Only valid if
+     * the message is not held. Used to take RTT samples.
+     */
+    avs_time_monotonic_t first_sent;
+
+    /** Number of retransmissions of this packet performed so far. */
+    unsigned retransmissions;
+
     /** CoAP message view. Points to @ref avs_coap_udp_exchange_t#packet . */
     avs_coap_udp_msg_t msg;
 
     /** Number of initialized bytes in @ref avs_coap_udp_exchange_t#packet . */
     size_t packet_size;
 
+    /** Number of bytes allocated for @ref avs_coap_udp_exchange_t#packet . */
+    size_t packet_capacity;
+
     /** Serialized packet data. */
     uint8_t packet[];
 } avs_coap_udp_unconfirmed_msg_t;
 
+/**
+ * RFC 6298 round-trip time estimator, used as either the strong or the weak
+ * estimator of CoCoA.
+ */
+typedef struct {
+    /** Smoothed round-trip time; invalid if no samples were taken yet */
+    avs_time_duration_t srtt;
+    /** Round-trip time variation */
+    avs_time_duration_t rttvar;
+    /** Retransmission timeout calculated from the samples */
+    avs_time_duration_t rto;
+} avs_coap_udp_rtt_estimator_t;
+
+/**
+ * State of the adaptive retransmission timeout calculation, see
+ * @ref avs_coap_udp_ctx_set_rtt_estimation .
+ */
+typedef struct {
+    bool enabled;
+    avs_coap_udp_rtt_estimator_t strong;
+    avs_coap_udp_rtt_estimator_t weak;
+    /** Base for initial retransmission timeouts of new messages */
+    avs_time_duration_t overall_rto;
+    /** Time of the last update of overall_rto, used for aging */
+    avs_time_monotonic_t last_update;
+} avs_coap_udp_rto_state_t;
+
+/**
+ * State of the congestion-controlled NSTART, see
+ * @ref avs_coap_udp_ctx_set_congestion_control .
+ */
+typedef struct {
+    /** Upper bound of the window; 0 if congestion control is disabled */
+    size_t max_window;
+    /** Current number of confirmable messages allowed to be outstanding */
+    size_t window;
+    /** Number of ACKs without retransmissions since the last window change */
+    size_t acks_since_update;
+} avs_coap_udp_congestion_state_t;
+
 #ifdef WITH_AVS_COAP_OBSERVE
 typedef struct {
     uint16_t msg_id;
@@ -108,10 +160,21 @@ typedef struct {
 
     AVS_LIST(avs_coap_udp_unconfirmed_msg_t) unconfirmed_messages;
 
+    /**
+     * Released unconfirmed message entries kept for reuse, so that sending
+     * a confirmable message does not require a heap allocation. Each of them
+     * has a packet buffer as large as the output buffer. At most NSTART
+     * (or the current congestion window) entries are retained.
+     */
+    AVS_LIST(avs_coap_udp_unconfirmed_msg_t) unconfirmed_pool;
+    size_t unconfirmed_pool_size;
+
     avs_net_socket_t *socket;
     size_t last_mtu;
     size_t forced_incoming_mtu;
     avs_coap_udp_tx_params_t tx_params;
+    avs_coap_udp_rto_state_t rto_state;
+    avs_coap_udp_congestion_state_t congestion;
 
     avs_coap_stats_t stats;
 
@@ -250,8 +250,30 @@ avs_error_t _avs_coap_udp_msg_copy(const avs_coap_udp_msg_t *src,
         return err;
     }
 
-    // TODO: optimize
-    return _avs_coap_udp_msg_parse(dst, packet_buf, written);
+    // The layout of the serialized packet is known, so instead of parsing it
+    // back, just point the fields of dst at appropriate places in packet_buf.
+    uint8_t *options_ptr =
+            packet_buf + sizeof(src->header) + (size_t) src->token.size;
+    *dst = (avs_coap_udp_msg_t) {
+        .header = src->header,
+        .token = src->token,
+        .options = {
+            .begin = options_ptr,
+            .size = src->options.size,
+            .capacity = src->options.size,
+            .allocated = false
+        }
+    };
+    if (src->payload && src->payload_size > 0) {
+        dst->payload = options_ptr + src->options.size
+                       + sizeof(AVS_COAP_PAYLOAD_MARKER);
+        dst->payload_size = src->payload_size;
+    } else {
+        dst->payload = options_ptr + src->options.size;
+    }
+    assert((const uint8_t *) dst->payload + dst->payload_size
+           == packet_buf + written);
+    return AVS_OK;
 }
 
 #endif // WITH_AVS_COAP_UDP
@@ -32,17 +32,46 @@
 
 VISIBILITY_SOURCE_BEGIN
 
+/* Remote endpoint identity. Each distinct (addr, port) pair is interned only
+ * once per cache, so cache entries can be matched by comparing endpoint
+ * pointers instead of strings. */
 typedef struct endpoint {
     size_t refcount;
+    uint32_t hash; // endpoint_key_hash() of addr and port
     char addr[AVS_ADDRSTRLEN];
     char port[sizeof("65535")];
 } endpoint_t;
 
+#    define ENDPOINT_BUCKETS_INITIAL_COUNT 4
+
+/* Value of an unused index slot. Entry positions are always multiples of
+ * AVS_ALIGNOF(cache_entry_t), so they can never be equal to SIZE_MAX. */
+#    define INDEX_SLOT_EMPTY SIZE_MAX
+
+#    define INDEX_INITIAL_CAPACITY 16
+
 struct avs_coap_udp_response_cache {
-    AVS_LIST(endpoint_t) endpoints; // sorted by id
+    /* Hash table of interned endpoints, with separate chaining.
+     * endpoint_buckets_count is zero or a power of two. */
+    AVS_LIST(endpoint_t) *endpoint_buckets;
+    size_t endpoint_buckets_count;
+    size_t endpoints_count;
 
     // priority queue of cache_entry_t, sorted by expiration_time
     avs_buffer_t *buffer;
+
+    /* Total number of bytes ever consumed from the front of buffer. Entry
+     * positions stored in index_slots are expressed relative to it, so that
+     * they remain valid even if avs_buffer moves its data around. */
+    size_t consumed_bytes;
+
+    /* Open-addressing (linear probing) hash index of all entries in buffer,
+     * keyed by (endpoint, message ID). Each slot contains either an entry
+     * position (see entry_pos()) or INDEX_SLOT_EMPTY. index_capacity is zero
+     * or a power of two, and is kept at least twice as large as index_size. */
+    size_t *index_slots;
+    size_t index_capacity;
+    size_t index_size;
 };
 
 typedef struct cache_entry {
@@ -81,29 +110,123 @@ void avs_coap_udp_response_cache_release(
         avs_coap_udp_response_cache_t **cache_ptr) {
     if (cache_ptr && *cache_ptr) {
         avs_buffer_free(&(*cache_ptr)->buffer);
-        AVS_LIST_CLEAR(&(*cache_ptr)->endpoints);
+        avs_free((*cache_ptr)->index_slots);
+        for (size_t i = 0; i < (*cache_ptr)->endpoint_buckets_count; ++i) {
+            AVS_LIST_CLEAR(&(*cache_ptr)->endpoint_buckets[i]);
+        }
+        avs_free((*cache_ptr)->endpoint_buckets);
         avs_free(*cache_ptr);
         *cache_ptr = NULL;
     }
 }
 
-static endpoint_t *cache_endpoint_add_ref(avs_coap_udp_response_cache_t *cache,
-                                          const char *remote_addr,
-                                          const char *remote_port) {
+static uint32_t hash_mix32(uint32_t value) {
+    // finalizer of MurmurHash3
+    value ^= value >> 16;
+    value *= 0x85EBCA6BU;
+    value ^= value >> 13;
+    value *= 0xC2B2AE35U;
+    value ^= value >> 16;
+    return value;
+}
+
+static uint32_t hash_string_fnv1a(uint32_t hash, const char *str) {
+    // NOTE: the terminating nullbyte is hashed as well, so that
+    // ("ab", "c") and ("a", "bc") are hashed differently
+    do {
+        hash ^= (uint8_t) *str;
+        hash *= 16777619U;
+    } while (*str++);
+    return hash;
+}
+
+static uint32_t endpoint_key_hash(const char *remote_addr,
+                                  const char *remote_port) {
+    return hash_mix32(hash_string_fnv1a(
+            hash_string_fnv1a(2166136261U, remote_addr), remote_port));
+}
+
+static AVS_LIST(endpoint_t) *
+cache_endpoint_bucket(const avs_coap_udp_response_cache_t *cache,
+                      uint32_t hash) {
+    assert(cache->endpoint_buckets_count);
+    return &cache->endpoint_buckets[hash
+                                    & (cache->endpoint_buckets_count - 1)];
+}
+
+static endpoint_t *
+cache_endpoint_find(const avs_coap_udp_response_cache_t *cache,
+                    const char *remote_addr,
+                    const char *remote_port) {
     assert(remote_addr);
     assert(remote_port);
 
-    AVS_LIST(endpoint_t) *ep_ptr;
-    AVS_LIST_FOREACH_PTR(ep_ptr, &cache->endpoints) {
-        if (!strcmp(remote_addr, (*ep_ptr)->addr)
-                && !strcmp(remote_port, (*ep_ptr)->port)) {
-            if ((*ep_ptr)->refcount == SIZE_MAX) {
-                LOG(WARNING, _("msg_cache: endpoint refcount overflow"));
-                return NULL;
-            }
-            ++(*ep_ptr)->refcount;
-            return *ep_ptr;
+    if (!cache->endpoints_count) {
+        return NULL;
+    }
+
+    const uint32_t hash = endpoint_key_hash(remote_addr, remote_port);
+    AVS_LIST(endpoint_t) ep;
+    AVS_LIST_FOREACH(ep, *cache_endpoint_bucket(cache, hash)) {
+        if (ep->hash == hash && !strcmp(remote_addr, ep->addr)
+                && !strcmp(remote_port, ep->port)) {
+            return ep;
+        }
+    }
+    return NULL;
+}
+
+/* Makes sure there is at least one endpoint bucket per interned endpoint.
+ * Failure to grow an already allocated table is not fatal - it only makes
+ * the bucket chains longer. */
+static int cache_endpoint_buckets_reserve(avs_coap_udp_response_cache_t *cache,
+                                          size_t required_count) {
+    if (required_count <= cache->endpoint_buckets_count) {
+        return 0;
+    }
+
+    size_t new_count = cache->endpoint_buckets_count
+                               ? cache->endpoint_buckets_count * 2
+                               : ENDPOINT_BUCKETS_INITIAL_COUNT;
+    AVS_LIST(endpoint_t) *new_buckets = (AVS_LIST(endpoint_t) *) avs_calloc(
+            new_count, sizeof(*new_buckets));
+    if (!new_buckets) {
+        if (cache->endpoint_buckets_count) {
+            return 0;
+        }
+        LOG_OOM();
+        return -1;
+    }
+
+    for (size_t i = 0; i < cache->endpoint_buckets_count; ++i) {
+        while (cache->endpoint_buckets[i]) {
+            AVS_LIST(endpoint_t) ep =
+                    AVS_LIST_DETACH(&cache->endpoint_buckets[i]);
+            AVS_LIST_INSERT(&new_buckets[ep->hash & (new_count - 1)], ep);
+        }
+    }
+
+    avs_free(cache->endpoint_buckets);
+    cache->endpoint_buckets = new_buckets;
+    cache->endpoint_buckets_count = new_count;
+    return 0;
+}
+
+static endpoint_t *cache_endpoint_add_ref(avs_coap_udp_response_cache_t *cache,
+                                          const char *remote_addr,
+                                          const char *remote_port) {
+    endpoint_t *ep = cache_endpoint_find(cache, remote_addr, remote_port);
+    if (ep) {
+        if (ep->refcount == SIZE_MAX) {
+            LOG(WARNING, _("msg_cache: endpoint refcount overflow"));
+            return NULL;
         }
+        ++ep->refcount;
+        return ep;
+    }
+
+    if (cache_endpoint_buckets_reserve(cache, cache->endpoints_count + 1)) {
+        return NULL;
     }
 
     AVS_LIST(endpoint_t) new_ep = AVS_LIST_NEW_ELEMENT(endpoint_t);
@@ -127,7 +250,9 @@ static endpoint_t *cache_endpoint_add_ref(avs_coap_udp_response_cache_t *cache,
     }
 
     new_ep->refcount = 1;
-    AVS_LIST_INSERT(&cache->endpoints, new_ep);
+    new_ep->hash = endpoint_key_hash(remote_addr, remote_port);
+    AVS_LIST_INSERT(cache_endpoint_bucket(cache, new_ep->hash), new_ep);
+    ++cache->endpoints_count;
 
     LOG(TRACE, _("added cache endpoint: ") "%s:%s", new_ep->addr, new_ep->port);
     return new_ep;
@@ -137,13 +262,15 @@ static void cache_endpoint_del_ref(avs_coap_udp_response_cache_t *cache,
                                    endpoint_t *endpoint) {
     assert(endpoint->refcount > 0);
     if (--endpoint->refcount == 0) {
-        AVS_LIST(endpoint_t) *ep_ptr =
-                (AVS_LIST(endpoint_t) *) AVS_LIST_FIND_PTR(&cache->endpoints,
-                                                           endpoint);
+        AVS_LIST(endpoint_t) *ep_ptr = (AVS_LIST(endpoint_t) *)
+                AVS_LIST_FIND_PTR(cache_endpoint_bucket(cache, endpoint->hash),
+                                  endpoint);
         assert(ep_ptr && *ep_ptr && *ep_ptr == endpoint);
         LOG(TRACE, _("removed cache endpoint: ") "%s:%s", (*ep_ptr)->addr,
             (*ep_ptr)->port);
         AVS_LIST_DELETE(ep_ptr);
+        assert(cache->endpoints_count > 0);
+        --cache->endpoints_count;
     }
 }
 
@@ -244,6 +371,135 @@ static const cache_entry_t *entry_next(const cache_entry_t *entry) {
     return result;
 }
 
+/* Position of an entry is its offset from the beginning of all data ever
+ * written to the buffer (modulo SIZE_MAX + 1). Unlike raw pointers, positions
+ * do not change when avs_buffer defragments itself. */
+static size_t entry_pos(const avs_coap_udp_response_cache_t *cache,
+                        const cache_entry_t *entry) {
+    return cache->consumed_bytes
+           + (size_t) ((const char *) entry - avs_buffer_data(cache->buffer));
+}
+
+static const cache_entry_t *
+entry_at_pos(const avs_coap_udp_response_cache_t *cache, size_t pos) {
+    const cache_entry_t *result =
+            (const cache_entry_t *) (avs_buffer_data(cache->buffer)
+                                     + (pos - cache->consumed_bytes));
+    assert(entry_valid(cache, result));
+    return result;
+}
+
+static size_t index_hash(const endpoint_t *endpoint, uint16_t msg_id) {
+    return (size_t) hash_mix32(endpoint->hash ^ msg_id);
+}
+
+static size_t index_entry_hash(const cache_entry_t *entry) {
+    return index_hash(entry->endpoint, entry_id(entry));
+}
+
+static void index_slots_insert(const avs_coap_udp_response_cache_t *cache,
+                               size_t *slots,
+                               size_t capacity,
+                               size_t pos) {
+    const size_t mask = capacity - 1;
+    size_t i = index_entry_hash(entry_at_pos(cache, pos)) & mask;
+    while (slots[i] != INDEX_SLOT_EMPTY) {
+        i = (i + 1) & mask;
+    }
+    slots[i] = pos;
+}
+
+/* Makes sure that the index can hold at least @p required_size entries
+ * while keeping its load factor at or below 1/2. */
+static int index_reserve(avs_coap_udp_response_cache_t *cache,
+                         size_t required_size) {
+    if (required_size <= cache->index_capacity / 2) {
+        return 0;
+    }
+
+    size_t new_capacity = cache->index_capacity ? cache->index_capacity
+                                                : INDEX_INITIAL_CAPACITY;
+    while (required_size > new_capacity / 2) {
+        if (new_capacity > SIZE_MAX / 2 / sizeof(size_t)) {
+            return -1;
+        }
+        new_capacity *= 2;
+    }
+
+    size_t *new_slots =
+            (size_t *) avs_malloc(new_capacity * sizeof(*new_slots));
+    if (!new_slots) {
+        LOG_OOM();
+        return -1;
+    }
+    for (size_t i = 0; i < new_capacity; ++i) {
+        new_slots[i] = INDEX_SLOT_EMPTY;
+    }
+    for (size_t i = 0; i < cache->index_capacity; ++i) {
+        if (cache->index_slots[i] != INDEX_SLOT_EMPTY) {
+            index_slots_insert(cache, new_slots, new_capacity,
+                               cache->index_slots[i]);
+        }
+    }
+
+    avs_free(cache->index_slots);
+    cache->index_slots = new_slots;
+    cache->index_capacity = new_capacity;
+    return 0;
+}
+
+static void index_insert(avs_coap_udp_response_cache_t *cache, size_t pos) {
+    assert(cache->index_size < cache->index_capacity / 2);
+    index_slots_insert(cache, cache->index_slots, cache->index_capacity, pos);
+    ++cache->index_size;
+}
+
+static const cache_entry_t *
+index_find(const avs_coap_udp_response_cache_t *cache,
+           const endpoint_t *endpoint,
+           uint16_t msg_id) {
+    if (!cache->index_size) {
+        return NULL;
+    }
+
+    const size_t mask = cache->index_capacity - 1;
+    for (size_t i = index_hash(endpoint, msg_id) & mask;
+         cache->index_slots[i] != INDEX_SLOT_EMPTY;
+         i = (i + 1) & mask) {
+        const cache_entry_t *entry = entry_at_pos(cache, cache->index_slots[i]);
+        if (entry->endpoint == endpoint && entry_id(entry) == msg_id) {
+            return entry;
+        }
+    }
+    return NULL;
+}
+
+static void index_remove(avs_coap_udp_response_cache_t *cache,
+                         const cache_entry_t *entry) {
+    const size_t mask = cache->index_capacity - 1;
+    const size_t pos = entry_pos(cache, entry);
+
+    size_t i = index_entry_hash(entry) & mask;
+    while (cache->index_slots[i] != pos) {
+        assert(cache->index_slots[i] != INDEX_SLOT_EMPTY);
+        i = (i + 1) & mask;
+    }
+
+    // backward shift deletion, so that no tombstones are necessary
+    for (size_t j = (i + 1) & mask; cache->index_slots[j] != INDEX_SLOT_EMPTY;
+         j = (j + 1) & mask) {
+        size_t home = index_entry_hash(
+                              entry_at_pos(cache, cache->index_slots[j]))
+                      & mask;
+        if (((j - home) & mask) >= ((j - i) & mask)) {
+            cache->index_slots[i] = cache->index_slots[j];
+            i = j;
+        }
+    }
+    cache->index_slots[i] = INDEX_SLOT_EMPTY;
+    --cache->index_size;
+}
+
 static void cache_free_bytes(avs_coap_udp_response_cache_t *cache,
                              size_t bytes_required) {
     assert(bytes_required <= avs_buffer_capacity(cache->buffer));
@@ -259,6 +515,7 @@ static void cache_free_bytes(avs_coap_udp_response_cache_t *cache,
             _("msg_cache: dropping msg (id = ") "%u" _(
                     ") to make room for a new one (size = ") "%lu" _(")"),
             entry_id(entry), (unsigned long) bytes_required);
+        index_remove(cache, entry);
         cache_endpoint_del_ref(cache, entry->endpoint);
         bytes_free += entry_size(entry);
     }
@@ -267,6 +524,7 @@ static void cache_free_bytes(avs_coap_udp_response_cache_t *cache,
     int res = avs_buffer_consume_bytes(cache->buffer, expired_bytes);
     assert(!res);
     (void) res;
+    cache->consumed_bytes += expired_bytes;
 }
 
 static void cache_drop_expired(avs_coap_udp_response_cache_t *cache,
@@ -277,6 +535,7 @@ static void cache_drop_expired(avs_coap_udp_response_cache_t *cache,
         if (entry_expired(entry, now)) {
             LOG(TRACE, _("msg_cache: dropping expired msg (id = ") "%u" _(")"),
                 entry_id(entry));
+            index_remove(cache, entry);
             cache_endpoint_del_ref(cache, entry->endpoint);
         } else {
             break;
@@ -287,6 +546,7 @@ static void cache_drop_expired(avs_coap_udp_response_cache_t *cache,
     int res = avs_buffer_consume_bytes(cache->buffer, expired_bytes);
     assert(!res);
     (void) res;
+    cache->consumed_bytes += expired_bytes;
 }
 
 static const cache_entry_t *
@@ -294,17 +554,14 @@ find_entry(const avs_coap_udp_response_cache_t *cache,
            const char *remote_addr,
            const char *remote_port,
            uint16_t msg_id) {
-    for (const cache_entry_t *entry = entry_first(cache);
-         entry_valid(cache, entry);
-         entry = entry_next(entry)) {
-        if (entry_id(entry) == msg_id
-                && !strcmp(entry->endpoint->addr, remote_addr)
-                && !strcmp(entry->endpoint->port, remote_port)) {
-            return entry;
-        }
+    // every cache entry holds a reference to its endpoint, so if there is no
+    // endpoint, there are no matching entries either
+    const endpoint_t *endpoint =
+            cache_endpoint_find(cache, remote_addr, remote_port);
+    if (!endpoint) {
+        return NULL;
     }
-
-    return NULL;
+    return index_find(cache, endpoint, msg_id);
 }
 
 int _avs_coap_udp_response_cache_add(
@@ -336,6 +593,10 @@ int _avs_coap_udp_response_cache_add(
         return AVS_COAP_MSG_CACHE_DUPLICATE;
     }
 
+    if (index_reserve(cache, cache->index_size + 1)) {
+        return -1;
+    }
+
     endpoint_t *ep = cache_endpoint_add_ref(cache, remote_addr, remote_port);
     if (!ep) {
         return -1;
@@ -348,7 +609,10 @@ int _avs_coap_udp_response_cache_add(
     avs_time_monotonic_t expiration_time =
             avs_time_monotonic_add(now, exchange_lifetime);
 
+    const size_t new_entry_pos =
+            cache->consumed_bytes + avs_buffer_data_size(cache->buffer);
     cache_put_entry(cache, &expiration_time, ep, msg);
+    index_insert(cache, new_entry_pos);
     return 0;
 }
 
@@ -19,6 +19,8 @@
 #    define MODULE_NAME coap_udp
 #    include <avs_coap_x_log_config.h>
 
+#    include "udp/avs_coap_udp_tx_params.h"
+
 VISIBILITY_SOURCE_BEGIN
 
 const avs_coap_udp_tx_params_t AVS_COAP_DEFAULT_UDP_TX_PARAMS = {
@@ -90,4 +92,147 @@ avs_coap_udp_exchange_lifetime(const avs_coap_udp_tx_params_t *tx_params) {
             tx_params->ack_timeout);
 }
 
+// Constants below come from draft-ietf-core-cocoa and RFC 6298
+static const avs_time_duration_t RTO_MAX = { 60, 0 };
+static const avs_time_duration_t RTO_AGING_LOW = { 1, 0 };
+static const avs_time_duration_t RTO_AGING_HIGH = { 3, 0 };
+static const avs_time_duration_t CLOCK_GRANULARITY = { 0, 10000000 };
+static const unsigned STRONG_RTTVAR_K = 4;
+static const unsigned WEAK_RTTVAR_K = 1;
+static const unsigned WEAK_MAX_RETRANSMISSIONS = 2;
+
+static avs_time_duration_t
+current_overall_rto(const avs_coap_udp_ctx_t *ctx) {
+    // overall RTO is only set after the first sample, so that changing
+    // ACK_TIMEOUT has immediate effect until then
+    return avs_time_duration_valid(ctx->rto_state.overall_rto)
+                   ? ctx->rto_state.overall_rto
+                   : ctx->tx_params.ack_timeout;
+}
+
+static void set_overall_rto(avs_coap_udp_ctx_t *ctx, avs_time_duration_t rto) {
+    ctx->rto_state.overall_rto =
+            avs_time_duration_less(RTO_MAX, rto) ? RTO_MAX : rto;
+    ctx->rto_state.last_update = avs_time_monotonic_now();
+}
+
+avs_time_duration_t _avs_coap_udp_initial_rto(avs_coap_udp_ctx_t *ctx) {
+    if (!ctx->rto_state.enabled
+            || !avs_time_duration_valid(ctx->rto_state.overall_rto)) {
+        return ctx->tx_params.ack_timeout;
+    }
+
+    // RTO aging: move estimates that were not updated for a long time back
+    // towards the 1-3 s range, as they might not reflect the link anymore
+    const avs_time_duration_t rto = ctx->rto_state.overall_rto;
+    const avs_time_duration_t since_update =
+            avs_time_monotonic_diff(avs_time_monotonic_now(),
+                                    ctx->rto_state.last_update);
+    if (avs_time_duration_less(rto, RTO_AGING_LOW)
+            && !avs_time_duration_less(since_update,
+                                       avs_time_duration_mul(rto, 16))) {
+        set_overall_rto(ctx, avs_time_duration_mul(rto, 2));
+    } else if (avs_time_duration_less(RTO_AGING_HIGH, rto)
+               && !avs_time_duration_less(since_update,
+                                          avs_time_duration_mul(rto, 4))) {
+        set_overall_rto(ctx,
+                        avs_time_duration_add(RTO_AGING_LOW,
+                                              avs_time_duration_div(rto, 2)));
+    }
+    return ctx->rto_state.overall_rto;
+}
+
+double _avs_coap_udp_backoff_factor(const avs_coap_udp_ctx_t *ctx) {
+    if (!ctx->rto_state.enabled) {
+        return 2.0;
+    }
+    const avs_time_duration_t rto = current_overall_rto(ctx);
+    if (avs_time_duration_less(rto, RTO_AGING_LOW)) {
+        return 3.0;
+    } else if (avs_time_duration_less(RTO_AGING_HIGH, rto)) {
+        return 1.5;
+    }
+    return 2.0;
+}
+
+static avs_time_duration_t
+update_estimator(avs_coap_udp_rtt_estimator_t *estimator,
+                 avs_time_duration_t rtt,
+                 unsigned rttvar_k) {
+    if (!avs_time_duration_valid(estimator->srtt)) {
+        estimator->srtt = rtt;
+        estimator->rttvar = avs_time_duration_div(rtt, 2);
+    } else {
+        const avs_time_duration_t deviation =
+                avs_time_duration_less(rtt, estimator->srtt)
+                        ? avs_time_duration_diff(estimator->srtt, rtt)
+                        : avs_time_duration_diff(rtt, estimator->srtt);
+        // RTTVAR <- 3/4 * RTTVAR + 1/4 * |SRTT - R|
+        estimator->rttvar = avs_time_duration_add(
+                avs_time_duration_fmul(estimator->rttvar, 0.75),
+                avs_time_duration_div(deviation, 4));
+        // SRTT <- 7/8 * SRTT + 1/8 * R
+        estimator->srtt =
+                avs_time_duration_add(avs_time_duration_fmul(estimator->srtt,
+                                                             0.875),
+                                      avs_time_duration_div(rtt, 8));
+    }
+
+    avs_time_duration_t variance_term =
+            avs_time_duration_mul(estimator->rttvar, (int32_t) rttvar_k);
+    if (avs_time_duration_less(variance_term, CLOCK_GRANULARITY)) {
+        variance_term = CLOCK_GRANULARITY;
+    }
+    estimator->rto = avs_time_duration_add(estimator->srtt, variance_term);
+    return estimator->rto;
+}
+
+void _avs_coap_udp_rtt_sample(avs_coap_udp_ctx_t *ctx,
+                              avs_time_duration_t rtt,
+                              unsigned retransmissions) {
+    if (!ctx->rto_state.enabled || !avs_time_duration_valid(rtt)
+            || avs_time_duration_less(rtt, AVS_TIME_DURATION_ZERO)
+            || retransmissions > WEAK_MAX_RETRANSMISSIONS) {
+        return;
+    }
+
+    const avs_time_duration_t overall_rto = current_overall_rto(ctx);
+    if (!retransmissions) {
+        // RTO <- 1/2 * E_strong + 1/2 * RTO
+        avs_time_duration_t strong =
+                update_estimator(&ctx->rto_state.strong, rtt, STRONG_RTTVAR_K);
+        set_overall_rto(ctx, avs_time_duration_add(
+                                     avs_time_duration_div(strong, 2),
+                                     avs_time_duration_div(overall_rto, 2)));
+        ++ctx->stats.strong_rtt_samples_count;
+    } else {
+        // RTO <- 1/4 * E_weak + 3/4 * RTO
+        avs_time_duration_t weak =
+                update_estimator(&ctx->rto_state.weak, rtt, WEAK_RTTVAR_K);
+        set_overall_rto(ctx, avs_time_duration_add(
+                                     avs_time_duration_div(weak, 4),
+                                     avs_time_duration_fmul(overall_rto,
+                                                            0.75)));
+        ++ctx->stats.weak_rtt_samples_count;
+    }
+
+    LOG(DEBUG, _("RTT sample: ") "%s" _(", overall RTO: ") "%s",
+        AVS_TIME_DURATION_AS_STRING(rtt),
+        AVS_TIME_DURATION_AS_STRING(ctx->rto_state.overall_rto));
+}
+
+void _avs_coap_udp_rtt_fill_stats(const avs_coap_udp_ctx_t *ctx,
+                                  avs_coap_stats_t *stats) {
+    if (!ctx->rto_state.enabled) {
+        return;
+    }
+    if (avs_time_duration_valid(ctx->rto_state.strong.rto)) {
+        stats->strong_rto = ctx->rto_state.strong.rto;
+    }
+    if (avs_time_duration_valid(ctx->rto_state.weak.rto)) {
+        stats->weak_rto = ctx->rto_state.weak.rto;
+    }
+    stats->overall_rto = current_overall_rto(ctx);
+}
+
 #endif // WITH_AVS_COAP_UDP
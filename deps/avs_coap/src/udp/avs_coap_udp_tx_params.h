@@ -32,6 +32,36 @@ _avs_coap_udp_max_transmit_span(const avs_coap_udp_tx_params_t *tx_params) {
                                           * tx_params->ack_random_factor);
 }
 
+/**
+ * @returns Base for the initial retransmission timeout of a new message:
+ *          ACK_TIMEOUT, or the overall RTO estimate if RTT estimation is
+ *          enabled. In the latter case, aging of the estimate is applied
+ *          first.
+ */
+avs_time_duration_t _avs_coap_udp_initial_rto(avs_coap_udp_ctx_t *ctx);
+
+/**
+ * @returns Factor by which the retransmission timeout is multiplied on each
+ *          retransmission: 2 as specified in RFC 7252, or the CoCoA variable
+ *          backoff factor if RTT estimation is enabled.
+ */
+double _avs_coap_udp_backoff_factor(const avs_coap_udp_ctx_t *ctx);
+
+/**
+ * Feeds the RTT estimator with a round-trip time measured for a message that
+ * was acknowledged after @p retransmissions retransmissions. Does nothing if
+ * RTT estimation is disabled or the sample is too ambiguous to be used.
+ */
+void _avs_coap_udp_rtt_sample(avs_coap_udp_ctx_t *ctx,
+                              avs_time_duration_t rtt,
+                              unsigned retransmissions);
+
+/**
+ * Fills RTT estimator fields of @p stats with the current state.
+ */
+void _avs_coap_udp_rtt_fill_stats(const avs_coap_udp_ctx_t *ctx,
+                                  avs_coap_stats_t *stats);
+
 static inline avs_error_t
 _avs_coap_udp_initial_retry_state(avs_coap_udp_ctx_t *ctx,
                                   avs_coap_retry_state_t *out_retry_state) {
@@ -47,7 +77,7 @@ _avs_coap_udp_initial_retry_state(avs_coap_udp_ctx_t *ctx,
 
     *out_retry_state = (avs_coap_retry_state_t) {
         .retries_left = ctx->tx_params.max_retransmit,
-        .recv_timeout = avs_time_duration_fmul(ctx->tx_params.ack_timeout,
+        .recv_timeout = avs_time_duration_fmul(_avs_coap_udp_initial_rto(ctx),
                                                1.0 + random_factor)
     };
     return AVS_OK;
@@ -60,13 +90,18 @@ _avs_coap_udp_initial_retry_state(avs_coap_udp_ctx_t *ctx,
 static inline int
 _avs_coap_udp_update_retry_state(avs_coap_udp_ctx_t *ctx,
                                  avs_coap_retry_state_t *retry_state) {
-    retry_state->recv_timeout =
-            avs_time_duration_mul(retry_state->recv_timeout, 2);
+    if (ctx->rto_state.enabled) {
+        retry_state->recv_timeout =
+                avs_time_duration_fmul(retry_state->recv_timeout,
+                                       _avs_coap_udp_backoff_factor(ctx));
+    } else {
+        retry_state->recv_timeout =
+                avs_time_duration_mul(retry_state->recv_timeout, 2);
+    }
     --retry_state->retries_left;
     if (!avs_time_duration_valid(retry_state->recv_timeout)) {
         return -1;
     }
-    (void) ctx;
     return 0;
 }
 
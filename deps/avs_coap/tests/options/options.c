@@ -807,6 +807,51 @@ AVS_UNIT_TEST(coap_options_dynamic, double_cleanup) {
     avs_coap_options_cleanup(&opts);
 }
 
+AVS_UNIT_TEST(coap_options_dynamic, init_from_template) {
+    uint8_t buf[128];
+    avs_coap_options_t template_opts =
+            avs_coap_options_create_empty(buf, sizeof(buf));
+    ASSERT_OK(avs_coap_options_add_string(&template_opts,
+                                          AVS_COAP_OPTION_URI_PATH, "rd"));
+    ASSERT_OK(avs_coap_options_add_string(&template_opts,
+                                          AVS_COAP_OPTION_URI_PATH, "5a3f"));
+
+    avs_coap_options_t opts;
+    ASSERT_OK(avs_coap_options_dynamic_init_from_template(&opts, &template_opts,
+                                                          16));
+    ASSERT_TRUE(opts.allocated);
+    ASSERT_EQ(opts.size, template_opts.size);
+    ASSERT_EQ(opts.capacity, template_opts.size + 16);
+    ASSERT_EQ_BYTES_SIZED(opts.begin, template_opts.begin, opts.size);
+
+    // adding an option must not modify the template
+    const size_t template_size = template_opts.size;
+    ASSERT_OK(avs_coap_options_add_string(&opts, AVS_COAP_OPTION_URI_QUERY,
+                                          "lt=60"));
+    ASSERT_EQ(template_opts.size, template_size);
+    ASSERT_EQ(opts.capacity, template_opts.size + 16);
+
+    char value[16];
+    size_t value_size;
+    avs_coap_option_iterator_t it = AVS_COAP_OPTION_ITERATOR_EMPTY;
+    ASSERT_EQ(avs_coap_options_get_string_it(&opts, AVS_COAP_OPTION_URI_PATH,
+                                             &it, &value_size, value,
+                                             sizeof(value)),
+              0);
+    ASSERT_EQ_STR(value, "rd");
+    ASSERT_EQ(avs_coap_options_get_string_it(&opts, AVS_COAP_OPTION_URI_PATH,
+                                             &it, &value_size, value,
+                                             sizeof(value)),
+              0);
+    ASSERT_EQ_STR(value, "5a3f");
+    ASSERT_EQ(avs_coap_options_get_string(&opts, AVS_COAP_OPTION_URI_QUERY,
+                                          &value_size, value, sizeof(value)),
+              0);
+    ASSERT_EQ_STR(value, "lt=60");
+
+    avs_coap_options_cleanup(&opts);
+}
+
 AVS_UNIT_TEST(coap_options, cleanup_is_safe_on_static_options) {
     uint8_t buf[128];
     avs_coap_options_t opts = avs_coap_options_create_empty(buf, sizeof(buf));
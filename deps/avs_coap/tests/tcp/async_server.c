@@ -384,6 +384,54 @@ AVS_UNIT_TEST(tcp_async_server, handle_request_with_options_partial) {
     ASSERT_OK(handle_incoming_packet(env.coap_ctx, NULL, NULL));
 }
 
+AVS_UNIT_TEST(tcp_async_server, handle_request_token_and_options_together) {
+    test_env_t env __attribute__((cleanup(test_teardown))) = test_setup();
+    request_handler_args_t args
+            __attribute__((cleanup(cleanup_request_handler_args))) =
+                    setup_request_handler_args(env.coap_ctx, EXCHANGE_ID(1));
+
+    const test_msg_t *req = COAP_MSG(GET, TOKEN(nth_token(0)), ACCEPT(123),
+                                     PAYLOAD("PlacLaduj"));
+    const test_msg_t *res = COAP_MSG(CONTENT, TOKEN(nth_token(0)));
+
+    // Token, options and payload are all returned by the recv call issued
+    // when receiving the token, so options must be parsed without another one.
+    avs_unit_mocksock_input(env.mocksock, req->data, req->token_offset);
+    avs_unit_mocksock_input(env.mocksock, req->data + req->token_offset,
+                            req->size - req->token_offset);
+    expect_send(&env, res);
+    expect_has_buffered_data_check(&env, false);
+
+    expect_last_chunk(&args, req->msg.content.payload, 9, ACTION_NONE, NULL);
+    expect_cleanup(&args);
+    ASSERT_OK(handle_incoming_packet(env.coap_ctx, handle_new_request, &args));
+}
+
+AVS_UNIT_TEST(tcp_async_server, handle_request_token_and_options_split) {
+    test_env_t env __attribute__((cleanup(test_teardown))) = test_setup();
+    request_handler_args_t args
+            __attribute__((cleanup(cleanup_request_handler_args))) =
+                    setup_request_handler_args(env.coap_ctx, EXCHANGE_ID(1));
+
+    const test_msg_t *req = COAP_MSG(GET, TOKEN(nth_token(0)), ACCEPT(123),
+                                     PAYLOAD("PlacLaduj"));
+    const test_msg_t *res = COAP_MSG(CONTENT, TOKEN(nth_token(0)));
+
+    // Only the token is returned when receiving it, so options have to be
+    // received by a separate recv call.
+    avs_unit_mocksock_input(env.mocksock, req->data, req->token_offset);
+    avs_unit_mocksock_input(env.mocksock, req->data + req->token_offset,
+                            req->options_offset - req->token_offset);
+    avs_unit_mocksock_input(env.mocksock, req->data + req->options_offset,
+                            req->size - req->options_offset);
+    expect_send(&env, res);
+    expect_has_buffered_data_check(&env, false);
+
+    expect_last_chunk(&args, req->msg.content.payload, 9, ACTION_NONE, NULL);
+    expect_cleanup(&args);
+    ASSERT_OK(handle_incoming_packet(env.coap_ctx, handle_new_request, &args));
+}
+
 AVS_UNIT_TEST(tcp_async_server, empty_token) {
     test_env_t env __attribute__((cleanup(test_teardown))) = test_setup();
     request_handler_args_t args
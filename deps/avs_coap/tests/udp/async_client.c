@@ -20,6 +20,8 @@
 
 #    include "./utils.h"
 
+#    include "udp/avs_coap_udp_ctx.h"
+
 AVS_UNIT_TEST(udp_async_client, send_request_empty_get) {
     test_env_t env __attribute__((cleanup(test_teardown))) =
             test_setup_default();
@@ -45,6 +47,86 @@ AVS_UNIT_TEST(udp_async_client, send_request_empty_get) {
     ASSERT_OK(avs_coap_async_handle_incoming_packet(env.coap_ctx, NULL, NULL));
 }
 
+AVS_UNIT_TEST(udp_async_client, unconfirmed_msg_reused) {
+    test_env_t env __attribute__((cleanup(test_teardown))) =
+            test_setup_default();
+    avs_coap_udp_ctx_t *ctx = (avs_coap_udp_ctx_t *) env.coap_ctx;
+
+    const test_msg_t *requests[] = {
+        COAP_MSG(CON, GET, ID(0), TOKEN(nth_token(0))),
+        COAP_MSG(CON, GET, ID(1), TOKEN(nth_token(1)))
+    };
+    const test_msg_t *responses[] = {
+        COAP_MSG(ACK, CONTENT, ID(0), TOKEN(nth_token(0))),
+        COAP_MSG(ACK, CONTENT, ID(1), TOKEN(nth_token(1)))
+    };
+    avs_coap_udp_unconfirmed_msg_t *pooled = NULL;
+
+    for (size_t i = 0; i < AVS_ARRAY_SIZE(requests); ++i) {
+        avs_coap_exchange_id_t id;
+        ASSERT_OK(avs_coap_client_send_async_request(
+                env.coap_ctx, &id, &requests[i]->request_header, NULL, NULL,
+                test_response_handler, &env.expects_list));
+        expect_send(&env, requests[i]);
+        avs_sched_run(env.sched);
+
+        // the entry released after the first exchange is used for the second
+        ASSERT_NOT_NULL(ctx->unconfirmed_messages);
+        if (pooled) {
+            ASSERT_TRUE(ctx->unconfirmed_messages == pooled);
+        }
+        ASSERT_NULL(ctx->unconfirmed_pool);
+        ASSERT_EQ(ctx->unconfirmed_pool_size, 0);
+
+        expect_recv(&env, responses[i]);
+        expect_handler_call(&env, &id, AVS_COAP_CLIENT_REQUEST_OK,
+                            responses[i]);
+        expect_has_buffered_data_check(&env, false);
+        ASSERT_OK(avs_coap_async_handle_incoming_packet(env.coap_ctx, NULL,
+                                                        NULL));
+
+        ASSERT_NULL(ctx->unconfirmed_messages);
+        ASSERT_NOT_NULL(ctx->unconfirmed_pool);
+        ASSERT_EQ(ctx->unconfirmed_pool_size, 1);
+        pooled = ctx->unconfirmed_pool;
+    }
+}
+
+AVS_UNIT_TEST(udp_async_client, unconfirmed_msg_points_into_packet) {
+    test_env_t env __attribute__((cleanup(test_teardown))) =
+            test_setup_default();
+    avs_coap_udp_ctx_t *ctx = (avs_coap_udp_ctx_t *) env.coap_ctx;
+
+    const test_msg_t *request =
+            COAP_MSG(CON, GET, ID(0), TOKEN(nth_token(0)), PATH("foo", "bar"));
+    avs_coap_exchange_id_t id;
+
+    ASSERT_OK(avs_coap_client_send_async_request(
+            env.coap_ctx, &id, &request->request_header, NULL, NULL,
+            test_response_handler, &env.expects_list));
+    expect_send(&env, request);
+    avs_sched_run(env.sched);
+
+    // the stored message must describe the stored packet, without reparsing
+    const avs_coap_udp_unconfirmed_msg_t *unconfirmed =
+            ctx->unconfirmed_messages;
+    ASSERT_NOT_NULL(unconfirmed);
+    ASSERT_EQ(unconfirmed->packet_size, request->size);
+    ASSERT_EQ_BYTES_SIZED(unconfirmed->packet, request->data, request->size);
+    ASSERT_TRUE(avs_coap_token_equal(&unconfirmed->msg.token,
+                                     &request->msg.token));
+    ASSERT_EQ(unconfirmed->msg.options.size, request->msg.options.size);
+    ASSERT_TRUE((const uint8_t *) unconfirmed->msg.options.begin
+                > unconfirmed->packet);
+    ASSERT_EQ_BYTES_SIZED(unconfirmed->msg.options.begin,
+                          request->msg.options.begin,
+                          request->msg.options.size);
+    ASSERT_EQ(unconfirmed->msg.payload_size, 0);
+
+    expect_handler_call(&env, &id, AVS_COAP_CLIENT_REQUEST_CANCEL, NULL);
+    avs_coap_exchange_cancel(env.coap_ctx, id);
+}
+
 AVS_UNIT_TEST(udp_async_client, send_non_request) {
     test_env_t env __attribute__((cleanup(test_teardown))) =
             test_setup_default();
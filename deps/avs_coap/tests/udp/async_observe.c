@@ -21,6 +21,8 @@
 
 #    include "./utils.h"
 
+#    include "avs_coap_ctx.h"
+
 AVS_UNIT_TEST(udp_observe, start) {
     test_env_t env __attribute__((cleanup(test_teardown_late_expects_check))) =
             test_setup_default();
@@ -1071,5 +1073,51 @@ AVS_UNIT_TEST(udp_observe, cancel_confirmable_notification) {
 #    undef NOTIFY_PAYLOAD
 }
 
+
+static avs_coap_observe_id_t many_observations_id(size_t index) {
+    // mix token lengths to exercise ordering of tokens of different sizes
+    avs_coap_observe_id_t id = {
+        .token = {
+            .size = (uint8_t) (index % 2 ? 2 : 4)
+        }
+    };
+    for (size_t i = 0; i < id.token.size; ++i) {
+        id.token.bytes[id.token.size - 1 - i] = (char) (index >> (8 * i));
+    }
+    return id;
+}
+
+AVS_UNIT_TEST(udp_observe, many_observations) {
+    test_env_t env __attribute__((cleanup(test_teardown))) =
+            test_setup_default();
+
+    enum { OBSERVATIONS_COUNT = 10000 };
+    const avs_coap_request_header_t req = {
+        .code = AVS_COAP_CODE_GET
+    };
+
+    for (size_t i = 0; i < OBSERVATIONS_COUNT; ++i) {
+        ASSERT_OK(avs_coap_observe_start(env.coap_ctx, many_observations_id(i),
+                                         &req, NULL, NULL));
+    }
+    for (size_t i = 0; i < OBSERVATIONS_COUNT; ++i) {
+        avs_coap_observe_id_t id = many_observations_id(i);
+        ASSERT_TRUE(_avs_coap_is_observe(env.coap_ctx, &id.token));
+    }
+
+    // cancel every other observation, starting from the most recent one
+    for (size_t i = OBSERVATIONS_COUNT; i > 0; i -= 2) {
+        ASSERT_OK(avs_coap_observe_cancel(env.coap_ctx,
+                                          many_observations_id(i - 1)));
+    }
+    for (size_t i = 0; i < OBSERVATIONS_COUNT; ++i) {
+        avs_coap_observe_id_t id = many_observations_id(i);
+        ASSERT_EQ(_avs_coap_is_observe(env.coap_ctx, &id.token), i % 2 == 0);
+    }
+    ASSERT_FAIL(avs_coap_observe_cancel(env.coap_ctx, many_observations_id(1)));
+
+    // remaining observations are canceled by cleanup
+}
+
 #endif // defined(AVS_UNIT_TESTING) && defined(WITH_AVS_COAP_UDP) &&
        // defined(WITH_AVS_COAP_OBSERVE)
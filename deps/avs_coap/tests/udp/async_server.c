@@ -267,6 +267,7 @@ AVS_UNIT_TEST(udp_async_server, cached_response) {
     avs_coap_stats_t stats = avs_coap_get_stats(env.coap_ctx);
     ASSERT_EQ(stats.incoming_retransmissions_count, 1);
     ASSERT_EQ(stats.outgoing_retransmissions_count, 0);
+    ASSERT_EQ(stats.incoming_packets_count, 2);
 
     // another duplicated request
     expect_recv(&env, request);
@@ -277,6 +278,7 @@ AVS_UNIT_TEST(udp_async_server, cached_response) {
     stats = avs_coap_get_stats(env.coap_ctx);
     ASSERT_EQ(stats.incoming_retransmissions_count, 2);
     ASSERT_EQ(stats.outgoing_retransmissions_count, 0);
+    ASSERT_EQ(stats.incoming_packets_count, 3);
 
 #    undef PAYLOAD_CONTENT
 }
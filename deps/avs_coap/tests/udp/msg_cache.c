@@ -15,6 +15,7 @@
 
 #    include <avsystem/commons/avs_defs.h>
 #    include <avsystem/commons/avs_memory.h>
+#    include <avsystem/commons/avs_utils.h>
 
 #    include <avsystem/coap/code.h>
 
@@ -424,4 +425,88 @@ AVS_UNIT_TEST(coap_msg_cache, multiple_hosts_same_ids) {
     avs_coap_udp_response_cache_release(&cache);
 }
 
+AVS_UNIT_TEST(coap_msg_cache, many_entries_with_eviction) {
+    static const char *const hosts[] = { "h1", "h2", "h3" };
+    static const uint16_t first_id = 65000;
+    test_udp_msg_t msg __attribute__((cleanup(free_msg))) =
+            setup_msg_with_id(0, "");
+    const size_t entry_size =
+            _avs_coap_udp_response_cache_overhead(&msg.udp_msg)
+            + _avs_coap_udp_msg_size(&msg.udp_msg);
+    // capacity for 100 entries; message IDs wrap around during the test
+    enum {
+        CACHED_ENTRIES = 100,
+        TOTAL_ENTRIES = 1000
+    };
+    avs_coap_udp_response_cache_t *cache =
+            avs_coap_udp_response_cache_create(entry_size * CACHED_ENTRIES);
+
+    for (size_t i = 0; i < TOTAL_ENTRIES; ++i) {
+        const uint16_t id = (uint16_t) (first_id + i / AVS_ARRAY_SIZE(hosts));
+        _avs_coap_udp_header_set_id(&msg.udp_msg.header, id);
+        ASSERT_OK(_avs_coap_udp_response_cache_add(
+                cache, hosts[i % AVS_ARRAY_SIZE(hosts)], "port", &msg.udp_msg,
+                &tx_params));
+    }
+
+    for (size_t i = 0; i < TOTAL_ENTRIES; ++i) {
+        const uint16_t id = (uint16_t) (first_id + i / AVS_ARRAY_SIZE(hosts));
+        avs_coap_udp_cached_response_t cached_msg;
+        avs_error_t err = _avs_coap_udp_response_cache_get(
+                cache, hosts[i % AVS_ARRAY_SIZE(hosts)], "port", id,
+                &cached_msg);
+        if (i < TOTAL_ENTRIES - CACHED_ENTRIES) {
+            ASSERT_FAIL(err);
+        } else {
+            ASSERT_OK(err);
+            ASSERT_EQ(_avs_coap_udp_header_get_id(&cached_msg.msg.header), id);
+        }
+    }
+
+    // unknown endpoint
+    ASSERT_FAIL(_avs_coap_udp_response_cache_get(
+            cache, "h4", "port", first_id,
+            &(avs_coap_udp_cached_response_t) { 0 }));
+
+    avs_coap_udp_response_cache_release(&cache);
+}
+
+AVS_UNIT_TEST(coap_msg_cache, many_endpoints) {
+    static const uint16_t id = 123;
+    test_udp_msg_t msg __attribute__((cleanup(free_msg))) =
+            setup_msg_with_id(id, "");
+    avs_coap_udp_response_cache_t *cache =
+            avs_coap_udp_response_cache_create(65536);
+
+    enum {
+        ENDPOINTS = 100
+    };
+    for (unsigned i = 0; i < ENDPOINTS; ++i) {
+        char port[sizeof("65535")];
+        ASSERT_TRUE(avs_simple_snprintf(port, sizeof(port), "%u", 1000 + i)
+                    >= 0);
+        ASSERT_OK(_avs_coap_udp_response_cache_add(cache, "host", port,
+                                                   &msg.udp_msg, &tx_params));
+    }
+
+    for (unsigned i = 0; i < ENDPOINTS; ++i) {
+        char port[sizeof("65535")];
+        ASSERT_TRUE(avs_simple_snprintf(port, sizeof(port), "%u", 1000 + i)
+                    >= 0);
+        ASSERT_FAIL(_avs_coap_udp_response_cache_add(cache, "host", port,
+                                                     &msg.udp_msg, &tx_params));
+        avs_coap_udp_cached_response_t cached_msg;
+        ASSERT_OK(_avs_coap_udp_response_cache_get(cache, "host", port, id,
+                                                   &cached_msg));
+        assert_udp_msg_equal(msg.udp_msg, cached_msg.msg);
+    }
+
+    // same address and port, split differently
+    ASSERT_FAIL(_avs_coap_udp_response_cache_get(
+            cache, "host1", "000", id,
+            &(avs_coap_udp_cached_response_t) { 0 }));
+
+    avs_coap_udp_response_cache_release(&cache);
+}
+
 #endif // defined(AVS_UNIT_TESTING) && defined(WITH_AVS_COAP_UDP)
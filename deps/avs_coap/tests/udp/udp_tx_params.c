@@ -11,6 +11,8 @@
 
 #if defined(AVS_UNIT_TESTING) && defined(WITH_AVS_COAP_UDP)
 
+#    include <math.h>
+
 #    include <avsystem/coap/udp.h>
 
 #    include <avsystem/commons/avs_unit_mock_helpers.h>
@@ -460,4 +462,237 @@ AVS_UNIT_TEST(udp_tx_params, nstart_decrease) {
     ASSERT_OK(avs_coap_async_handle_incoming_packet(env.coap_ctx, NULL, NULL));
 }
 
+static void assert_duration_ms(avs_time_duration_t actual, double expected_ms) {
+    ASSERT_TRUE(avs_time_duration_valid(actual));
+    ASSERT_TRUE(fabs(avs_time_duration_to_fscalar(actual, AVS_TIME_MS)
+                     - expected_ms)
+                < 1.0);
+}
+
+AVS_UNIT_TEST(udp_tx_params, rtt_estimation) {
+    avs_coap_udp_tx_params_t tx_params = DETERMINISTIC_TX_PARAMS;
+    test_env_t env __attribute__((cleanup(test_teardown))) =
+            test_setup(&tx_params, 4096, 4096, NULL);
+
+    const test_msg_t *requests[] = {
+        COAP_MSG(CON, GET, ID(0), TOKEN(nth_token(0))),
+        COAP_MSG(CON, GET, ID(1), TOKEN(nth_token(1))),
+        COAP_MSG(CON, GET, ID(2), TOKEN(nth_token(2)))
+    };
+    const test_msg_t *responses[] = {
+        COAP_MSG(ACK, CONTENT, ID(0), TOKEN(nth_token(0))),
+        COAP_MSG(ACK, CONTENT, ID(1), TOKEN(nth_token(1)))
+    };
+    avs_coap_exchange_id_t id[3];
+
+    // estimation is disabled by default
+    avs_coap_stats_t stats = avs_coap_get_stats(env.coap_ctx);
+    ASSERT_EQ(stats.overall_rto.seconds, 0);
+    ASSERT_EQ(stats.overall_rto.nanoseconds, 0);
+
+    ASSERT_OK(avs_coap_udp_ctx_set_rtt_estimation(env.coap_ctx, true));
+    stats = avs_coap_get_stats(env.coap_ctx);
+    assert_duration_ms(stats.overall_rto, 2000.0);
+
+    // ACK received after 500 ms, without retransmissions: strong estimator
+    // gets SRTT = 500 ms, RTTVAR = 250 ms, RTO = SRTT + 4 * RTTVAR = 1.5 s;
+    // overall RTO = (1.5 s + 2 s) / 2 = 1.75 s
+    expect_send(&env, requests[0]);
+    ASSERT_OK(avs_coap_client_send_async_request(
+            env.coap_ctx, &id[0], &requests[0]->request_header, NULL, NULL,
+            test_response_handler, &env.expects_list));
+    avs_sched_run(env.sched);
+
+    _avs_mock_clock_advance(avs_time_duration_from_scalar(500, AVS_TIME_MS));
+    expect_recv(&env, responses[0]);
+    expect_handler_call(&env, &id[0], AVS_COAP_CLIENT_REQUEST_OK, responses[0]);
+    expect_has_buffered_data_check(&env, false);
+    ASSERT_OK(avs_coap_async_handle_incoming_packet(env.coap_ctx, NULL, NULL));
+
+    stats = avs_coap_get_stats(env.coap_ctx);
+    ASSERT_EQ(stats.strong_rtt_samples_count, 1);
+    ASSERT_EQ(stats.weak_rtt_samples_count, 0);
+    assert_duration_ms(stats.strong_rto, 1500.0);
+    assert_duration_ms(stats.overall_rto, 1750.0);
+
+    // next request uses the overall RTO as its initial timeout
+    expect_send(&env, requests[1]);
+    ASSERT_OK(avs_coap_client_send_async_request(
+            env.coap_ctx, &id[1], &requests[1]->request_header, NULL, NULL,
+            test_response_handler, &env.expects_list));
+    avs_sched_run(env.sched);
+    assert_duration_ms(avs_sched_time_to_next(env.sched), 1750.0);
+
+    _avs_mock_clock_advance(avs_sched_time_to_next(env.sched));
+    expect_send(&env, requests[1]);
+    avs_sched_run(env.sched);
+
+    // ACK received 2 s after the initial transmission, after one
+    // retransmission: weak estimator gets SRTT = 2 s, RTTVAR = 1 s,
+    // RTO = SRTT + RTTVAR = 3 s; overall RTO = 3 s / 4 + 1.75 s * 3 / 4
+    _avs_mock_clock_advance(avs_time_duration_from_scalar(250, AVS_TIME_MS));
+    expect_recv(&env, responses[1]);
+    expect_handler_call(&env, &id[1], AVS_COAP_CLIENT_REQUEST_OK, responses[1]);
+    expect_has_buffered_data_check(&env, false);
+    ASSERT_OK(avs_coap_async_handle_incoming_packet(env.coap_ctx, NULL, NULL));
+
+    stats = avs_coap_get_stats(env.coap_ctx);
+    ASSERT_EQ(stats.strong_rtt_samples_count, 1);
+    ASSERT_EQ(stats.weak_rtt_samples_count, 1);
+    assert_duration_ms(stats.weak_rto, 3000.0);
+    assert_duration_ms(stats.overall_rto, 2062.5);
+
+    expect_send(&env, requests[2]);
+    ASSERT_OK(avs_coap_client_send_async_request(
+            env.coap_ctx, &id[2], &requests[2]->request_header, NULL, NULL,
+            test_response_handler, &env.expects_list));
+    avs_sched_run(env.sched);
+    assert_duration_ms(avs_sched_time_to_next(env.sched), 2062.5);
+
+    // disabling the estimation restores static timeouts for new messages
+    ASSERT_OK(avs_coap_udp_ctx_set_rtt_estimation(env.coap_ctx, false));
+    stats = avs_coap_get_stats(env.coap_ctx);
+    ASSERT_EQ(stats.strong_rtt_samples_count, 0);
+    ASSERT_EQ(stats.overall_rto.seconds, 0);
+
+    expect_handler_call(&env, &id[2], AVS_COAP_CLIENT_REQUEST_CANCEL, NULL);
+    avs_coap_exchange_cancel(env.coap_ctx, id[2]);
+}
+
+AVS_UNIT_TEST(udp_tx_params, rtt_estimation_aging) {
+    avs_coap_udp_tx_params_t tx_params = DETERMINISTIC_TX_PARAMS;
+    test_env_t env __attribute__((cleanup(test_teardown))) =
+            test_setup(&tx_params, 4096, 4096, NULL);
+
+    const test_msg_t *requests[] = {
+        COAP_MSG(CON, GET, ID(0), TOKEN(nth_token(0))),
+        COAP_MSG(CON, GET, ID(1), TOKEN(nth_token(1))),
+        COAP_MSG(CON, GET, ID(2), TOKEN(nth_token(2)))
+    };
+    const test_msg_t *responses[] = {
+        COAP_MSG(ACK, CONTENT, ID(0), TOKEN(nth_token(0))),
+        COAP_MSG(ACK, CONTENT, ID(1), TOKEN(nth_token(1)))
+    };
+    avs_coap_exchange_id_t id[3];
+
+    ASSERT_OK(avs_coap_udp_ctx_set_rtt_estimation(env.coap_ctx, true));
+
+    // two RTT samples of 40 ms each:
+    // - strong RTO = 40 ms + 4 * 20 ms = 120 ms,
+    //   overall RTO = (120 ms + 2 s) / 2 = 1.06 s
+    // - strong RTO = 40 ms + 4 * 15 ms = 100 ms,
+    //   overall RTO = (100 ms + 1.06 s) / 2 = 580 ms
+    for (size_t i = 0; i < 2; ++i) {
+        expect_send(&env, requests[i]);
+        ASSERT_OK(avs_coap_client_send_async_request(
+                env.coap_ctx, &id[i], &requests[i]->request_header, NULL,
+                NULL, test_response_handler, &env.expects_list));
+        avs_sched_run(env.sched);
+
+        _avs_mock_clock_advance(avs_time_duration_from_scalar(40, AVS_TIME_MS));
+        expect_recv(&env, responses[i]);
+        expect_handler_call(&env, &id[i], AVS_COAP_CLIENT_REQUEST_OK,
+                            responses[i]);
+        expect_has_buffered_data_check(&env, false);
+        ASSERT_OK(avs_coap_async_handle_incoming_packet(env.coap_ctx, NULL,
+                                                        NULL));
+    }
+
+    avs_coap_stats_t stats = avs_coap_get_stats(env.coap_ctx);
+    assert_duration_ms(stats.strong_rto, 100.0);
+    assert_duration_ms(stats.overall_rto, 580.0);
+
+    // RTO below 1 s not updated for 16 * RTO gets doubled
+    _avs_mock_clock_advance(avs_time_duration_from_scalar(10, AVS_TIME_S));
+    expect_send(&env, requests[2]);
+    ASSERT_OK(avs_coap_client_send_async_request(
+            env.coap_ctx, &id[2], &requests[2]->request_header, NULL, NULL,
+            test_response_handler, &env.expects_list));
+    avs_sched_run(env.sched);
+    assert_duration_ms(avs_sched_time_to_next(env.sched), 1160.0);
+
+    stats = avs_coap_get_stats(env.coap_ctx);
+    assert_duration_ms(stats.overall_rto, 1160.0);
+
+    expect_handler_call(&env, &id[2], AVS_COAP_CLIENT_REQUEST_CANCEL, NULL);
+    avs_coap_exchange_cancel(env.coap_ctx, id[2]);
+}
+
+AVS_UNIT_TEST(udp_tx_params, congestion_control) {
+    avs_coap_udp_tx_params_t tx_params = {
+        .ack_timeout = avs_time_duration_from_scalar(10, AVS_TIME_S),
+        .ack_random_factor = 1.0,
+        .max_retransmit = 1,
+        .nstart = 1
+    };
+    test_env_t env __attribute__((cleanup(test_teardown))) =
+            test_setup(&tx_params, 4096, 4096, NULL);
+
+    const test_msg_t *requests[] = {
+        COAP_MSG(CON, GET, ID(0), TOKEN(nth_token(0))),
+        COAP_MSG(CON, GET, ID(1), TOKEN(nth_token(1))),
+        COAP_MSG(CON, GET, ID(2), TOKEN(nth_token(2))),
+        COAP_MSG(CON, GET, ID(3), TOKEN(nth_token(3)))
+    };
+    const test_msg_t *responses[] = {
+        COAP_MSG(ACK, CONTENT, ID(0), TOKEN(nth_token(0))),
+        COAP_MSG(ACK, CONTENT, ID(1), TOKEN(nth_token(1))),
+        COAP_MSG(ACK, CONTENT, ID(2), TOKEN(nth_token(2)))
+    };
+    avs_coap_exchange_id_t id[4];
+
+    ASSERT_OK(avs_coap_udp_ctx_set_congestion_control(env.coap_ctx, 4));
+    ASSERT_EQ(avs_coap_get_stats(env.coap_ctx).congestion_window, 1);
+
+    // window of 1: only the first request is sent
+    expect_send(&env, requests[0]);
+    for (size_t i = 0; i < 3; ++i) {
+        ASSERT_OK(avs_coap_client_send_async_request(
+                env.coap_ctx, &id[i], &requests[i]->request_header, NULL,
+                NULL, test_response_handler, &env.expects_list));
+    }
+    avs_sched_run(env.sched);
+
+    // clean ACK grows the window to 2, so both held requests are sent
+    expect_recv(&env, responses[0]);
+    expect_handler_call(&env, &id[0], AVS_COAP_CLIENT_REQUEST_OK, responses[0]);
+    expect_has_buffered_data_check(&env, false);
+    ASSERT_OK(avs_coap_async_handle_incoming_packet(env.coap_ctx, NULL, NULL));
+    ASSERT_EQ(avs_coap_get_stats(env.coap_ctx).congestion_window, 2);
+
+    expect_send(&env, requests[1]);
+    expect_send(&env, requests[2]);
+    avs_sched_run(env.sched);
+
+    // two more clean ACKs are needed to grow the window to 3
+    for (size_t i = 1; i < 3; ++i) {
+        expect_recv(&env, responses[i]);
+        expect_handler_call(&env, &id[i], AVS_COAP_CLIENT_REQUEST_OK,
+                            responses[i]);
+        expect_has_buffered_data_check(&env, false);
+        ASSERT_OK(avs_coap_async_handle_incoming_packet(env.coap_ctx, NULL,
+                                                        NULL));
+    }
+    ASSERT_EQ(avs_coap_get_stats(env.coap_ctx).congestion_window, 3);
+
+    // retransmission halves the window
+    expect_send(&env, requests[3]);
+    ASSERT_OK(avs_coap_client_send_async_request(
+            env.coap_ctx, &id[3], &requests[3]->request_header, NULL, NULL,
+            test_response_handler, &env.expects_list));
+    avs_sched_run(env.sched);
+
+    _avs_mock_clock_advance(avs_sched_time_to_next(env.sched));
+    expect_send(&env, requests[3]);
+    avs_sched_run(env.sched);
+    ASSERT_EQ(avs_coap_get_stats(env.coap_ctx).congestion_window, 1);
+
+    // disabling congestion control goes back to fixed NSTART
+    ASSERT_OK(avs_coap_udp_ctx_set_congestion_control(env.coap_ctx, 0));
+    ASSERT_EQ(avs_coap_get_stats(env.coap_ctx).congestion_window, 0);
+
+    expect_handler_call(&env, &id[3], AVS_COAP_CLIENT_REQUEST_CANCEL, NULL);
+    avs_coap_exchange_cancel(env.coap_ctx, id[3]);
+}
+
 #endif // defined(AVS_UNIT_TESTING) && defined(WITH_AVS_COAP_UDP)
@@ -195,6 +195,24 @@
  */
 #define ANJAY_WITH_EVENT_LOOP
 
+/**
+ * Use the Linux <c>epoll()</c> API instead of <c>poll()</c> or
+ * <c>select()</c> in <c>anjay_event_loop_run()</c> and
+ * <c>anjay_event_loop_run_with_error_handling()</c>.
+ *
+ * The epoll instance is kept for the whole lifetime of the event loop, and
+ * sockets are registered with it only when they appear, change or disappear,
+ * instead of passing the whole descriptor set to the kernel in each iteration.
+ * This is beneficial when a large number of servers or downloads are handled
+ * at the same time. <c>anjay_serve_any()</c> is not affected, as setting up
+ * an epoll instance for a single wait would be more expensive than a single
+ * <c>poll()</c> call.
+ *
+ * Requires @ref ANJAY_WITH_EVENT_LOOP to be enabled, and a platform that
+ * provides <c>sys/epoll.h</c>.
+ */
+/* #undef ANJAY_WITH_EVENT_LOOP_EPOLL */
+
 /**
  * Enable support for features new to LwM2M protocol version 1.1.
  */
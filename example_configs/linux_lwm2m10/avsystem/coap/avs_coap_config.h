@@ -38,6 +38,8 @@
  * - @c avs_stream
  * - @c avs_utils
  * - @c avs_log (if @c WITH_AVS_COAP_LOGS is enabled)
+ * - @c avs_rbtree or @c avs_sorted_set (if @c WITH_AVS_COAP_OBSERVE is
+ *   enabled)
  * - @c avs_persistence (if @c WITH_AVS_COAP_OBSERVE_PERSISTENCE is enabled)
  * - @c avs_crypto (if @c WITH_AVS_COAP_OSCORE is enabled)
  *
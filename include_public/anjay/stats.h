@@ -46,6 +46,28 @@ uint64_t anjay_get_num_incoming_retransmissions(anjay_t *anjay);
  */
 uint64_t anjay_get_num_outgoing_retransmissions(anjay_t *anjay);
 
+/**
+ * @returns the number of packets received by the client over CoAP/UDP,
+ *          including retransmissions.
+ *
+ * NOTE: When ANJAY_WITH_NET_STATS is disabled this function always returns 0.
+ */
+uint64_t anjay_get_num_incoming_packets(anjay_t *anjay);
+
+/**
+ * @returns the number of times a CoAP/UDP socket of an LwM2M Server connection
+ *          has been served with @ref anjay_serve (either directly or by the
+ *          event loop). Each such call receives all packets queued on the
+ *          socket, so <c>anjay_get_num_incoming_packets(anjay) /
+ *          anjay_get_num_serve_calls(anjay)</c> is the average number of
+ *          packets handled per socket wakeup. Serving CoAP/TCP or SMS sockets
+ *          is not counted, as packets received over them are not counted by
+ *          @ref anjay_get_num_incoming_packets either.
+ *
+ * NOTE: When ANJAY_WITH_NET_STATS is disabled this function always returns 0.
+ */
+uint64_t anjay_get_num_serve_calls(anjay_t *anjay);
+
 #ifdef __cplusplus
 } /* extern "C" */
 #endif
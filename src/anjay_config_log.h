@@ -151,6 +151,11 @@ static inline void _anjay_log_feature_list(void) {
 #else // ANJAY_WITH_EVENT_LOOP
     _anjay_log(anjay, TRACE, "ANJAY_WITH_EVENT_LOOP = OFF");
 #endif // ANJAY_WITH_EVENT_LOOP
+#ifdef ANJAY_WITH_EVENT_LOOP_EPOLL
+    _anjay_log(anjay, TRACE, "ANJAY_WITH_EVENT_LOOP_EPOLL = ON");
+#else // ANJAY_WITH_EVENT_LOOP_EPOLL
+    _anjay_log(anjay, TRACE, "ANJAY_WITH_EVENT_LOOP_EPOLL = OFF");
+#endif // ANJAY_WITH_EVENT_LOOP_EPOLL
 #ifdef ANJAY_WITH_HTTP_DOWNLOAD
     _anjay_log(anjay, TRACE, "ANJAY_WITH_HTTP_DOWNLOAD = ON");
 #else // ANJAY_WITH_HTTP_DOWNLOAD
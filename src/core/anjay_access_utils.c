@@ -10,6 +10,7 @@
 #include <anjay_init.h>
 
 #include <inttypes.h>
+#include <string.h>
 
 #include <anjay_modules/anjay_access_utils.h>
 #include <anjay_modules/anjay_dm_utils.h>
@@ -186,6 +187,62 @@ static int foreach_acl(anjay_unlocked_t *anjay,
     return result;
 }
 
+typedef struct {
+    anjay_ssid_t ssid;
+    anjay_access_mask_t mask;
+} acl_entry_t;
+
+static int read_acl_clb(anjay_unlocked_t *anjay,
+                        const anjay_dm_installed_object_t *obj,
+                        anjay_iid_t iid,
+                        anjay_rid_t rid,
+                        anjay_riid_t riid,
+                        void *endptr_ptr_) {
+    AVS_LIST(acl_entry_t) **endptr_ptr = (AVS_LIST(acl_entry_t) **) endptr_ptr_;
+    assert(!**endptr_ptr);
+    if (!(**endptr_ptr = AVS_LIST_NEW_ELEMENT(acl_entry_t))) {
+        return -1;
+    }
+    (**endptr_ptr)->ssid = riid;
+    int result = read_mask(anjay, obj, iid, rid, riid, &(**endptr_ptr)->mask);
+    if (result) {
+        AVS_LIST_DELETE(*endptr_ptr);
+    } else {
+        AVS_LIST_ADVANCE_PTR(endptr_ptr);
+    }
+    return result;
+}
+
+static int read_acl(anjay_unlocked_t *anjay,
+                    const anjay_dm_installed_object_t *ac_obj,
+                    anjay_iid_t ac_iid,
+                    AVS_LIST(acl_entry_t) *out_acl) {
+    assert(out_acl);
+    assert(!*out_acl);
+    AVS_LIST(acl_entry_t) *endptr = out_acl;
+    int result = foreach_acl(anjay, ac_obj, ac_iid, read_acl_clb, &endptr);
+    if (result) {
+        AVS_LIST_CLEAR(out_acl);
+    }
+    return result;
+}
+
+static const anjay_notify_queue_object_entry_t *
+get_ac_notif_entry(anjay_notify_queue_t queue) {
+    AVS_LIST(anjay_notify_queue_object_entry_t) it;
+    AVS_LIST_FOREACH(it, queue) {
+        // Queue entries are sorted by OID, compare with
+        // find_or_create_object_entry() in notify.c
+        if (it->oid >= ANJAY_DM_OID_ACCESS_CONTROL) {
+            break;
+        }
+    }
+    if (it && it->oid == ANJAY_DM_OID_ACCESS_CONTROL) {
+        return it;
+    }
+    return NULL;
+}
+
 typedef struct {
     anjay_iid_t ac_iid;
     anjay_oid_t target_oid;
@@ -261,6 +318,315 @@ static int get_mask(anjay_unlocked_t *anjay,
     return 0;
 }
 
+/**
+ * The Access Control index is an in-memory copy of (Target OID, Target IID,
+ * Owner, ACL) of every Access Control object instance, so that
+ * access_control_mask() does not need to iterate over the whole Access Control
+ * object on every request.
+ *
+ * It is rebuilt from the data model lazily, on first use after being
+ * invalidated, and updated incrementally by _anjay_sync_access_control() when
+ * only Resources of existing Access Control instances have changed. Any change
+ * to the set of Access Control instances invalidates it as a whole.
+ *
+ * Between a modification of the Access Control object and processing of the
+ * corresponding notifications, the index is not used and ACL checks are
+ * performed directly on the data model, as they were before. Rolling back a
+ * transaction on the Access Control object invalidates the index.
+ */
+struct anjay_ac_index_entry_struct {
+    const anjay_iid_t ac_iid;
+    anjay_oid_t target_oid;
+    anjay_iid_t target_iid;
+    anjay_ssid_t owner;
+    AVS_LIST(acl_entry_t) acl;
+};
+
+struct anjay_ac_index_target_struct {
+    const anjay_oid_t oid;
+    const anjay_iid_t iid;
+    /**
+     * Access Control instance with the lowest IID among those that refer to
+     * this target - i.e., the one find_ac_instance_by_target() would find.
+     */
+    anjay_ac_index_entry_t *entry;
+    size_t refcnt;
+};
+
+static int ac_index_entry_cmp(const void *left, const void *right) {
+    return (int) ((const anjay_ac_index_entry_t *) left)->ac_iid
+           - (int) ((const anjay_ac_index_entry_t *) right)->ac_iid;
+}
+
+static int ac_index_target_cmp(const void *left_, const void *right_) {
+    const anjay_ac_index_target_t *left =
+            (const anjay_ac_index_target_t *) left_;
+    const anjay_ac_index_target_t *right =
+            (const anjay_ac_index_target_t *) right_;
+    int result = (int) left->oid - (int) right->oid;
+    if (!result) {
+        result = (int) left->iid - (int) right->iid;
+    }
+    return result;
+}
+
+static inline const anjay_ac_index_entry_t *
+ac_index_entry_query(const anjay_iid_t *ac_iid) {
+    return AVS_CONTAINER_OF(ac_iid, anjay_ac_index_entry_t, ac_iid);
+}
+
+void _anjay_access_control_index_cleanup(anjay_access_control_index_t *index) {
+    if (index->targets) {
+        AVS_SORTED_SET_DELETE(&index->targets);
+    }
+    if (index->instances) {
+        AVS_SORTED_SET_DELETE(&index->instances) {
+            AVS_LIST_CLEAR(&(*index->instances)->acl);
+        }
+    }
+    index->valid = false;
+    index->rebuild_failed = false;
+}
+
+void _anjay_access_control_index_object_modified(
+        anjay_unlocked_t *anjay, const anjay_dm_installed_object_t *obj_ptr) {
+    if (_anjay_dm_installed_object_oid(obj_ptr) == ANJAY_DM_OID_ACCESS_CONTROL
+            && obj_ptr == get_access_control(anjay)) {
+        anjay->access_control_index.sync_pending = true;
+    }
+}
+
+void _anjay_access_control_index_object_rolled_back(
+        anjay_unlocked_t *anjay, const anjay_dm_installed_object_t *obj_ptr) {
+    if (_anjay_dm_installed_object_oid(obj_ptr) == ANJAY_DM_OID_ACCESS_CONTROL
+            && obj_ptr == get_access_control(anjay)) {
+        // the index might have already been updated with changes that are
+        // now being reverted
+        _anjay_access_control_index_cleanup(&anjay->access_control_index);
+    }
+}
+
+static void
+ac_index_remove_entry(anjay_access_control_index_t *index,
+                      AVS_SORTED_SET_ELEM(anjay_ac_index_entry_t) entry) {
+    const anjay_ac_index_target_t query = {
+        .oid = entry->target_oid,
+        .iid = entry->target_iid
+    };
+    AVS_SORTED_SET_ELEM(anjay_ac_index_target_t) target =
+            AVS_SORTED_SET_FIND(index->targets, &query);
+    assert(target);
+    if (!--target->refcnt) {
+        AVS_SORTED_SET_DELETE_ELEM(index->targets, &target);
+    } else if (target->entry == entry) {
+        // Another Access Control instance refers to the same target; the one
+        // with the lowest IID takes over.
+        target->entry = NULL;
+        AVS_SORTED_SET_ELEM(anjay_ac_index_entry_t) it;
+        AVS_SORTED_SET_FOREACH(it, index->instances) {
+            if (it != entry && it->target_oid == entry->target_oid
+                    && it->target_iid == entry->target_iid) {
+                target->entry = it;
+                break;
+            }
+        }
+        assert(target->entry);
+    }
+    AVS_LIST_CLEAR(&entry->acl);
+    AVS_SORTED_SET_DELETE_ELEM(index->instances, &entry);
+}
+
+static int ac_index_add_entry(anjay_unlocked_t *anjay,
+                              const anjay_dm_installed_object_t *ac_obj,
+                              anjay_iid_t ac_iid) {
+    anjay_access_control_index_t *index = &anjay->access_control_index;
+    assert(!AVS_SORTED_SET_FIND(index->instances,
+                                ac_index_entry_query(&ac_iid)));
+    AVS_SORTED_SET_ELEM(anjay_ac_index_entry_t) entry =
+            AVS_SORTED_SET_ELEM_NEW(anjay_ac_index_entry_t);
+    if (!entry) {
+        _anjay_log_oom();
+        return -1;
+    }
+    memcpy((void *) (intptr_t) (const void *) &entry->ac_iid, &ac_iid,
+           sizeof(ac_iid));
+    int result;
+    if ((result = read_ids_from_ac_instance(anjay, ac_iid, &entry->target_oid,
+                                            &entry->target_iid, &entry->owner))
+            || (result = read_acl(anjay, ac_obj, ac_iid, &entry->acl))) {
+        AVS_SORTED_SET_ELEM_DELETE_DETACHED(&entry);
+        return result;
+    }
+
+    const anjay_ac_index_target_t query = {
+        .oid = entry->target_oid,
+        .iid = entry->target_iid
+    };
+    AVS_SORTED_SET_ELEM(anjay_ac_index_target_t) target =
+            AVS_SORTED_SET_FIND(index->targets, &query);
+    if (!target) {
+        if (!(target = AVS_SORTED_SET_ELEM_NEW(anjay_ac_index_target_t))) {
+            _anjay_log_oom();
+            AVS_LIST_CLEAR(&entry->acl);
+            AVS_SORTED_SET_ELEM_DELETE_DETACHED(&entry);
+            return -1;
+        }
+        memcpy((void *) (intptr_t) (const void *) target, &query,
+               sizeof(query));
+        AVS_SORTED_SET_INSERT(index->targets, target);
+    }
+    AVS_SORTED_SET_INSERT(index->instances, entry);
+    ++target->refcnt;
+    if (!target->entry || target->entry->ac_iid > ac_iid) {
+        target->entry = entry;
+    }
+    return 0;
+}
+
+static int ac_index_add_entry_clb(anjay_unlocked_t *anjay,
+                                  const anjay_dm_installed_object_t *ac_obj,
+                                  anjay_iid_t ac_iid,
+                                  void *dummy) {
+    (void) dummy;
+    return ac_index_add_entry(anjay, ac_obj, ac_iid);
+}
+
+static int ac_index_rebuild(anjay_unlocked_t *anjay,
+                            const anjay_dm_installed_object_t *ac_obj) {
+    anjay_access_control_index_t *index = &anjay->access_control_index;
+    _anjay_access_control_index_cleanup(index);
+    if (!(index->instances = AVS_SORTED_SET_NEW(anjay_ac_index_entry_t,
+                                                ac_index_entry_cmp))
+            || !(index->targets = AVS_SORTED_SET_NEW(anjay_ac_index_target_t,
+                                                     ac_index_target_cmp))) {
+        _anjay_log_oom();
+        _anjay_access_control_index_cleanup(index);
+        index->rebuild_failed = true;
+        return -1;
+    }
+    int result = _anjay_dm_foreach_instance(anjay, ac_obj,
+                                            ac_index_add_entry_clb, NULL);
+    if (result) {
+        anjay_log(DEBUG, _("could not build Access Control index: ") "%d",
+                  result);
+        _anjay_access_control_index_cleanup(index);
+        index->rebuild_failed = true;
+        return result;
+    }
+    index->valid = true;
+    return 0;
+}
+
+/**
+ * Looks up the Access Control instance referring to the given target in the
+ * index, rebuilding it if necessary. On success, <c>*out_entry</c> is set to
+ * NULL if there is no such instance.
+ *
+ * Returns a non-zero value if the index cannot be used at the moment; the data
+ * model shall be queried directly in that case.
+ */
+static int ac_index_find(anjay_unlocked_t *anjay,
+                         const anjay_dm_installed_object_t *ac_obj,
+                         anjay_oid_t oid,
+                         anjay_iid_t iid,
+                         const anjay_ac_index_entry_t **out_entry) {
+    anjay_access_control_index_t *index = &anjay->access_control_index;
+    if (index->sync_pending
+            || get_ac_notif_entry(anjay->scheduled_notify.queue)) {
+        // there are changes that are not yet reflected in the index
+        return -1;
+    }
+    if (index->rebuild_failed) {
+        // retrying would most likely fail again, doubling the cost of each
+        // lookup - wait until the Access Control object changes
+        return -1;
+    }
+    int result;
+    if (!index->valid && (result = ac_index_rebuild(anjay, ac_obj))) {
+        return result;
+    }
+    const anjay_ac_index_target_t query = {
+        .oid = oid,
+        .iid = iid
+    };
+    AVS_SORTED_SET_ELEM(anjay_ac_index_target_t) target =
+            AVS_SORTED_SET_FIND(index->targets, &query);
+    *out_entry = target ? target->entry : NULL;
+    return 0;
+}
+
+/**
+ * Equivalent of the get_mask() and owner logic of access_control_mask(),
+ * performed on an index entry.
+ */
+static anjay_access_mask_t
+ac_index_entry_mask(const anjay_ac_index_entry_t *entry, anjay_ssid_t ssid) {
+    if (!entry->acl) {
+        return entry->owner == ssid
+                       ? (ANJAY_ACCESS_MASK_FULL & ~ANJAY_ACCESS_MASK_CREATE)
+                       : ANJAY_ACCESS_MASK_NONE;
+    }
+    anjay_access_mask_t default_mask = ANJAY_ACCESS_MASK_NONE;
+    AVS_LIST(const acl_entry_t) it;
+    AVS_LIST_FOREACH(it, entry->acl) {
+        if (it->ssid == ssid) {
+            return it->mask;
+        } else if (!it->ssid) {
+            default_mask = it->mask;
+        }
+    }
+    return default_mask;
+}
+
+/**
+ * Applies changes to the Access Control object listed in @p queue to the index.
+ */
+static void ac_index_sync(anjay_unlocked_t *anjay,
+                          const anjay_dm_installed_object_t *ac_obj,
+                          anjay_notify_queue_t queue) {
+    anjay_access_control_index_t *index = &anjay->access_control_index;
+    const bool sync_pending = index->sync_pending;
+    index->sync_pending = false;
+    const anjay_notify_queue_object_entry_t *ac_notif =
+            get_ac_notif_entry(queue);
+    if (sync_pending || ac_notif) {
+        index->rebuild_failed = false;
+    }
+    if (!index->valid) {
+        return;
+    }
+    if (!ac_notif) {
+        if (sync_pending) {
+            // modified, but the changes have not been reported
+            _anjay_access_control_index_cleanup(index);
+        }
+        return;
+    }
+    if (ac_notif->instance_set_changes.instance_set_changed) {
+        _anjay_access_control_index_cleanup(index);
+        return;
+    }
+    anjay_iid_t last_iid = ANJAY_ID_INVALID;
+    AVS_LIST(anjay_notify_queue_resource_entry_t) it;
+    AVS_LIST_FOREACH(it, ac_notif->resources_changed) {
+        // Resource entries are sorted lexicographically over (IID, RID) pairs
+        if (it->iid == last_iid) {
+            continue;
+        }
+        last_iid = it->iid;
+        AVS_SORTED_SET_ELEM(anjay_ac_index_entry_t) entry =
+                AVS_SORTED_SET_FIND(index->instances,
+                                    ac_index_entry_query(&it->iid));
+        if (entry) {
+            ac_index_remove_entry(index, entry);
+        }
+        if (ac_index_add_entry(anjay, ac_obj, it->iid)) {
+            _anjay_access_control_index_cleanup(index);
+            return;
+        }
+    }
+}
+
 static anjay_access_mask_t access_control_mask(anjay_unlocked_t *anjay,
                                                anjay_oid_t oid,
                                                anjay_iid_t iid,
@@ -268,9 +634,17 @@ static anjay_access_mask_t access_control_mask(anjay_unlocked_t *anjay,
     const anjay_dm_installed_object_t *ac_obj =
             _anjay_dm_find_object_by_oid(&anjay->dm,
                                          ANJAY_DM_OID_ACCESS_CONTROL);
+    if (!ac_obj) {
+        return ANJAY_ACCESS_MASK_NONE;
+    }
+    const anjay_ac_index_entry_t *entry;
+    if (!ac_index_find(anjay, ac_obj, oid, iid, &entry)) {
+        return entry ? ac_index_entry_mask(entry, ssid)
+                     : ANJAY_ACCESS_MASK_NONE;
+    }
+
     anjay_iid_t ac_iid;
-    if (!ac_obj
-            || find_ac_instance_by_target(anjay, ac_obj, &ac_iid, oid, iid)) {
+    if (find_ac_instance_by_target(anjay, ac_obj, &ac_iid, oid, iid)) {
         return ANJAY_ACCESS_MASK_NONE;
     }
 
@@ -519,46 +893,6 @@ enumerate_valid_ssids_clb(anjay_unlocked_t *anjay,
     return 0;
 }
 
-typedef struct {
-    anjay_ssid_t ssid;
-    anjay_access_mask_t mask;
-} acl_entry_t;
-
-static int read_acl_clb(anjay_unlocked_t *anjay,
-                        const anjay_dm_installed_object_t *obj,
-                        anjay_iid_t iid,
-                        anjay_rid_t rid,
-                        anjay_riid_t riid,
-                        void *endptr_ptr_) {
-    AVS_LIST(acl_entry_t) **endptr_ptr = (AVS_LIST(acl_entry_t) **) endptr_ptr_;
-    assert(!**endptr_ptr);
-    if (!(**endptr_ptr = AVS_LIST_NEW_ELEMENT(acl_entry_t))) {
-        return -1;
-    }
-    (**endptr_ptr)->ssid = riid;
-    int result = read_mask(anjay, obj, iid, rid, riid, &(**endptr_ptr)->mask);
-    if (result) {
-        AVS_LIST_DELETE(*endptr_ptr);
-    } else {
-        AVS_LIST_ADVANCE_PTR(endptr_ptr);
-    }
-    return result;
-}
-
-static int read_acl(anjay_unlocked_t *anjay,
-                    const anjay_dm_installed_object_t *ac_obj,
-                    anjay_iid_t ac_iid,
-                    AVS_LIST(acl_entry_t) *out_acl) {
-    assert(out_acl);
-    assert(!*out_acl);
-    AVS_LIST(acl_entry_t) *endptr = out_acl;
-    int result = foreach_acl(anjay, ac_obj, ac_iid, read_acl_clb, &endptr);
-    if (result) {
-        AVS_LIST_CLEAR(out_acl);
-    }
-    return result;
-}
-
 /**
  * Finds the server that will become the new owner of the given ACL.
  * Servers with both Write and Delete rights are ranked with value 2, those with
@@ -1057,22 +1391,6 @@ static int perform_adds(anjay_unlocked_t *anjay,
     return 0;
 }
 
-static const anjay_notify_queue_object_entry_t *
-get_ac_notif_entry(anjay_notify_queue_t queue) {
-    AVS_LIST(anjay_notify_queue_object_entry_t) it;
-    AVS_LIST_FOREACH(it, queue) {
-        // Queue entries are sorted by OID, compare with
-        // find_or_create_object_entry() in notify.c
-        if (it->oid >= ANJAY_DM_OID_ACCESS_CONTROL) {
-            break;
-        }
-    }
-    if (it && it->oid == ANJAY_DM_OID_ACCESS_CONTROL) {
-        return it;
-    }
-    return NULL;
-}
-
 /**
  * This function does not check LwM2M Gateway related prefix in
  * new_notifications_queue because it only processes entries with
@@ -1148,7 +1466,9 @@ int _anjay_sync_access_control(anjay_unlocked_t *anjay,
         result = generate_apparent_instance_set_change_notifications(
                 anjay, notifications_queue);
     }
-    return _anjay_dm_transaction_finish(anjay, result);
+    result = _anjay_dm_transaction_finish(anjay, result);
+    ac_index_sync(anjay, ac_obj, *notifications_queue);
+    return result;
 #endif // ANJAY_WITH_ACCESS_CONTROL
 }
 
@@ -74,6 +74,31 @@ _anjay_instance_action_allowed_stateless(anjay_unlocked_t *anjay,
  */
 bool _anjay_instance_action_allowed_by_acl(anjay_unlocked_t *anjay,
                                            const anjay_action_info_t *info);
+
+/**
+ * Marks the Access Control index as out of date if @p obj_ptr is the Access
+ * Control object. Called whenever an object is about to be modified through
+ * the data model; the index is not used for ACL checks until the changes are
+ * processed by @ref _anjay_sync_access_control.
+ */
+void _anjay_access_control_index_object_modified(
+        anjay_unlocked_t *anjay, const anjay_dm_installed_object_t *obj_ptr);
+
+/**
+ * Drops the Access Control index if @p obj_ptr is the Access Control object.
+ * Called whenever a transaction on an object is rolled back.
+ */
+void _anjay_access_control_index_object_rolled_back(
+        anjay_unlocked_t *anjay, const anjay_dm_installed_object_t *obj_ptr);
+
+/**
+ * Drops all contents of the Access Control index and marks it invalid, so that
+ * it will be rebuilt from the data model on next use.
+ */
+void _anjay_access_control_index_cleanup(anjay_access_control_index_t *index);
+#else  // ANJAY_WITH_ACCESS_CONTROL
+#    define _anjay_access_control_index_object_modified(...) ((void) 0)
+#    define _anjay_access_control_index_object_rolled_back(...) ((void) 0)
 #endif // ANJAY_WITH_ACCESS_CONTROL
 
 /**
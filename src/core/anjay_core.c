@@ -35,6 +35,7 @@
 #include "coap/anjay_content_format.h"
 #include "coap/anjay_msg_details.h"
 
+#include "anjay_access_utils_private.h"
 #include "anjay_bootstrap_core.h"
 #include "anjay_dm_core.h"
 #include "anjay_downloader.h"
@@ -401,6 +402,9 @@ static void anjay_cleanup_impl(anjay_unlocked_t *anjay, bool deregister) {
 #ifdef ANJAY_WITH_ATTR_STORAGE
     _anjay_attr_storage_cleanup(&anjay->attr_storage);
 #endif // ANJAY_WITH_ATTR_STORAGE
+#ifdef ANJAY_WITH_ACCESS_CONTROL
+    _anjay_access_control_index_cleanup(&anjay->access_control_index);
+#endif // ANJAY_WITH_ACCESS_CONTROL
     _anjay_dm_cleanup(&anjay->dm);
     _anjay_notify_clear_queue(&anjay->scheduled_notify.queue);
 
@@ -1196,6 +1200,13 @@ int _anjay_serve_unlocked(anjay_unlocked_t *anjay,
     if (!connection.server) {
         return -1;
     }
+#ifdef ANJAY_WITH_NET_STATS
+    // only CoAP/UDP contexts count incoming packets
+    if (_anjay_connection_transport(connection)
+            == ANJAY_SOCKET_TRANSPORT_UDP) {
+        ++anjay->serve_count;
+    }
+#endif // ANJAY_WITH_NET_STATS
     return serve_connection(connection);
 }
 
@@ -15,6 +15,7 @@
 #include <avsystem/commons/avs_net.h>
 #include <avsystem/commons/avs_prng.h>
 #include <avsystem/commons/avs_shared_buffer.h>
+#include <avsystem/commons/avs_sorted_set.h>
 #include <avsystem/commons/avs_stream.h>
 
 #include <avsystem/coap/udp.h>
@@ -42,6 +43,33 @@ typedef struct {
     avs_sched_handle_t handle;
 } anjay_scheduled_notify_t;
 
+#ifdef ANJAY_WITH_ACCESS_CONTROL
+typedef struct anjay_ac_index_entry_struct anjay_ac_index_entry_t;
+typedef struct anjay_ac_index_target_struct anjay_ac_index_target_t;
+
+/**
+ * In-memory copy of the Access Control object contents, used to answer ACL
+ * queries without iterating over the data model. See anjay_access_utils.c for
+ * the rules under which it is kept in sync.
+ */
+typedef struct {
+    bool valid;
+    /**
+     * Set whenever the Access Control object is modified through the data
+     * model; cleared once _anjay_sync_access_control() has processed the
+     * corresponding notifications.
+     */
+    bool sync_pending;
+    /**
+     * Set if the last attempt to build the index failed; no further attempts
+     * are made until the Access Control object changes.
+     */
+    bool rebuild_failed;
+    AVS_SORTED_SET(anjay_ac_index_entry_t) instances;
+    AVS_SORTED_SET(anjay_ac_index_target_t) targets;
+} anjay_access_control_index_t;
+#endif // ANJAY_WITH_ACCESS_CONTROL
+
 typedef struct {
     unsigned depth;
     AVS_LIST(const anjay_dm_installed_object_t *) objs_in_transaction;
@@ -103,6 +131,16 @@ struct
      */
     AVS_LIST(const anjay_socket_entry_t) cached_public_sockets;
 
+#ifdef ANJAY_WITH_EVENT_LOOP_EPOLL
+    /**
+     * Incremented whenever a socket that may be returned by
+     * _anjay_collect_socket_entries() gets connected or cleaned up. The epoll
+     * based event loop uses it to detect that file descriptors it has
+     * registered might have been closed and reused in the meantime.
+     */
+    uint64_t sockets_generation;
+#endif // ANJAY_WITH_EVENT_LOOP_EPOLL
+
     avs_sched_handle_t reload_servers_sched_job_handle;
 #ifdef ANJAY_WITH_OBSERVE
     anjay_observe_state_t observe;
@@ -127,6 +165,9 @@ struct
 #endif     // WITH_AVS_COAP_TCP
 
     anjay_scheduled_notify_t scheduled_notify;
+#ifdef ANJAY_WITH_ACCESS_CONTROL
+    anjay_access_control_index_t access_control_index;
+#endif // ANJAY_WITH_ACCESS_CONTROL
 
     char *endpoint_name;
     anjay_transaction_state_t transaction_state;
@@ -162,6 +203,11 @@ struct
     bool connection_error_is_registration_failure;
 #ifdef ANJAY_WITH_NET_STATS
     closed_connections_stats_t closed_connections_stats;
+    /**
+     * Number of times a readable CoAP/UDP server connection socket has been
+     * served, i.e. drained of all queued packets.
+     */
+    uint64_t serve_count;
 #endif // ANJAY_WITH_NET_STATS
     bool use_connection_id;
     avs_ssl_additional_configuration_clb_t *additional_tls_config_clb;
@@ -196,6 +242,14 @@ _anjay_exchange_lifetime_for_transport(anjay_unlocked_t *anjay,
 int _anjay_serve_unlocked(anjay_unlocked_t *anjay,
                           avs_net_socket_t *ready_socket);
 
+static inline void _anjay_sockets_changed(anjay_unlocked_t *anjay) {
+#ifdef ANJAY_WITH_EVENT_LOOP_EPOLL
+    ++anjay->sockets_generation;
+#else  // ANJAY_WITH_EVENT_LOOP_EPOLL
+    (void) anjay;
+#endif // ANJAY_WITH_EVENT_LOOP_EPOLL
+}
+
 static inline avs_sched_t *_anjay_get_coap_sched(anjay_unlocked_t *anjay) {
 #ifdef ANJAY_WITH_THREAD_SAFETY
     return anjay->coap_sched;
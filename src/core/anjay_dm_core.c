@@ -309,10 +309,17 @@ unregister_object_unlocked(anjay_unlocked_t *anjay,
 
     _anjay_unregister_object_handle_transaction_state(anjay, detached);
     _anjay_unregister_object_handle_notify_queue(anjay, detached);
+#ifdef ANJAY_WITH_ACCESS_CONTROL
+    if (_anjay_dm_installed_object_oid(detached)
+            == ANJAY_DM_OID_ACCESS_CONTROL) {
+        _anjay_access_control_index_cleanup(&anjay->access_control_index);
+    }
+#endif // ANJAY_WITH_ACCESS_CONTROL
 
     dm_log(INFO, _("successfully unregistered object /") "%" PRIu16,
            _anjay_dm_installed_object_oid(detached));
     AVS_LIST_DELETE(&detached);
+    _anjay_observe_attrs_changed(anjay);
     if (_anjay_schedule_registration_update_unlocked(anjay, ANJAY_SSID_ANY)) {
         dm_log(WARNING, _("anjay_schedule_registration_update() failed"));
     }
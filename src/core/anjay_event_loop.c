@@ -24,6 +24,12 @@
 #        endif // AVS_COMMONS_NET_POSIX_AVS_SOCKET_HAVE_POLL
 #    endif     // AVS_COMMONS_POSIX_COMPAT_HEADER
 
+#    ifdef ANJAY_WITH_EVENT_LOOP_EPOLL
+#        include <errno.h>
+#        include <sys/epoll.h>
+#        include <unistd.h>
+#    endif // ANJAY_WITH_EVENT_LOOP_EPOLL
+
 #    include <anjay_init.h>
 
 #    include "anjay_core.h"
@@ -51,10 +57,44 @@ static bool should_event_loop_still_run(anjay_t *anjay) {
     }
 }
 
+#    ifdef ANJAY_WITH_EVENT_LOOP_EPOLL
+/**
+ * Maximum number of readiness events retrieved by a single epoll_wait() call.
+ * Any remaining ones are reported again in the next iteration, as the sockets
+ * are registered in level-triggered mode.
+ */
+#        define EPOLL_MAX_EVENTS 16
+
+typedef struct {
+    const sockfd_t fd;
+    avs_net_socket_t *socket;
+    /**
+     * Value of event_loop_state_t::iteration at which the socket has been last
+     * reported by _anjay_collect_socket_entries().
+     */
+    uint64_t last_seen_iteration;
+} registered_socket_t;
+#    endif // ANJAY_WITH_EVENT_LOOP_EPOLL
+
 typedef struct {
     anjay_t *const anjay_locked;
     const avs_time_duration_t max_wait_time;
     const bool allow_interrupt;
+#    ifdef ANJAY_WITH_EVENT_LOOP_EPOLL
+    /**
+     * Sockets registered in the epoll instance, ordered by file descriptor.
+     * Created lazily, together with epoll_fd - which is only valid if this
+     * set is non-NULL.
+     *
+     * NOTE: The epoll instance only pays off if it is kept across multiple
+     * iterations, so it is only used by anjay_event_loop_run*().
+     * anjay_serve_any() always uses poll() or select().
+     */
+    AVS_SORTED_SET(registered_socket_t) registered_sockets;
+    int epoll_fd;
+    uint64_t iteration;
+    uint64_t sockets_generation;
+#    endif // ANJAY_WITH_EVENT_LOOP_EPOLL
 #    ifdef AVS_COMMONS_NET_POSIX_AVS_SOCKET_HAVE_POLL
     struct pollfd *pollfds;
     size_t pollfds_size;
@@ -63,6 +103,12 @@ typedef struct {
 
 static void event_loop_state_cleanup(event_loop_state_t *state) {
     (void) state;
+#    ifdef ANJAY_WITH_EVENT_LOOP_EPOLL
+    if (state->registered_sockets) {
+        AVS_SORTED_SET_DELETE(&state->registered_sockets);
+        close(state->epoll_fd);
+    }
+#    endif // ANJAY_WITH_EVENT_LOOP_EPOLL
 #    ifdef AVS_COMMONS_NET_POSIX_AVS_SOCKET_HAVE_POLL
     avs_free(state->pollfds);
     state->pollfds = NULL;
@@ -76,6 +122,214 @@ typedef enum {
     HANDLE_SOCKETS_BREAK = 1
 } handle_sockets_result_t;
 
+static avs_time_duration_t get_wait_time(event_loop_state_t *state) {
+    avs_time_duration_t wait_time;
+    if (anjay_sched_time_to_next(state->anjay_locked, &wait_time)
+            || !avs_time_duration_less(wait_time, state->max_wait_time)) {
+        wait_time = state->max_wait_time;
+    }
+    assert(avs_time_duration_valid(wait_time)
+           && !avs_time_duration_less(wait_time, AVS_TIME_DURATION_ZERO));
+    return wait_time;
+}
+
+#    ifdef ANJAY_WITH_EVENT_LOOP_EPOLL
+static int registered_socket_cmp(const void *left, const void *right) {
+    sockfd_t left_fd = ((const registered_socket_t *) left)->fd;
+    sockfd_t right_fd = ((const registered_socket_t *) right)->fd;
+    return left_fd < right_fd ? -1 : (left_fd > right_fd ? 1 : 0);
+}
+
+static inline const registered_socket_t *
+registered_socket_query(const sockfd_t *fd) {
+    return AVS_CONTAINER_OF(fd, registered_socket_t, fd);
+}
+
+static int epoll_init(event_loop_state_t *state) {
+    assert(!state->registered_sockets);
+    if (!(state->registered_sockets = AVS_SORTED_SET_NEW(
+                  registered_socket_t, registered_socket_cmp))) {
+        _anjay_log_oom();
+        return -1;
+    }
+    if ((state->epoll_fd = epoll_create1(EPOLL_CLOEXEC)) < 0) {
+        anjay_log(ERROR, _("could not create epoll instance, errno = ") "%d",
+                  errno);
+        AVS_SORTED_SET_DELETE(&state->registered_sockets);
+        return -1;
+    }
+    return 0;
+}
+
+static int epoll_update(event_loop_state_t *state,
+                        registered_socket_t *registered,
+                        int op) {
+    struct epoll_event event = {
+        .events = EPOLLIN,
+        .data = {
+            .ptr = registered
+        }
+    };
+    int result = epoll_ctl(state->epoll_fd, op, registered->fd, &event);
+    if (result && op == EPOLL_CTL_ADD && errno == EEXIST) {
+        // registration left over from a previous socket using the same
+        // descriptor number
+        result = epoll_ctl(state->epoll_fd, EPOLL_CTL_MOD, registered->fd,
+                           &event);
+    } else if (result && op == EPOLL_CTL_MOD && errno == ENOENT) {
+        // registration removed by the kernel when the descriptor was closed
+        result = epoll_ctl(state->epoll_fd, EPOLL_CTL_ADD, registered->fd,
+                           &event);
+    }
+    if (result) {
+        anjay_log(WARNING,
+                  _("could not register socket ") "%d" _(
+                          " for polling, errno = ") "%d",
+                  (int) registered->fd, errno);
+    }
+    return result;
+}
+
+/**
+ * Removes @p registered from both the epoll instance and the registered_sockets
+ * set. The epoll registration must be removed before freeing the element, as
+ * the kernel might otherwise still report events carrying a pointer to it.
+ */
+static void epoll_forget(event_loop_state_t *state,
+                         AVS_SORTED_SET_ELEM(registered_socket_t) *registered) {
+    // NOTE: This fails if the descriptor has already been closed or has not
+    // been registered at all, which is fine - there is nothing to remove then.
+    epoll_ctl(state->epoll_fd, EPOLL_CTL_DEL, (*registered)->fd, NULL);
+    AVS_SORTED_SET_DELETE_ELEM(state->registered_sockets, registered);
+}
+
+static void epoll_register(event_loop_state_t *state,
+                           avs_net_socket_t *socket,
+                           bool resync) {
+    sockfd_t fd = INVALID_SOCKET;
+    const void *fd_ptr = avs_net_socket_get_system(socket);
+    if (fd_ptr) {
+        fd = *(const sockfd_t *) fd_ptr;
+    }
+    if (fd == INVALID_SOCKET) {
+        return;
+    }
+
+    AVS_SORTED_SET_ELEM(registered_socket_t) registered =
+            AVS_SORTED_SET_FIND(state->registered_sockets,
+                                registered_socket_query(&fd));
+    if (!registered) {
+        AVS_SORTED_SET_ELEM(registered_socket_t) new_registered =
+                AVS_SORTED_SET_ELEM_NEW(registered_socket_t);
+        if (!new_registered) {
+            _anjay_log_oom();
+            return;
+        }
+        memcpy((void *) (intptr_t) (const void *) &new_registered->fd, &fd,
+               sizeof(fd));
+        new_registered->socket = socket;
+        if (epoll_update(state, new_registered, EPOLL_CTL_ADD)) {
+            // a registration left over from a previous socket might still be
+            // there, pointing to an element that is no longer valid
+            epoll_ctl(state->epoll_fd, EPOLL_CTL_DEL, fd, NULL);
+            AVS_SORTED_SET_ELEM_DELETE_DETACHED(&new_registered);
+            return;
+        }
+        registered = AVS_SORTED_SET_INSERT(state->registered_sockets,
+                                           new_registered);
+        assert(registered == new_registered);
+    } else if (resync || registered->socket != socket) {
+        registered->socket = socket;
+        if (epoll_update(state, registered, EPOLL_CTL_MOD)) {
+            // will be retried in the next iteration
+            epoll_forget(state, &registered);
+            return;
+        }
+    }
+    registered->last_seen_iteration = state->iteration;
+}
+
+static void epoll_unregister_stale(event_loop_state_t *state) {
+    AVS_SORTED_SET_ELEM(registered_socket_t) registered =
+            AVS_SORTED_SET_FIRST(state->registered_sockets);
+    while (registered) {
+        AVS_SORTED_SET_ELEM(registered_socket_t) next =
+                AVS_SORTED_SET_NEXT(registered);
+        if (registered->last_seen_iteration != state->iteration) {
+            epoll_forget(state, &registered);
+        }
+        registered = next;
+    }
+}
+
+static handle_sockets_result_t
+handle_sockets_epoll(event_loop_state_t *state) {
+    assert(state->anjay_locked);
+    assert(avs_time_duration_valid(state->max_wait_time)
+           && !avs_time_duration_less(state->max_wait_time,
+                                      AVS_TIME_DURATION_ZERO));
+    handle_sockets_result_t result = HANDLE_SOCKETS_CONTINUE;
+    struct epoll_event events[EPOLL_MAX_EVENTS];
+    int num_events = 0;
+
+    ANJAY_MUTEX_LOCK(anjay, state->anjay_locked);
+    if (!state->registered_sockets && epoll_init(state)) {
+        result = HANDLE_SOCKETS_ERROR;
+    } else {
+        // If any socket has been connected or cleaned up since the last
+        // iteration, its descriptor number might have been reused - so all
+        // registrations need to be refreshed. Otherwise, only sockets that
+        // have appeared or changed need to be (re)registered.
+        const bool resync =
+                (state->sockets_generation != anjay->sockets_generation);
+        state->sockets_generation = anjay->sockets_generation;
+        ++state->iteration;
+
+        AVS_LIST(const anjay_socket_entry_t) entries =
+                _anjay_collect_socket_entries(anjay,
+                                              /* include_offline = */ false);
+        AVS_LIST(const anjay_socket_entry_t) entry;
+        AVS_LIST_FOREACH(entry, entries) {
+            epoll_register(state, entry->socket, resync);
+        }
+        AVS_LIST_CLEAR(&entries);
+        epoll_unregister_stale(state);
+    }
+    ANJAY_MUTEX_UNLOCK(state->anjay_locked);
+
+    if (result != HANDLE_SOCKETS_CONTINUE) {
+        return result;
+    }
+
+    int64_t wait_ms;
+    if (avs_time_duration_to_scalar(&wait_ms, AVS_TIME_MS,
+                                    get_wait_time(state))
+            || wait_ms > INT_MAX) {
+        wait_ms = (int64_t) INT_MAX;
+    }
+    num_events = epoll_wait(state->epoll_fd, events, EPOLL_MAX_EVENTS,
+                            (int) wait_ms);
+
+    for (int i = 0; i < num_events; ++i) {
+        if (state->allow_interrupt
+                && !should_event_loop_still_run(state->anjay_locked)) {
+            result = HANDLE_SOCKETS_BREAK;
+            break;
+        }
+        // NOTE: The registered_sockets set is only modified in this function,
+        // so the pointer is valid. The socket itself might have been already
+        // cleaned up while handling a previous event - but anjay_serve()
+        // only compares the pointer against known sockets, so it's safe.
+        const registered_socket_t *registered =
+                (const registered_socket_t *) events[i].data.ptr;
+        if (anjay_serve(state->anjay_locked, registered->socket)) {
+            anjay_log(WARNING, "anjay_serve failed");
+        }
+    }
+    return result;
+}
+#    endif // ANJAY_WITH_EVENT_LOOP_EPOLL
+
 static handle_sockets_result_t handle_sockets(event_loop_state_t *state) {
     assert(state->anjay_locked);
     assert(avs_time_duration_valid(state->max_wait_time)
@@ -160,13 +414,7 @@ static handle_sockets_result_t handle_sockets(event_loop_state_t *state) {
 #    endif // AVS_COMMONS_NET_POSIX_AVS_SOCKET_HAVE_POLL
     ANJAY_MUTEX_UNLOCK(state->anjay_locked);
 
-    avs_time_duration_t wait_time;
-    if (anjay_sched_time_to_next(state->anjay_locked, &wait_time)
-            || !avs_time_duration_less(wait_time, state->max_wait_time)) {
-        wait_time = state->max_wait_time;
-    }
-    assert(avs_time_duration_valid(wait_time)
-           && !avs_time_duration_less(wait_time, AVS_TIME_DURATION_ZERO));
+    avs_time_duration_t wait_time = get_wait_time(state);
 
     // Wait for the events if necessary, and handle them.
 #    ifdef AVS_COMMONS_NET_POSIX_AVS_SOCKET_HAVE_POLL
@@ -249,7 +497,11 @@ static int event_loop_run_with_error_handling(anjay_t *anjay_locked,
     };
     bool running = should_event_loop_still_run(anjay_locked);
     while (running) {
+#    ifdef ANJAY_WITH_EVENT_LOOP_EPOLL
+        handle_sockets_result = handle_sockets_epoll(&state);
+#    else  // ANJAY_WITH_EVENT_LOOP_EPOLL
         handle_sockets_result = handle_sockets(&state);
+#    endif // ANJAY_WITH_EVENT_LOOP_EPOLL
         switch (handle_sockets_result) {
         case HANDLE_SOCKETS_ERROR:
             atomic_store(&anjay_locked->atomic_fields.event_loop_status,
@@ -822,7 +822,7 @@ int _anjay_send_batch_data_add_current_multiple_unlocked(
     assert(anjay);
 
     anjay_batch_builder_t *batch_builder = cast_to_builder(builder);
-    AVS_LIST(anjay_batch_entry_t) *append_ptr = batch_builder->append_ptr;
+    anjay_batch_builder_mark_t mark = _anjay_batch_builder_mark(batch_builder);
     avs_time_real_t timestamp = avs_time_real_now();
 
     const anjay_dm_t *dm;
@@ -865,8 +865,7 @@ int _anjay_send_batch_data_add_current_multiple_unlocked(
     return 0;
 
 cleanup:
-    batch_builder->append_ptr = append_ptr;
-    _anjay_batch_entry_list_cleanup(batch_builder->append_ptr);
+    _anjay_batch_builder_rollback(batch_builder, mark);
     return result;
 }
 
@@ -148,6 +148,10 @@ static int anjay_notify_perform_impl(anjay_unlocked_t *anjay,
         if (it->instance_set_changes.instance_set_changed) {
             instances_modified = true;
         }
+        if (it->instance_set_changes.instance_set_changed
+                || it->oid == ANJAY_DM_OID_SERVER) {
+            _anjay_observe_attrs_changed(anjay);
+        }
         if (it->oid == ANJAY_DM_OID_SECURITY) {
             _anjay_update_ret(&ret, security_modified_notify(anjay, it));
         } else if (server_notify && it->oid == ANJAY_DM_OID_SERVER) {
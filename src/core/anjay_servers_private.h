@@ -105,6 +105,13 @@ typedef struct {
 typedef struct {
     anjay_conn_session_token_t session_token;
     AVS_LIST(const anjay_string_t) endpoint_path;
+    /**
+     * Uri-Path options corresponding to endpoint_path, serialized once when
+     * the endpoint path is assigned and used as a template for Update and
+     * De-register requests. Empty if serialization failed - endpoint_path is
+     * encoded on demand in that case.
+     */
+    avs_coap_options_t endpoint_path_options;
     anjay_lwm2m_version_t lwm2m_version;
     bool queue_mode;
     avs_time_real_t expire_time;
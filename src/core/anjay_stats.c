@@ -26,7 +26,8 @@ typedef enum {
     NET_STATS_BYTES_SENT,
     NET_STATS_BYTES_RECEIVED,
     NET_STATS_OUTGOING_RETRANSMISSIONS,
-    NET_STATS_INCOMING_RETRANSMISSIONS
+    NET_STATS_INCOMING_RETRANSMISSIONS,
+    NET_STATS_INCOMING_PACKETS
 } net_stats_type_t;
 
 static uint64_t get_socket_stats(avs_net_socket_t *socket,
@@ -80,6 +81,10 @@ static uint64_t get_current_stats_of_connection(anjay_connection_ref_t conn_ref,
         return coap_ctx ? avs_coap_get_stats(coap_ctx)
                                   .incoming_retransmissions_count
                         : 0;
+    case NET_STATS_INCOMING_PACKETS:
+        coap_ctx = _anjay_connection_get_coap(conn_ref);
+        return coap_ctx ? avs_coap_get_stats(coap_ctx).incoming_packets_count
+                        : 0;
     }
     AVS_UNREACHABLE("invalid enum value");
     return 0;
@@ -98,6 +103,9 @@ static uint64_t get_stats_of_closed_connections(anjay_unlocked_t *anjay,
     case NET_STATS_INCOMING_RETRANSMISSIONS:
         return anjay->closed_connections_stats.coap_stats
                 .incoming_retransmissions_count;
+    case NET_STATS_INCOMING_PACKETS:
+        return anjay->closed_connections_stats.coap_stats
+                .incoming_packets_count;
     }
     AVS_UNREACHABLE("invalid enum value");
     return 0;
@@ -171,6 +179,22 @@ uint64_t anjay_get_num_outgoing_retransmissions(anjay_t *anjay_locked) {
     return result;
 }
 
+uint64_t anjay_get_num_incoming_packets(anjay_t *anjay_locked) {
+    uint64_t result = 0;
+    ANJAY_MUTEX_LOCK(anjay, anjay_locked);
+    result = get_stats_of_all_connections(anjay, NET_STATS_INCOMING_PACKETS);
+    ANJAY_MUTEX_UNLOCK(anjay_locked);
+    return result;
+}
+
+uint64_t anjay_get_num_serve_calls(anjay_t *anjay_locked) {
+    uint64_t result = 0;
+    ANJAY_MUTEX_LOCK(anjay, anjay_locked);
+    result = anjay->serve_count;
+    ANJAY_MUTEX_UNLOCK(anjay_locked);
+    return result;
+}
+
 void _anjay_coap_ctx_cleanup(anjay_unlocked_t *anjay, avs_coap_ctx_t **ctx) {
     if (ctx && *ctx) {
         avs_coap_stats_t stats = avs_coap_get_stats(*ctx);
@@ -180,6 +204,8 @@ void _anjay_coap_ctx_cleanup(anjay_unlocked_t *anjay, avs_coap_ctx_t **ctx) {
         anjay->closed_connections_stats.coap_stats
                 .incoming_retransmissions_count +=
                 stats.incoming_retransmissions_count;
+        anjay->closed_connections_stats.coap_stats.incoming_packets_count +=
+                stats.incoming_packets_count;
     }
     avs_coap_ctx_cleanup(ctx);
 }
@@ -218,6 +244,22 @@ uint64_t anjay_get_num_outgoing_retransmissions(anjay_t *anjay) {
     return 0;
 }
 
+uint64_t anjay_get_num_incoming_packets(anjay_t *anjay) {
+    (void) anjay;
+    stats_log(ERROR,
+              _("NET_STATS feature disabled. Anjay was compiled without "
+                "ANJAY_WITH_NET_STATS option."));
+    return 0;
+}
+
+uint64_t anjay_get_num_serve_calls(anjay_t *anjay) {
+    (void) anjay;
+    stats_log(ERROR,
+              _("NET_STATS feature disabled. Anjay was compiled without "
+                "ANJAY_WITH_NET_STATS option."));
+    return 0;
+}
+
 void _anjay_coap_ctx_cleanup(anjay_unlocked_t *anjay, avs_coap_ctx_t **ctx) {
     (void) anjay;
     avs_coap_ctx_cleanup(ctx);
@@ -236,7 +278,7 @@ avs_error_t _anjay_socket_cleanup(anjay_unlocked_t *anjay,
         anjay->closed_connections_stats.socket_stats.bytes_received +=
                 get_socket_stats(*socket, NET_STATS_BYTES_RECEIVED);
 #endif // ANJAY_WITH_NET_STATS
-        (void) anjay;
+        _anjay_sockets_changed(anjay);
     }
     return avs_net_socket_cleanup(socket);
 }
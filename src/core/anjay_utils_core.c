@@ -13,6 +13,7 @@
 #include <ctype.h>
 #include <errno.h>
 #include <inttypes.h>
+#include <math.h>
 #include <stdarg.h>
 #include <stdio.h>
 #include <stdlib.h>
@@ -823,6 +824,104 @@ int _anjay_safe_strtod(const char *in, double *value) {
     return map_str_conversion_result(in, endptr);
 }
 
+// Powers of ten that are exactly representable as double
+static const double EXACT_POWERS_OF_10[] = {
+    1e0,  1e1,  1e2,  1e3,  1e4,  1e5,  1e6,  1e7,  1e8,  1e9,  1e10, 1e11,
+    1e12, 1e13, 1e14, 1e15, 1e16, 1e17, 1e18, 1e19, 1e20, 1e21, 1e22
+};
+
+// 2^53 - all non-negative integers below it are exactly representable
+#define MAX_EXACT_DOUBLE_INTEGER 9007199254740992.0
+
+static void
+format_fixed_point(char *out, uint64_t significand, size_t decimals) {
+    char reversed[sizeof("18446744073709551615") - 1];
+    size_t digit_count = 0;
+    do {
+        reversed[digit_count++] = (char) ('0' + significand % 10);
+        significand /= 10;
+    } while (significand);
+
+    size_t i = digit_count;
+    if (digit_count <= decimals) {
+        *out++ = '0';
+    } else {
+        for (; i > decimals; --i) {
+            *out++ = reversed[i - 1];
+        }
+    }
+    if (decimals) {
+        *out++ = '.';
+        for (size_t zeros = decimals; zeros > i; --zeros) {
+            *out++ = '0';
+        }
+        for (; i > 0; --i) {
+            *out++ = reversed[i - 1];
+        }
+    }
+    *out = '\0';
+}
+
+/**
+ * Finds the smallest number of decimal places k, for which @p value (assumed
+ * to be finite and non-negative) is exactly the double nearest to m / 10^k for
+ * some integer m. Both m and 10^k are then exact, and both IEEE 754 division
+ * and any conforming strtod() are correctly rounded, so printing m with k
+ * decimal places yields the shortest fixed-point notation that parses back to
+ * the same value.
+ *
+ * This covers virtually all values produced by sensors and similar sources,
+ * and requires neither big integer arithmetic nor lookup tables beyond the
+ * powers of ten.
+ */
+static bool format_as_scaled_integer(char *out, double value) {
+    for (size_t k = 0; k < AVS_ARRAY_SIZE(EXACT_POWERS_OF_10); ++k) {
+        double scaled = value * EXACT_POWERS_OF_10[k];
+        if (scaled >= MAX_EXACT_DOUBLE_INTEGER) {
+            return false;
+        }
+        double significand = floor(scaled + 0.5);
+        if (significand / EXACT_POWERS_OF_10[k] == value) {
+            format_fixed_point(out, (uint64_t) significand, k);
+            return true;
+        }
+    }
+    return false;
+}
+
+const char *
+_anjay_double_to_string__(char *buffer, size_t buffer_size, double value) {
+    assert(buffer_size >= ANJAY_DOUBLE_STRING_SIZE);
+    if (!isfinite(value)) {
+        avs_simple_snprintf(buffer, buffer_size, "%s",
+                            AVS_DOUBLE_AS_STRING(value, 17));
+        return buffer;
+    }
+    char *out = buffer;
+    if (signbit(value)) {
+        *out++ = '-';
+        value = -value;
+    }
+    if (format_as_scaled_integer(out, value)) {
+        return buffer;
+    }
+    // Very large or very small values, or ones with many significant digits:
+    // look for the lowest precision that survives the round trip. Any decimal
+    // with up to 15 (DBL_DIG) significant digits is reproduced exactly when
+    // printed with precision 15, and trailing zeros are stripped, so lower
+    // precisions do not need to be tried. 17 digits are always enough for
+    // IEEE 754 double.
+    for (uint8_t precision = 15; precision <= 17; ++precision) {
+        double parsed;
+        avs_simple_snprintf(out, buffer_size - (size_t) (out - buffer), "%s",
+                            AVS_DOUBLE_AS_STRING(value, precision));
+        if (!_anjay_safe_strtod(out, &parsed) && parsed == value) {
+            break;
+        }
+    }
+    return buffer;
+}
+
 // || defined(ANJAY_WITH_CORE_PERSISTENCE))
 
 void _anjay_log_oom(void) {
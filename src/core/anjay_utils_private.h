@@ -34,6 +34,25 @@ int _anjay_safe_strtoll(const char *in, long long *value);
 int _anjay_safe_strtoull(const char *in, unsigned long long *value);
 int _anjay_safe_strtod(const char *in, double *value);
 
+// Fits e.g. "-0.0000001234567890123456" and "-1.2345678901234567e-308"
+#define ANJAY_DOUBLE_STRING_SIZE 32
+
+/**
+ * Formats @p value as the shortest decimal string that parses back (e.g. with
+ * strtod()) to exactly the same double. Values that fit in a 53-bit integer
+ * after scaling by at most 10^22 (e.g. 21.5 or 0.1) are printed in plain
+ * fixed-point notation, without calling any printf-like functions; other values
+ * may use the exponential notation.
+ *
+ * Should not be used directly - use @ref ANJAY_DOUBLE_TO_STRING instead.
+ */
+const char *
+_anjay_double_to_string__(char *buffer, size_t buffer_size, double value);
+
+#define ANJAY_DOUBLE_TO_STRING(Value)                                         \
+    (_anjay_double_to_string__(&(char[ANJAY_DOUBLE_STRING_SIZE]){ 0 }[0], \
+                               ANJAY_DOUBLE_STRING_SIZE, (Value)))
+
 AVS_LIST(const anjay_string_t)
 _anjay_make_string_list(const char *string, ... /* strings */) AVS_F_SENTINEL;
 
@@ -46,6 +46,10 @@ int _anjay_attr_storage_init(anjay_attr_storage_t *as, anjay_dm_t *dm) {
 void _anjay_attr_storage_cleanup(anjay_attr_storage_t *as) {
     assert(as);
     _anjay_attr_storage_clear(as);
+    avs_free(as->index);
+    as->index = NULL;
+    as->index_size = 0;
+    _anjay_attr_storage_invalidate_index(as);
     avs_stream_cleanup(&as->saved_state.persist_data);
 }
 
@@ -67,6 +71,7 @@ void anjay_attr_storage_purge(anjay_t *anjay_locked) {
     ANJAY_MUTEX_LOCK(anjay, anjay_locked);
     _anjay_attr_storage_clear(&anjay->attr_storage);
     _anjay_attr_storage_mark_modified(&anjay->attr_storage);
+    _anjay_observe_attrs_changed(anjay);
     ANJAY_MUTEX_UNLOCK(anjay_locked);
 }
 
@@ -184,6 +189,153 @@ find_or_create_resource_instance(as_resource_entry_t *parent, anjay_riid_t id) {
 }
 #    endif // ANJAY_WITH_LWM2M11
 
+//// READ INDEX ////////////////////////////////////////////////////////////////
+
+static void index_append(as_index_entry_t *index,
+                         size_t *size_ptr,
+                         uint64_t key,
+                         void *attrs) {
+    if (attrs) {
+        if (index) {
+            assert(!*size_ptr || index[*size_ptr - 1].key < key);
+            index[*size_ptr].key = key;
+            index[*size_ptr].attrs = attrs;
+        }
+        ++*size_ptr;
+    }
+}
+
+/**
+ * Traverses the whole tree of entries in order, filling @p index (if not NULL)
+ * and returning the number of entries that have any attributes set.
+ */
+static size_t fill_index(anjay_attr_storage_t *as, as_index_entry_t *index) {
+    size_t size = 0;
+    AVS_LIST(as_object_entry_t) object;
+    AVS_LIST_FOREACH(object, as->objects) {
+        index_append(index, &size,
+                     _anjay_attr_storage_index_key(object->oid,
+                                                   ANJAY_ID_INVALID,
+                                                   ANJAY_ID_INVALID,
+                                                   ANJAY_ID_INVALID),
+                     object->default_attrs);
+        AVS_LIST(as_instance_entry_t) instance;
+        AVS_LIST_FOREACH(instance, object->instances) {
+            index_append(index, &size,
+                         _anjay_attr_storage_index_key(object->oid,
+                                                       instance->iid,
+                                                       ANJAY_ID_INVALID,
+                                                       ANJAY_ID_INVALID),
+                         instance->default_attrs);
+            AVS_LIST(as_resource_entry_t) resource;
+            AVS_LIST_FOREACH(resource, instance->resources) {
+                index_append(index, &size,
+                             _anjay_attr_storage_index_key(object->oid,
+                                                           instance->iid,
+                                                           resource->rid,
+                                                           ANJAY_ID_INVALID),
+                             resource->attrs);
+#    ifdef ANJAY_WITH_LWM2M11
+                AVS_LIST(as_resource_instance_entry_t) resource_instance;
+                AVS_LIST_FOREACH(resource_instance,
+                                 resource->resource_instances) {
+                    index_append(index, &size,
+                                 _anjay_attr_storage_index_key(
+                                         object->oid, instance->iid,
+                                         resource->rid,
+                                         resource_instance->riid),
+                                 resource_instance->attrs);
+                }
+#    endif // ANJAY_WITH_LWM2M11
+            }
+        }
+    }
+    return size;
+}
+
+static int rebuild_index(anjay_attr_storage_t *as) {
+    size_t size = fill_index(as, NULL);
+    if (size > as->index_size || !as->index) {
+        as_index_entry_t *index = NULL;
+        if (size
+                && !(index = (as_index_entry_t *) avs_malloc(
+                             size * sizeof(as_index_entry_t)))) {
+            _anjay_log_oom();
+            return -1;
+        }
+        avs_free(as->index);
+        as->index = index;
+    }
+    as->index_size = fill_index(as, as->index);
+    assert(as->index_size == size);
+    as->index_valid = true;
+    return 0;
+}
+
+static int find_indexed_attrs(anjay_attr_storage_t *as,
+                              uint64_t key,
+                              void **out_attrs) {
+    if (!as->index_valid && rebuild_index(as)) {
+        return -1;
+    }
+    size_t begin = 0;
+    size_t end = as->index_size;
+    while (begin < end) {
+        size_t middle = begin + (end - begin) / 2;
+        if (as->index[middle].key < key) {
+            begin = middle + 1;
+        } else {
+            end = middle;
+        }
+    }
+    *out_attrs = (begin < as->index_size && as->index[begin].key == key)
+                         ? as->index[begin].attrs
+                         : NULL;
+    return 0;
+}
+
+/**
+ * Returns the list of attributes stored for a given path, i.e.
+ * AVS_LIST(as_default_attrs_t) if @p rid is ANJAY_ID_INVALID, or
+ * AVS_LIST(as_resource_attrs_t) otherwise.
+ */
+static void *find_attrs(anjay_attr_storage_t *as,
+                        anjay_oid_t oid,
+                        anjay_iid_t iid,
+                        anjay_rid_t rid,
+                        anjay_riid_t riid) {
+    void *attrs;
+    if (!find_indexed_attrs(
+                as, _anjay_attr_storage_index_key(oid, iid, rid, riid),
+                &attrs)) {
+        return attrs;
+    }
+
+    // the index could not be built, fall back to traversing the tree
+    AVS_LIST(as_object_entry_t) *object_ptr = find_object(as, oid);
+    if (!object_ptr || iid == ANJAY_ID_INVALID) {
+        return object_ptr ? (*object_ptr)->default_attrs : NULL;
+    }
+    AVS_LIST(as_instance_entry_t) *instance_ptr =
+            find_instance(*object_ptr, iid);
+    if (!instance_ptr || rid == ANJAY_ID_INVALID) {
+        return instance_ptr ? (*instance_ptr)->default_attrs : NULL;
+    }
+    AVS_LIST(as_resource_entry_t) *res_ptr = find_resource(*instance_ptr, rid);
+    if (!res_ptr || riid == ANJAY_ID_INVALID) {
+        return res_ptr ? (*res_ptr)->attrs : NULL;
+    }
+#    ifdef ANJAY_WITH_LWM2M11
+    AVS_LIST(as_resource_instance_entry_t) *res_instance_ptr =
+            find_resource_instance(*res_ptr, riid);
+    return res_instance_ptr ? (*res_instance_ptr)->attrs : NULL;
+#    else  // ANJAY_WITH_LWM2M11
+    return NULL;
+#    endif // ANJAY_WITH_LWM2M11
+}
+
+//// TREE MAINTENANCE //////////////////////////////////////////////////////////
+
 static void remove_instance_if_empty(AVS_LIST(as_instance_entry_t) *entry_ptr) {
     if (!(*entry_ptr)->default_attrs && !(*entry_ptr)->resources) {
         AVS_LIST_DELETE(entry_ptr);
@@ -742,6 +894,7 @@ static int remove_absent_resources_in_all_instances(
 int _anjay_attr_storage_notify(anjay_unlocked_t *anjay,
                                anjay_notify_queue_t queue) {
     int result = 0;
+    bool modified = false;
     AVS_LIST(anjay_notify_queue_object_entry_t) object_entry;
     AVS_LIST_FOREACH(object_entry, queue) {
         AVS_LIST(as_object_entry_t) *object_ptr =
@@ -754,8 +907,14 @@ int _anjay_attr_storage_notify(anjay_unlocked_t *anjay,
                 _anjay_dm_find_object_by_oid(&anjay->dm, object_entry->oid);
         if (!def_ptr && object_ptr) {
             remove_object_entry(&anjay->attr_storage, object_ptr);
+            modified = true;
             continue;
         }
+        anjay_attr_storage_t *as = def_ptr ? get_attr_storage(anjay, def_ptr)
+                                           : &anjay->attr_storage;
+        const uint64_t as_modification_count = as->modification_count;
+        const uint64_t main_modification_count =
+                anjay->attr_storage.modification_count;
         AVS_LIST(anjay_ssid_t) ssids = NULL;
         int partial_result =
                 remove_absent_instances_and_enumerate_ssids(anjay, def_ptr,
@@ -778,6 +937,17 @@ int _anjay_attr_storage_notify(anjay_unlocked_t *anjay,
                     anjay, def_ptr, object_entry->resources_changed);
         }
         _anjay_update_ret(&result, partial_result);
+        if (as->modification_count != as_modification_count
+                || anjay->attr_storage.modification_count
+                           != main_modification_count) {
+            modified = true;
+        }
+    }
+    if (modified) {
+        // Attributes of entities that are gone have been removed; these might
+        // still be cached for observations, and would otherwise come back if
+        // the entities reappear
+        _anjay_observe_attrs_changed(anjay);
     }
     return result;
 }
@@ -788,11 +958,12 @@ static int object_read_default_attrs(anjay_unlocked_t *anjay,
                                      const anjay_dm_installed_object_t obj_ptr,
                                      anjay_ssid_t ssid,
                                      anjay_dm_oi_attributes_t *out) {
-    anjay_attr_storage_t *as = get_attr_storage(anjay, &obj_ptr);
-    AVS_LIST(as_object_entry_t) *object_ptr =
-            find_object(as, _anjay_dm_installed_object_oid(&obj_ptr));
-    read_default_attrs(object_ptr ? (*object_ptr)->default_attrs : NULL, ssid,
-                       out);
+    read_default_attrs(
+            (AVS_LIST(as_default_attrs_t)) find_attrs(
+                    get_attr_storage(anjay, &obj_ptr),
+                    _anjay_dm_installed_object_oid(&obj_ptr), ANJAY_ID_INVALID,
+                    ANJAY_ID_INVALID, ANJAY_ID_INVALID),
+            ssid, out);
     return 0;
 }
 
@@ -810,12 +981,10 @@ instance_read_default_attrs(anjay_unlocked_t *anjay,
                             anjay_iid_t iid,
                             anjay_ssid_t ssid,
                             anjay_dm_oi_attributes_t *out) {
-    anjay_attr_storage_t *as = get_attr_storage(anjay, &obj_ptr);
-    AVS_LIST(as_object_entry_t) *object_ptr =
-            find_object(as, _anjay_dm_installed_object_oid(&obj_ptr));
-    AVS_LIST(as_instance_entry_t) *instance_ptr =
-            object_ptr ? find_instance(*object_ptr, iid) : NULL;
-    read_default_attrs(instance_ptr ? (*instance_ptr)->default_attrs : NULL,
+    read_default_attrs((AVS_LIST(as_default_attrs_t)) find_attrs(
+                               get_attr_storage(anjay, &obj_ptr),
+                               _anjay_dm_installed_object_oid(&obj_ptr), iid,
+                               ANJAY_ID_INVALID, ANJAY_ID_INVALID),
                        ssid, out);
     return 0;
 }
@@ -837,14 +1006,11 @@ static int resource_read_attrs(anjay_unlocked_t *anjay,
                                anjay_rid_t rid,
                                anjay_ssid_t ssid,
                                anjay_dm_r_attributes_t *out) {
-    anjay_attr_storage_t *as = get_attr_storage(anjay, &obj_ptr);
-    AVS_LIST(as_object_entry_t) *object_ptr =
-            find_object(as, _anjay_dm_installed_object_oid(&obj_ptr));
-    AVS_LIST(as_instance_entry_t) *instance_ptr =
-            object_ptr ? find_instance(*object_ptr, iid) : NULL;
-    AVS_LIST(as_resource_entry_t) *res_ptr =
-            instance_ptr ? find_resource(*instance_ptr, rid) : NULL;
-    read_resource_attrs(res_ptr ? (*res_ptr)->attrs : NULL, ssid, out);
+    read_resource_attrs((AVS_LIST(as_resource_attrs_t)) find_attrs(
+                                get_attr_storage(anjay, &obj_ptr),
+                                _anjay_dm_installed_object_oid(&obj_ptr), iid,
+                                rid, ANJAY_ID_INVALID),
+                        ssid, out);
     return 0;
 }
 
@@ -868,16 +1034,10 @@ resource_instance_read_attrs(anjay_unlocked_t *anjay,
                              anjay_riid_t riid,
                              anjay_ssid_t ssid,
                              anjay_dm_r_attributes_t *out) {
-    anjay_attr_storage_t *as = get_attr_storage(anjay, &obj_ptr);
-    AVS_LIST(as_object_entry_t) *object_ptr =
-            find_object(as, _anjay_dm_installed_object_oid(&obj_ptr));
-    AVS_LIST(as_instance_entry_t) *instance_ptr =
-            object_ptr ? find_instance(*object_ptr, iid) : NULL;
-    AVS_LIST(as_resource_entry_t) *res_ptr =
-            instance_ptr ? find_resource(*instance_ptr, rid) : NULL;
-    AVS_LIST(as_resource_instance_entry_t) *res_instance_ptr =
-            res_ptr ? find_resource_instance(*res_ptr, riid) : NULL;
-    read_resource_attrs(res_instance_ptr ? (*res_instance_ptr)->attrs : NULL,
+    read_resource_attrs((AVS_LIST(as_resource_attrs_t)) find_attrs(
+                                get_attr_storage(anjay, &obj_ptr),
+                                _anjay_dm_installed_object_oid(&obj_ptr), iid,
+                                rid, riid),
                         ssid, out);
     return 0;
 }
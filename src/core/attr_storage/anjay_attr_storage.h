@@ -19,6 +19,7 @@
 VISIBILITY_PRIVATE_HEADER_BEGIN
 
 typedef struct as_object_entry as_object_entry_t;
+typedef struct as_index_entry as_index_entry_t;
 
 typedef struct {
     avs_stream_t *persist_data;
@@ -27,7 +28,15 @@ typedef struct {
 
 struct anjay_attr_storage_struct {
     AVS_LIST(as_object_entry_t) objects;
+    // Flat array of all the entries in objects that have any attributes set,
+    // sorted by path; rebuilt lazily after each modification
+    as_index_entry_t *index;
+    size_t index_size;
+    bool index_valid;
     bool modified_since_persist;
+    // Incremented on every modification, so that callers can tell whether
+    // an operation changed anything
+    uint64_t modification_count;
     as_saved_state_t saved_state;
     anjay_dm_t *dm;
 };
@@ -406,6 +406,8 @@ avs_error_t _anjay_attr_storage_restore_inner(anjay_unlocked_t *anjay,
             || avs_is_err((err = clear_nonexistent_entries(anjay, as)))) {
         _anjay_attr_storage_clear(as);
     }
+    _anjay_attr_storage_invalidate_index(as);
+    _anjay_observe_attrs_changed(anjay);
     return err;
 }
 
@@ -55,6 +55,30 @@ struct as_object_entry {
     AVS_LIST(as_instance_entry_t) instances;
 };
 
+struct as_index_entry {
+    // See _anjay_attr_storage_index_key()
+    uint64_t key;
+    // AVS_LIST(as_default_attrs_t) for Object and Object Instance entries,
+    // AVS_LIST(as_resource_attrs_t) for Resource and Resource Instance entries
+    void *attrs;
+};
+
+/**
+ * Returns the key under which attributes for a given path are stored in
+ * anjay_attr_storage_t::index. Each ID is offset by one, so that
+ * ANJAY_ID_INVALID, i.e. an absent ID, orders a path before all of its
+ * descendants - same as the order in which the tree of entries is traversed.
+ */
+static inline uint64_t _anjay_attr_storage_index_key(anjay_oid_t oid,
+                                                     anjay_iid_t iid,
+                                                     anjay_rid_t rid,
+                                                     anjay_riid_t riid) {
+    return ((uint64_t) (uint16_t) (oid + 1) << 48)
+           | ((uint64_t) (uint16_t) (iid + 1) << 32)
+           | ((uint64_t) (uint16_t) (rid + 1) << 16)
+           | (uint64_t) (uint16_t) (riid + 1);
+}
+
 void _anjay_attr_storage_clear(anjay_attr_storage_t *as);
 
 /**
@@ -88,8 +112,15 @@ int _anjay_attr_storage_remove_absent_resource_instances(
         AVS_LIST(as_resource_entry_t) *resource_ptr);
 #endif // ANJAY_WITH_LWM2M11
 
+static inline void
+_anjay_attr_storage_invalidate_index(anjay_attr_storage_t *as) {
+    as->index_valid = false;
+}
+
 static inline void _anjay_attr_storage_mark_modified(anjay_attr_storage_t *as) {
     as->modified_since_persist = true;
+    ++as->modification_count;
+    _anjay_attr_storage_invalidate_index(as);
 }
 
 #ifdef ANJAY_WITH_LWM2M11
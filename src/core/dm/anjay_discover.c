@@ -55,7 +55,7 @@ print_double_attr(avs_stream_t *stream, const char *name, double value) {
         return 0;
     }
     return avs_is_ok(avs_stream_write_f(stream, ";%s=%s", name,
-                                        AVS_DOUBLE_AS_STRING(value, 17)))
+                                        ANJAY_DOUBLE_TO_STRING(value)))
                    ? 0
                    : -1;
 }
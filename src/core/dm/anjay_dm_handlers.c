@@ -13,6 +13,7 @@
 
 #include <anjay_modules/anjay_dm_utils.h>
 
+#include "../anjay_access_utils_private.h"
 #include "../anjay_core.h"
 #include "../anjay_io_core.h"
 #include "../anjay_utils_private.h"
@@ -741,6 +742,7 @@ int _anjay_dm_call_object_write_default_attrs(
     dm_log(TRACE, _("object_write_default_attrs ") DM_LOG_PREFIX "/%u",
            DM_LOG_PREFIX_OBJ_ARG(obj_ptr)
                    _anjay_dm_installed_object_oid(obj_ptr));
+    _anjay_observe_attrs_changed(anjay);
     CHECKED_TAIL_CALL_HANDLER(obj_ptr, object_write_default_attrs, anjay,
                               *obj_ptr, ssid, attrs);
 }
@@ -820,6 +822,7 @@ int _anjay_dm_call_instance_write_default_attrs(
            DM_LOG_PREFIX_OBJ_ARG(obj_ptr)
                    _anjay_dm_installed_object_oid(obj_ptr),
            iid);
+    _anjay_observe_attrs_changed(anjay);
     CHECKED_TAIL_CALL_HANDLER(obj_ptr, instance_write_default_attrs, anjay,
                               *obj_ptr, iid, ssid, attrs);
 }
@@ -956,6 +959,7 @@ int _anjay_dm_call_resource_write_attrs(
            DM_LOG_PREFIX_OBJ_ARG(obj_ptr)
                    _anjay_dm_installed_object_oid(obj_ptr),
            iid, rid);
+    _anjay_observe_attrs_changed(anjay);
     CHECKED_TAIL_CALL_HANDLER(obj_ptr, resource_write_attrs, anjay, *obj_ptr,
                               iid, rid, ssid, attrs);
 }
@@ -991,6 +995,7 @@ int _anjay_dm_call_resource_instance_write_attrs(
            DM_LOG_PREFIX_OBJ_ARG(obj_ptr)
                    _anjay_dm_installed_object_oid(obj_ptr),
            iid, rid, riid);
+    _anjay_observe_attrs_changed(anjay);
     CHECKED_TAIL_CALL_HANDLER(obj_ptr, resource_instance_write_attrs, anjay,
                               *obj_ptr, iid, rid, riid, ssid, attrs);
 }
@@ -1045,6 +1050,7 @@ int _anjay_dm_call_transaction_rollback(
     dm_log(TRACE, _("rollback_object ") DM_LOG_PREFIX "/%u",
            DM_LOG_PREFIX_OBJ_ARG(obj_ptr)
                    _anjay_dm_installed_object_oid(obj_ptr));
+    _anjay_access_control_index_object_rolled_back(anjay, obj_ptr);
     CHECKED_TAIL_CALL_HANDLER(obj_ptr, transaction_rollback, anjay, *obj_ptr);
 }
 
@@ -1069,6 +1075,7 @@ int _anjay_dm_transaction_include_object(
            DM_LOG_PREFIX_OBJ_ARG(obj_ptr)
                    _anjay_dm_installed_object_oid(obj_ptr));
     assert(anjay->transaction_state.depth > 0);
+    _anjay_access_control_index_object_modified(anjay, obj_ptr);
     AVS_LIST(const anjay_dm_installed_object_t *) *it;
     AVS_LIST_FOREACH_PTR(it, &anjay->transaction_state.objs_in_transaction) {
         if (**it >= obj_ptr) {
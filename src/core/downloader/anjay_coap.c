@@ -512,6 +512,7 @@ reconnect_coap_transfer(AVS_LIST(anjay_download_ctx_t) *ctx_ptr) {
     avs_net_socket_close(ctx->socket);
     avs_error_t err =
             avs_net_socket_connect(ctx->socket, ctx->uri.host, ctx->uri.port);
+    _anjay_sockets_changed(_anjay_downloader_get_anjay(ctx->common.dl));
     if (avs_is_err(err)) {
         dl_log(WARNING,
                _("could not connect socket for download id = ") "%" PRIuPTR,
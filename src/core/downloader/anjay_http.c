@@ -174,6 +174,13 @@ static void handle_http_packet(AVS_LIST(anjay_download_ctx_t) *ctx_ptr) {
     avs_shared_buffer_release(anjay->in_shared_buffer);
 }
 
+static void close_http_stream(anjay_http_download_ctx_t *ctx) {
+    avs_stream_cleanup(&ctx->stream);
+    // the socket of a stream opened later may reuse both the descriptor number
+    // and the address of the one that has just been closed
+    _anjay_sockets_changed(_anjay_downloader_get_anjay(ctx->common.dl));
+}
+
 static void timeout_job(avs_sched_t *sched, const void *id_ptr) {
     anjay_t *anjay_locked = _anjay_get_from_sched(sched);
     ANJAY_MUTEX_LOCK(anjay, anjay_locked);
@@ -204,6 +211,7 @@ static void send_request_unlocked(anjay_unlocked_t *anjay, uintptr_t id) {
             avs_http_open_stream(&ctx->stream, ctx->client, AVS_HTTP_GET,
                                  AVS_HTTP_CONTENT_IDENTITY, ctx->parsed_url,
                                  NULL, NULL);
+    _anjay_sockets_changed(anjay);
     if (avs_is_err(err) || !ctx->stream) {
         _anjay_downloader_abort_transfer(ctx_ptr,
                                          _anjay_download_status_failed(err));
@@ -351,7 +359,7 @@ static void
 cleanup_http_stream_unlocked(AVS_LIST(anjay_download_ctx_t) detached_ctx) {
     anjay_http_download_ctx_t *ctx = (anjay_http_download_ctx_t *) detached_ctx;
     avs_free(ctx->etag);
-    avs_stream_cleanup(&ctx->stream);
+    close_http_stream(ctx);
     avs_url_free(ctx->parsed_url);
     avs_http_free(ctx->client);
     _anjay_security_config_cache_cleanup(&ctx->security_config_cache);
@@ -391,13 +399,13 @@ static void cleanup_http_transfer(AVS_LIST(anjay_download_ctx_t) *ctx_ptr) {
 static void suspend_http_transfer(anjay_download_ctx_t *ctx_) {
     anjay_http_download_ctx_t *ctx = (anjay_http_download_ctx_t *) ctx_;
     avs_sched_del(&ctx->next_action_job);
-    avs_stream_cleanup(&ctx->stream);
+    close_http_stream(ctx);
 }
 
 static avs_error_t
 reconnect_http_transfer(AVS_LIST(anjay_download_ctx_t) *ctx_ptr) {
     anjay_http_download_ctx_t *ctx = (anjay_http_download_ctx_t *) *ctx_ptr;
-    avs_stream_cleanup(&ctx->stream);
+    close_http_stream(ctx);
     anjay_unlocked_t *anjay = _anjay_downloader_get_anjay(ctx->common.dl);
     if (AVS_SCHED_NOW(anjay->sched, &ctx->next_action_job, send_request,
                       &ctx->common.id, sizeof(ctx->common.id))) {
@@ -32,6 +32,9 @@ VISIBILITY_SOURCE_BEGIN
 
 #    define batch_log(level, ...) _anjay_log(batch_builder, level, __VA_ARGS__)
 
+#    define BATCH_INITIAL_ENTRY_CAPACITY 8
+#    define BATCH_ARENA_CHUNK_SIZE 256
+
 typedef enum {
     ANJAY_BATCH_DATA_BYTES,
     ANJAY_BATCH_DATA_STRING,
@@ -72,10 +75,18 @@ struct anjay_batch_entry {
     avs_time_real_t timestamp;
 };
 
+struct anjay_batch_arena_chunk {
+    size_t capacity;
+    size_t used;
+    char data[];
+};
+
 struct anjay_batch_struct {
-    AVS_LIST(anjay_batch_entry_t) list;
     size_t ref_count;
     avs_time_real_t compilation_time;
+    size_t entry_count;
+    // Followed by string and bytes payloads of the entries, in the same block
+    anjay_batch_entry_t entries[];
 };
 
 struct anjay_batch_data_output_state_struct {
@@ -100,24 +111,65 @@ typedef struct builder_out_struct {
 } builder_out_ctx_t;
 
 anjay_batch_builder_t *_anjay_batch_builder_new(void) {
-    anjay_batch_builder_t *builder =
-            (anjay_batch_builder_t *) avs_calloc(1,
-                                                 sizeof(anjay_batch_builder_t));
-    if (!builder) {
-        return NULL;
+    return (anjay_batch_builder_t *) avs_calloc(1,
+                                                sizeof(anjay_batch_builder_t));
+}
+
+anjay_batch_builder_mark_t
+_anjay_batch_builder_mark(const anjay_batch_builder_t *builder) {
+    assert(builder);
+    return (anjay_batch_builder_mark_t) {
+        .entry_count = builder->entry_count,
+        .arena_head = builder->arena,
+        .arena_head_used = builder->arena ? builder->arena->used : 0
+    };
+}
+
+void _anjay_batch_builder_rollback(anjay_batch_builder_t *builder,
+                                   anjay_batch_builder_mark_t mark) {
+    assert(builder);
+    assert(mark.entry_count <= builder->entry_count);
+    builder->entry_count = mark.entry_count;
+    while (builder->arena != mark.arena_head) {
+        assert(builder->arena);
+        AVS_LIST_DELETE(&builder->arena);
+    }
+    if (builder->arena) {
+        assert(mark.arena_head_used <= builder->arena->used);
+        builder->arena->used = mark.arena_head_used;
     }
-    builder->append_ptr = &builder->list;
-    return builder;
 }
 
-static int make_data_with_duplicated_string(anjay_batch_data_t *batch_data,
+static void *arena_alloc(anjay_batch_builder_t *builder, size_t size) {
+    assert(size);
+    if (!builder->arena
+            || builder->arena->capacity - builder->arena->used < size) {
+        size_t capacity = AVS_MAX(size, BATCH_ARENA_CHUNK_SIZE);
+        AVS_LIST(anjay_batch_arena_chunk_t) chunk =
+                (AVS_LIST(anjay_batch_arena_chunk_t)) AVS_LIST_NEW_BUFFER(
+                        sizeof(anjay_batch_arena_chunk_t) + capacity);
+        if (!chunk) {
+            return NULL;
+        }
+        chunk->capacity = capacity;
+        AVS_LIST_INSERT(&builder->arena, chunk);
+    }
+    void *result = builder->arena->data + builder->arena->used;
+    builder->arena->used += size;
+    return result;
+}
+
+static int make_data_with_duplicated_string(anjay_batch_builder_t *builder,
+                                            anjay_batch_data_t *batch_data,
                                             const char *str) {
     assert(batch_data);
     assert(str);
-    char *new_str = avs_strdup(str);
+    size_t size = strlen(str) + 1;
+    char *new_str = (char *) arena_alloc(builder, size);
     if (!new_str) {
         return -1;
     }
+    memcpy(new_str, str, size);
     *batch_data = (anjay_batch_data_t) {
         .type = ANJAY_BATCH_DATA_STRING,
         .value = {
@@ -127,35 +179,43 @@ static int make_data_with_duplicated_string(anjay_batch_data_t *batch_data,
     return 0;
 }
 
-static void batch_data_cleanup(anjay_batch_data_t *data) {
-    if (data->type == ANJAY_BATCH_DATA_STRING) {
-        avs_free((void *) (intptr_t) data->value.string);
-    } else if (data->type == ANJAY_BATCH_DATA_BYTES) {
-        avs_free((void *) (intptr_t) data->value.bytes.data);
+static int ensure_entry_capacity(anjay_batch_builder_t *builder) {
+    if (builder->entry_count < builder->entry_capacity) {
+        return 0;
+    }
+    size_t new_capacity = builder->entry_capacity
+                                  ? 2 * builder->entry_capacity
+                                  : BATCH_INITIAL_ENTRY_CAPACITY;
+    anjay_batch_entry_t *new_entries = (anjay_batch_entry_t *) avs_realloc(
+            builder->entries, new_capacity * sizeof(anjay_batch_entry_t));
+    if (!new_entries) {
+        return -1;
     }
+    builder->entries = new_entries;
+    builder->entry_capacity = new_capacity;
+    return 0;
 }
 
+/**
+ * Appends an entry to the builder. Payload referenced by @p data, if any, is
+ * expected to have been allocated from the builder's arena - it is the
+ * caller's responsibility to roll it back on failure.
+ */
 static int batch_data_add(anjay_batch_builder_t *builder,
                           const anjay_uri_path_t *uri,
                           avs_time_real_t timestamp,
                           anjay_batch_data_t data) {
     assert(builder);
-    if (data.type != ANJAY_BATCH_DATA_START_AGGREGATE
-            && !_anjay_uri_path_has(uri, ANJAY_ID_RID)) {
-        batch_data_cleanup(&data);
-        return -1;
-    }
-    *builder->append_ptr = AVS_LIST_NEW_ELEMENT(anjay_batch_entry_t);
-    if (!*builder->append_ptr) {
-        batch_data_cleanup(&data);
+    if ((data.type != ANJAY_BATCH_DATA_START_AGGREGATE
+         && !_anjay_uri_path_has(uri, ANJAY_ID_RID))
+            || ensure_entry_capacity(builder)) {
         return -1;
     }
-    **builder->append_ptr = (anjay_batch_entry_t) {
+    builder->entries[builder->entry_count++] = (anjay_batch_entry_t) {
         .path = *uri,
         .timestamp = timestamp,
         .data = data
     };
-    AVS_LIST_ADVANCE_PTR(&builder->append_ptr);
     return 0;
 }
 
@@ -217,15 +277,19 @@ int _anjay_batch_add_string(anjay_batch_builder_t *builder,
                             const anjay_uri_path_t *uri,
                             avs_time_real_t timestamp,
                             const char *str) {
+    anjay_batch_builder_mark_t mark = _anjay_batch_builder_mark(builder);
     anjay_batch_data_t str_data;
-    if (make_data_with_duplicated_string(&str_data, str)) {
+    if (make_data_with_duplicated_string(builder, &str_data, str)
+            || batch_data_add(builder, uri, timestamp, str_data)) {
+        _anjay_batch_builder_rollback(builder, mark);
         return -1;
     }
-    return batch_data_add(builder, uri, timestamp, str_data);
+    return 0;
 }
 
 #    ifdef ANJAY_WITH_LWM2M11
-static int make_data_with_duplicated_bytes(anjay_batch_data_t *batch_data,
+static int make_data_with_duplicated_bytes(anjay_batch_builder_t *builder,
+                                           anjay_batch_data_t *batch_data,
                                            const void *data,
                                            size_t length) {
     assert(batch_data);
@@ -235,7 +299,7 @@ static int make_data_with_duplicated_bytes(anjay_batch_data_t *batch_data,
     void *new_data = NULL;
 
     if (data && length) {
-        new_data = avs_malloc(length);
+        new_data = arena_alloc(builder, length);
         if (!new_data) {
             return -1;
         }
@@ -259,11 +323,14 @@ int _anjay_batch_add_bytes(anjay_batch_builder_t *builder,
                            avs_time_real_t timestamp,
                            const void *data,
                            size_t length) {
+    anjay_batch_builder_mark_t mark = _anjay_batch_builder_mark(builder);
     anjay_batch_data_t bytes_data;
-    if (make_data_with_duplicated_bytes(&bytes_data, data, length)) {
+    if (make_data_with_duplicated_bytes(builder, &bytes_data, data, length)
+            || batch_data_add(builder, uri, timestamp, bytes_data)) {
+        _anjay_batch_builder_rollback(builder, mark);
         return -1;
     }
-    return batch_data_add(builder, uri, timestamp, bytes_data);
+    return 0;
 }
 #    endif // ANJAY_WITH_LWM2M11
 
@@ -284,20 +351,10 @@ int _anjay_batch_add_objlnk(anjay_batch_builder_t *builder,
     return batch_data_add(builder, uri, timestamp, data);
 }
 
-static void batch_entry_cleanup(void *entry_) {
-    anjay_batch_entry_t *entry = (anjay_batch_entry_t *) entry_;
-    batch_data_cleanup(&entry->data);
-}
-
-void _anjay_batch_entry_list_cleanup(AVS_LIST(anjay_batch_entry_t) *list) {
-    AVS_LIST_CLEAR(list) {
-        batch_entry_cleanup(*list);
-    }
-}
-
 void _anjay_batch_builder_cleanup(anjay_batch_builder_t **builder) {
     if (builder && *builder) {
-        _anjay_batch_entry_list_cleanup(&(*builder)->list);
+        avs_free((*builder)->entries);
+        AVS_LIST_CLEAR(&(*builder)->arena);
         avs_free(*builder);
         *builder = NULL;
     }
@@ -323,6 +380,36 @@ static int ensure_ref_count_mutex_initialized(void) {
 }
 #    endif // ANJAY_WITH_THREAD_SAFETY
 
+static size_t batch_data_payload_size(const anjay_batch_data_t *data) {
+    switch (data->type) {
+    case ANJAY_BATCH_DATA_STRING:
+        return strlen(data->value.string) + 1;
+    case ANJAY_BATCH_DATA_BYTES:
+        return data->value.bytes.length;
+    default:
+        return 0;
+    }
+}
+
+/**
+ * Copies the payload of @p data (if any) to @p dest and updates @p data to
+ * point to the copy.
+ *
+ * @returns Pointer just past the copied payload.
+ */
+static char *batch_data_relocate_payload(anjay_batch_data_t *data,
+                                         char *dest) {
+    size_t size = batch_data_payload_size(data);
+    if (data->type == ANJAY_BATCH_DATA_STRING) {
+        memcpy(dest, data->value.string, size);
+        data->value.string = dest;
+    } else if (data->type == ANJAY_BATCH_DATA_BYTES && size) {
+        memcpy(dest, data->value.bytes.data, size);
+        data->value.bytes.data = dest;
+    }
+    return dest + size;
+}
+
 anjay_batch_t *_anjay_batch_builder_compile(anjay_batch_builder_t **builder) {
     assert(builder && *builder);
 #    ifdef ANJAY_WITH_THREAD_SAFETY
@@ -331,16 +418,26 @@ anjay_batch_t *_anjay_batch_builder_compile(anjay_batch_builder_t **builder) {
     }
     assert(REF_COUNT_MUTEX);
 #    endif // ANJAY_WITH_THREAD_SAFETY
-    anjay_batch_t *batch =
-            (anjay_batch_t *) avs_calloc(1, sizeof(anjay_batch_t));
+    const anjay_batch_builder_t *src = *builder;
+    size_t payload_size = 0;
+    for (size_t i = 0; i < src->entry_count; ++i) {
+        payload_size += batch_data_payload_size(&src->entries[i].data);
+    }
+    anjay_batch_t *batch = (anjay_batch_t *) avs_malloc(
+            sizeof(anjay_batch_t)
+            + src->entry_count * sizeof(anjay_batch_entry_t) + payload_size);
     if (!batch) {
         return NULL;
     }
-    batch->list = (*builder)->list;
     batch->ref_count = 1;
     batch->compilation_time = avs_time_real_now();
-    avs_free(*builder);
-    *builder = NULL;
+    batch->entry_count = src->entry_count;
+    char *payload = (char *) &batch->entries[batch->entry_count];
+    for (size_t i = 0; i < batch->entry_count; ++i) {
+        batch->entries[i] = src->entries[i];
+        payload = batch_data_relocate_payload(&batch->entries[i].data, payload);
+    }
+    _anjay_batch_builder_cleanup(builder);
     return batch;
 }
 
@@ -377,7 +474,6 @@ void _anjay_batch_release(anjay_batch_t **batch) {
 #    endif // ANJAY_WITH_THREAD_SAFETY
 
     if (old_count <= 1) {
-        _anjay_batch_entry_list_cleanup(&(*batch)->list);
         avs_free(*batch);
     }
     *batch = NULL;
@@ -387,10 +483,9 @@ void _anjay_batch_release(anjay_batch_t **batch) {
 void _anjay_batch_update_common_path_prefix(const anjay_uri_path_t **prefix_ptr,
                                             anjay_uri_path_t *prefix_buf,
                                             const anjay_batch_t *batch) {
-    AVS_LIST(anjay_batch_entry_t) element;
-    AVS_LIST_FOREACH(element, batch->list) {
+    for (size_t i = 0; i < batch->entry_count; ++i) {
         _anjay_uri_path_update_common_prefix(prefix_ptr, prefix_buf,
-                                             &element->path);
+                                             &batch->entries[i].path);
     }
 }
 #    endif // ANJAY_WITH_LWM2M11
@@ -434,12 +529,10 @@ static int bytes_begin(anjay_unlocked_output_ctx_t *ctx_,
         return -1;
     }
 
+    anjay_batch_builder_mark_t mark = _anjay_batch_builder_mark(ctx->builder);
     void *buf = NULL;
-    if (length) {
-        buf = avs_malloc(length);
-        if (!buf) {
-            return -1;
-        }
+    if (length && !(buf = arena_alloc(ctx->builder, length))) {
+        return -1;
     }
 
     anjay_batch_data_t data = {
@@ -451,7 +544,7 @@ static int bytes_begin(anjay_unlocked_output_ctx_t *ctx_,
     };
 
     if (batch_data_add(ctx->builder, &ctx->path, ctx->timestamp, data)) {
-        avs_free(buf);
+        _anjay_batch_builder_rollback(ctx->builder, mark);
         return -1;
     }
 
@@ -653,14 +746,13 @@ int _anjay_dm_read_into_batch(anjay_batch_builder_t *builder,
            || path_info->uri.ids[ANJAY_ID_OID]
                       == _anjay_dm_installed_object_oid(obj));
 
-    AVS_LIST(anjay_batch_entry_t) *initial_append_ptr = builder->append_ptr;
+    anjay_batch_builder_mark_t mark = _anjay_batch_builder_mark(builder);
     int result = read_into_batch(builder, anjay, obj, path_info,
                                  requesting_ssid, forced_timestamp);
 
     // Despite of failure, the new element may be added. Remove it.
     if (result) {
-        builder->append_ptr = initial_append_ptr;
-        _anjay_batch_entry_list_cleanup(builder->append_ptr);
+        _anjay_batch_builder_rollback(builder, mark);
     }
     return result;
 }
@@ -767,14 +859,15 @@ int _anjay_batch_data_output_entry(
         const anjay_batch_data_output_state_t **state,
         anjay_unlocked_output_ctx_t *out_ctx) {
     assert(state);
-    AVS_LIST(const anjay_batch_entry_t) it;
+    const anjay_batch_entry_t *const end = batch->entries + batch->entry_count;
+    const anjay_batch_entry_t *it;
     if (!*state) {
-        it = batch->list;
+        it = batch->entries;
     } else {
         it = &(*state)->entry;
-        assert(AVS_LIST_FIND_PTR(&batch->list, it) != NULL);
+        assert(it >= batch->entries && it < end);
     }
-    while (it
+    while (it < end
            && !_anjay_instance_action_allowed(
                       anjay,
                       &(const anjay_action_info_t) {
@@ -786,14 +879,16 @@ int _anjay_batch_data_output_entry(
                           .ssid = target_ssid,
                           .action = ANJAY_ACTION_READ
                       })) {
-        AVS_LIST_ADVANCE((AVS_LIST(anjay_batch_entry_t) *) (intptr_t) &it);
+        ++it;
     }
     int result = 0;
-    if (it) {
+    if (it < end) {
         result = serialize_batch_entry(it, serialization_time, out_ctx);
-        AVS_LIST_ADVANCE((AVS_LIST(anjay_batch_entry_t) *) (intptr_t) &it);
+        ++it;
     }
-    *state = AVS_CONTAINER_OF(it, anjay_batch_data_output_state_t, entry);
+    *state = it < end ? AVS_CONTAINER_OF(it, anjay_batch_data_output_state_t,
+                                         entry)
+                      : NULL;
     return result;
 }
 
@@ -832,26 +927,26 @@ bool _anjay_batch_values_equal(const anjay_batch_t *a, const anjay_batch_t *b) {
     if (!a || !b) {
         return !a && !b;
     }
-    AVS_LIST(anjay_batch_entry_t) ait = a->list;
-    AVS_LIST(anjay_batch_entry_t) bit = b->list;
-    while (ait && bit) {
-        if (!_anjay_uri_path_equal(&ait->path, &bit->path)
-                || !batch_data_equal(&ait->data, &bit->data)) {
+    if (a->entry_count != b->entry_count) {
+        return false;
+    }
+    for (size_t i = 0; i < a->entry_count; ++i) {
+        if (!_anjay_uri_path_equal(&a->entries[i].path, &b->entries[i].path)
+                || !batch_data_equal(&a->entries[i].data,
+                                     &b->entries[i].data)) {
             return false;
         }
-        AVS_LIST_ADVANCE(&ait);
-        AVS_LIST_ADVANCE(&bit);
     }
-    return !ait && !bit;
+    return true;
 }
 
 bool _anjay_batch_data_requires_hierarchical_format(
         const anjay_batch_t *batch) {
-    if (!batch || !batch->list || AVS_LIST_NEXT(batch->list)) {
+    if (!batch || batch->entry_count != 1) {
         // entry list is not exactly 1 element long
         return true;
     }
-    const anjay_batch_entry_t *const entry = batch->list;
+    const anjay_batch_entry_t *const entry = &batch->entries[0];
     if (entry->data.type == ANJAY_BATCH_DATA_START_AGGREGATE) {
         // batch consists of an empty aggregate, so isn't a single simple value
         return true;
@@ -866,8 +961,8 @@ int _anjay_batch_outputable_item_count(anjay_unlocked_t *anjay,
                                        size_t *out_count) {
     size_t count = 0;
     if (batch) {
-        AVS_LIST(anjay_batch_entry_t) it;
-        AVS_LIST_FOREACH(it, batch->list) {
+        for (size_t i = 0; i < batch->entry_count; ++i) {
+            const anjay_batch_entry_t *it = &batch->entries[i];
             anjay_instance_action_allowed_stateless_result_t result =
                     _anjay_instance_action_allowed_stateless(
                             anjay,
@@ -901,7 +996,7 @@ double _anjay_batch_data_numeric_value(const anjay_batch_t *batch) {
         // not a simple value
         return NAN;
     }
-    const anjay_batch_entry_t *const entry = batch->list;
+    const anjay_batch_entry_t *const entry = &batch->entries[0];
     switch (entry->data.type) {
     case ANJAY_BATCH_DATA_INT:
         return (double) entry->data.value.int_value;
@@ -922,7 +1017,7 @@ int _anjay_batch_data_boolean_value(const anjay_batch_t *batch,
         // not a simple value
         return -1;
     }
-    const anjay_batch_entry_t *const entry = batch->list;
+    const anjay_batch_entry_t *const entry = &batch->entries[0];
     if (entry->data.type == ANJAY_BATCH_DATA_BOOL) {
         if (out_value) {
             *out_value = entry->data.value.bool_value;
@@ -27,11 +27,34 @@ VISIBILITY_PRIVATE_HEADER_BEGIN
 
 typedef struct anjay_batch_entry anjay_batch_entry_t;
 
+typedef struct anjay_batch_arena_chunk anjay_batch_arena_chunk_t;
+
 typedef struct anjay_batch_builder_struct {
-    AVS_LIST(anjay_batch_entry_t) list;
-    AVS_LIST(anjay_batch_entry_t) *append_ptr;
+    /**
+     * Entries added so far, stored contiguously. The array is grown
+     * geometrically, so adding N entries costs O(log N) reallocations.
+     */
+    anjay_batch_entry_t *entries;
+    size_t entry_count;
+    size_t entry_capacity;
+    /**
+     * Bump allocator for string and bytes payloads. The most recently
+     * allocated chunk is at the head of the list. Chunks are never moved, so
+     * entries may refer to the payloads directly.
+     */
+    AVS_LIST(anjay_batch_arena_chunk_t) arena;
 } anjay_batch_builder_t;
 
+/**
+ * Position in the batch builder, as returned by @ref _anjay_batch_builder_mark
+ * and accepted by @ref _anjay_batch_builder_rollback.
+ */
+typedef struct {
+    size_t entry_count;
+    anjay_batch_arena_chunk_t *arena_head;
+    size_t arena_head_used;
+} anjay_batch_builder_mark_t;
+
 typedef struct anjay_batch_struct anjay_batch_t;
 
 typedef struct anjay_batch_data_output_state_struct
@@ -99,6 +122,9 @@ void _anjay_batch_builder_cleanup(anjay_batch_builder_t **builder);
  * Compiles data from the batch builder into a reference-counted (with count
  * initialized to 1) immutable data batch.
  *
+ * The batch, all its entries and their payloads are stored in a single memory
+ * block, so that releasing the last reference costs just one deallocation.
+ *
  * @param builder Pointer to pointer to batch builder. Set to NULL after
  *                successful return.
  *
@@ -130,7 +156,19 @@ anjay_batch_t *_anjay_batch_acquire(const anjay_batch_t *batch);
  */
 void _anjay_batch_release(anjay_batch_t **batch);
 
-void _anjay_batch_entry_list_cleanup(AVS_LIST(anjay_batch_entry_t) *list);
+/**
+ * Returns the current position in the batch builder, that can later be passed
+ * to @ref _anjay_batch_builder_rollback.
+ */
+anjay_batch_builder_mark_t
+_anjay_batch_builder_mark(const anjay_batch_builder_t *builder);
+
+/**
+ * Discards all entries added to the batch builder after @p mark was taken,
+ * along with their payloads.
+ */
+void _anjay_batch_builder_rollback(anjay_batch_builder_t *builder,
+                                   anjay_batch_builder_mark_t mark);
 
 int _anjay_dm_read_into_batch(anjay_batch_builder_t *builder,
                               anjay_unlocked_t *anjay,
@@ -16,6 +16,7 @@
 #    include <avsystem/commons/avs_utils.h>
 
 #    include "../anjay_io_core.h"
+#    include "../anjay_utils_private.h"
 #    include "../coap/anjay_content_format.h"
 #    include "anjay_base64_out.h"
 #    include "anjay_common.h"
@@ -136,8 +137,8 @@ static inline int maybe_write_time(json_encoder_t *ctx, double time_s) {
     if (!isnan(time_s)) {
         if (begin_pair(ctx, SENML_LABEL_TIME)
                 || avs_is_err(avs_stream_write_f(ctx->stream, "%s",
-                                                 AVS_DOUBLE_AS_STRING(time_s,
-                                                                      17)))) {
+                                                 ANJAY_DOUBLE_TO_STRING(
+                                                         time_s)))) {
             return -1;
         }
     }
@@ -221,7 +222,7 @@ static inline int maybe_write_basetime(json_encoder_t *ctx, double time_s) {
 
     if (begin_pair(ctx, SENML_LABEL_BASE_TIME)
             || avs_is_err(avs_stream_write_f(
-                       ctx->stream, "%s", AVS_DOUBLE_AS_STRING(time_s, 17)))) {
+                       ctx->stream, "%s", ANJAY_DOUBLE_TO_STRING(time_s)))) {
         return -1;
     }
     return 0;
@@ -336,14 +337,11 @@ static int encode_int(anjay_senml_like_encoder_t *ctx_, int64_t value) {
     return 0;
 }
 
-// Source of format specifiers:
-// https://randomascii.wordpress.com/2012/03/08/float-precisionfrom-zero-to-100-digits-2/
-
 static int encode_double(anjay_senml_like_encoder_t *ctx_, double value) {
     json_encoder_t *ctx = (json_encoder_t *) ctx_;
     if (begin_pair(ctx, SENML_LABEL_VALUE)
             || avs_is_err(avs_stream_write_f(
-                       ctx->stream, "%s", AVS_DOUBLE_AS_STRING(value, 17)))) {
+                       ctx->stream, "%s", ANJAY_DOUBLE_TO_STRING(value)))) {
         return -1;
     }
     return 0;
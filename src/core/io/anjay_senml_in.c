@@ -85,6 +85,10 @@ struct senml_in {
     bool value_read;
     /* Current basename set in the payload. */
     char basename[MAX_PATH_STRING_SIZE];
+    size_t basename_len;
+    /* `basename` already parsed as a path; valid only if `basename_parsed`. */
+    anjay_uri_path_t basename_path;
+    bool basename_parsed;
     /* A path which must be a prefix of the currently processed `path`. */
     anjay_uri_path_t base;
 
@@ -310,6 +314,29 @@ static int parse_id(uint16_t *out_id, const char **id_begin) {
     return 0;
 }
 
+/**
+ * Parses a sequence of "/<id>" segments and appends them to @p out_path, which
+ * is assumed to contain exactly @p curr_len IDs.
+ */
+static int parse_id_segments(anjay_uri_path_t *out_path,
+                             size_t curr_len,
+                             const char *input) {
+    for (const char *ch = input; *ch;) {
+        if (*ch++ != '/') {
+            return -1;
+        }
+        if (curr_len >= AVS_ARRAY_SIZE(out_path->ids)) {
+            LOG(DEBUG, _("absolute path is too long"));
+            return -1;
+        }
+        if (parse_id(&out_path->ids[curr_len], &ch)) {
+            return -1;
+        }
+        curr_len++;
+    }
+    return 0;
+}
+
 static int parse_absolute_path(anjay_uri_path_t *out_path, const char *input) {
     if (!*input || *input != '/') {
         return -1;
@@ -320,8 +347,8 @@ static int parse_absolute_path(anjay_uri_path_t *out_path, const char *input) {
         return 0;
     }
 
-    const char *ch;
 #    ifdef ANJAY_WITH_LWM2M_GATEWAY
+    const char *ch;
     bool is_prefix = false;
     size_t prefix_len = 0;
     for (ch = &input[1]; *ch != '/' && *ch; ch++, prefix_len++) {
@@ -339,21 +366,7 @@ static int parse_absolute_path(anjay_uri_path_t *out_path, const char *input) {
     }
 #    endif // ANJAY_WITH_LWM2M_GATEWAY
 
-    size_t curr_len = 0;
-    for (ch = input; *ch;) {
-        if (*ch++ != '/') {
-            return -1;
-        }
-        if (curr_len >= AVS_ARRAY_SIZE(out_path->ids)) {
-            LOG(DEBUG, _("absolute path is too long"));
-            return -1;
-        }
-        if (parse_id(&out_path->ids[curr_len], &ch)) {
-            return -1;
-        }
-        curr_len++;
-    }
-    return 0;
+    return parse_id_segments(out_path, 0, input);
 }
 
 static bool uri_path_outside_base(const anjay_uri_path_t *path,
@@ -368,18 +381,32 @@ static bool uri_path_outside_base(const anjay_uri_path_t *path,
     return _anjay_uri_path_outside_base(path, base);
 }
 
-static int parse_next_absolute_path(senml_in_t *in) {
-    char full_path[MAX_PATH_STRING_SIZE];
-    if (avs_simple_snprintf(full_path,
-                            sizeof(full_path),
-                            "%s%s",
-                            in->basename,
-                            in->entry->path)
-            < 0) {
+static int parse_entry_path(senml_in_t *in) {
+    const char *name = in->entry->path;
+    if (!in->basename_len) {
+        return parse_absolute_path(&in->path, name);
+    }
+    const size_t name_len = strlen(name);
+    if (in->basename_len + name_len >= MAX_PATH_STRING_SIZE) {
         LOG(DEBUG, _("basename + path is longer than a maximum path length"));
-        return ANJAY_ERR_BAD_REQUEST;
+        return -1;
     }
-    if (parse_absolute_path(&in->path, full_path)) {
+    // Large composite payloads usually set the basename once and then use
+    // short relative names, so avoid concatenating and re-parsing the basename
+    // for every entry whenever the result would be the same anyway.
+    if (in->basename_parsed && (!*name || *name == '/')) {
+        in->path = in->basename_path;
+        return parse_id_segments(&in->path,
+                                 _anjay_uri_path_length(&in->path), name);
+    }
+    char full_path[MAX_PATH_STRING_SIZE];
+    memcpy(full_path, in->basename, in->basename_len);
+    memcpy(full_path + in->basename_len, name, name_len + 1);
+    return parse_absolute_path(&in->path, full_path);
+}
+
+static int parse_next_absolute_path(senml_in_t *in) {
+    if (parse_entry_path(in)) {
         return ANJAY_ERR_BAD_REQUEST;
     }
     if (uri_path_outside_base(&in->path, &in->base)) {
@@ -495,6 +522,11 @@ static int parse_senml_basename(senml_in_t *in, bool *has_basename) {
     if (get_short_string(in, in->basename, sizeof(in->basename))) {
         return ANJAY_ERR_BAD_REQUEST;
     }
+    in->basename_len = strlen(in->basename);
+    // "/" is not a valid prefix of "/<id>" segments - "//1" is invalid
+    in->basename_parsed =
+            (in->basename_len > 1
+             && !parse_absolute_path(&in->basename_path, in->basename));
     return 0;
 }
 
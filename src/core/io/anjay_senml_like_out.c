@@ -39,6 +39,19 @@ typedef struct {
     const anjay_ret_bytes_ctx_vtable_t *vtable;
 } senml_bytes_t;
 
+/**
+ * The most recently generated SenML name. Subsequent records usually differ
+ * only in the trailing segments of their paths (e.g. consecutive Resource
+ * Instances), so the common leading segments are reused as they are, and only
+ * the differing ones are formatted again.
+ */
+typedef struct {
+    anjay_uri_path_t path;
+    size_t segment_count;
+    size_t segment_end[_ANJAY_URI_PATH_MAX_LENGTH + 1];
+    char buf[MAX_PATH_STRING_SIZE];
+} senml_name_cache_t;
+
 typedef struct senml_out_struct {
     anjay_unlocked_output_ctx_t base;
     anjay_senml_like_encoder_t *encoder;
@@ -48,75 +61,123 @@ typedef struct senml_out_struct {
     bool returning_bytes;
     bool basename_written;
     double timestamp;
+    senml_name_cache_t name_cache;
 } senml_out_t;
 
-static int path_to_string(const anjay_uri_path_t *path,
-                          size_t start_index,
-                          size_t end_index,
-                          char *dest,
-                          size_t size) {
+static size_t path_segment_count(const anjay_uri_path_t *path) {
+    size_t length = _anjay_uri_path_length(path);
+#    ifdef ANJAY_WITH_LWM2M_GATEWAY
+    length += (size_t) _anjay_uri_path_has_prefix(path);
+#    endif // ANJAY_WITH_LWM2M_GATEWAY
+    return length;
+}
+
+/**
+ * Writes "/<id>" to @p dest, without the terminating nullbyte.
+ *
+ * @returns Number of characters written.
+ */
+static size_t format_id_segment(char *dest, uint16_t id) {
+    char digits[sizeof("65535") - 1];
+    size_t length = 0;
+    do {
+        digits[length++] = (char) ('0' + id % 10);
+        id /= 10;
+    } while (id);
+    *dest++ = '/';
+    for (size_t i = 0; i < length; ++i) {
+        dest[i] = digits[length - 1 - i];
+    }
+    return length + 1;
+}
+
+/**
+ * Writes the @p index-th segment of @p path (counting the gateway prefix as
+ * the first one, if present) to @p dest, preceded by a slash and without the
+ * terminating nullbyte.
+ *
+ * @returns Number of characters written.
+ */
+static size_t format_segment(const anjay_uri_path_t *path,
+                             size_t index,
+                             char *dest) {
 #    ifdef ANJAY_WITH_LWM2M_GATEWAY
     if (_anjay_uri_path_has_prefix(path)) {
-        if (start_index == 0) {
-            int written_chars =
-                    avs_simple_snprintf(dest, size, "/%s", path->prefix);
-            if (written_chars < 0) {
-                return -1;
-            }
-            dest += written_chars;
-            size -= (size_t) written_chars;
-        } else {
-            start_index--;
+        if (index == 0) {
+            size_t prefix_length = strlen(path->prefix);
+            dest[0] = '/';
+            memcpy(dest + 1, path->prefix, prefix_length);
+            return prefix_length + 1;
         }
-        end_index--;
+        --index;
     }
 #    endif // ANJAY_WITH_LWM2M_GATEWAY
-    for (; start_index < end_index; start_index++) {
-        int written_chars = avs_simple_snprintf(dest, size, "/%" PRIu16,
-                                                path->ids[start_index]);
-        if (written_chars < 0) {
-            return -1;
-        }
-        dest += written_chars;
-        size -= (size_t) written_chars;
-    }
-    return 0;
+    return format_id_segment(dest, path->ids[index]);
 }
 
-static char *maybe_get_basename(senml_out_t *ctx, char *buf, size_t size) {
-    size_t base_path_length = _anjay_uri_path_length(&ctx->base_path);
+static bool segment_equal(const anjay_uri_path_t *left,
+                          const anjay_uri_path_t *right,
+                          size_t index) {
 #    ifdef ANJAY_WITH_LWM2M_GATEWAY
-    base_path_length += (size_t) _anjay_uri_path_has_prefix(&ctx->base_path);
+    bool has_prefix = _anjay_uri_path_has_prefix(left);
+    if (has_prefix != _anjay_uri_path_has_prefix(right)) {
+        return false;
+    }
+    if (has_prefix) {
+        if (index == 0) {
+            return _anjay_uri_path_prefix_equal(left, right);
+        }
+        --index;
+    }
 #    endif // ANJAY_WITH_LWM2M_GATEWAY
+    return left->ids[index] == right->ids[index];
+}
+
+static void path_to_string(const anjay_uri_path_t *path,
+                           size_t start_index,
+                           size_t end_index,
+                           char *dest) {
+    for (; start_index < end_index; ++start_index) {
+        dest += format_segment(path, start_index, dest);
+    }
+    *dest = '\0';
+}
+
+static char *maybe_get_basename(senml_out_t *ctx, char *buf) {
+    size_t base_path_length = path_segment_count(&ctx->base_path);
     char *retptr = NULL;
     if (!ctx->basename_written && base_path_length > 0) {
-        *buf = '\0';
-        int result =
-                path_to_string(&ctx->base_path, 0, base_path_length, buf, size);
-        AVS_ASSERT(result == 0, "buffer too small");
-        (void) result;
+        path_to_string(&ctx->base_path, 0, base_path_length, buf);
         retptr = buf;
     }
     return retptr;
 }
 
-static char *maybe_get_name(senml_out_t *ctx, char *buf, size_t size) {
-    size_t base_path_length = _anjay_uri_path_length(&ctx->base_path);
-    size_t path_length = _anjay_uri_path_length(&ctx->path);
-#    ifdef ANJAY_WITH_LWM2M_GATEWAY
-    base_path_length += (size_t) _anjay_uri_path_has_prefix(&ctx->base_path);
-    path_length += (size_t) _anjay_uri_path_has_prefix(&ctx->path);
-#    endif // ANJAY_WITH_LWM2M_GATEWAY
-    char *retptr = NULL;
-    if (path_length > base_path_length) {
-        *buf = '\0';
-        int result = path_to_string(&ctx->path, base_path_length, path_length,
-                                    buf, size);
-        AVS_ASSERT(result == 0, "buffer too small");
-        (void) result;
-        retptr = buf;
+static const char *maybe_get_name(senml_out_t *ctx) {
+    size_t base_path_length = path_segment_count(&ctx->base_path);
+    size_t path_length = path_segment_count(&ctx->path);
+    if (path_length <= base_path_length) {
+        return NULL;
     }
-    return retptr;
+    senml_name_cache_t *cache = &ctx->name_cache;
+    size_t count = path_length - base_path_length;
+    size_t reused = 0;
+    while (reused < count && reused < cache->segment_count
+           && segment_equal(&cache->path, &ctx->path,
+                            base_path_length + reused)) {
+        ++reused;
+    }
+    size_t offset = reused ? cache->segment_end[reused - 1] : 0;
+    for (size_t i = reused; i < count; ++i) {
+        offset += format_segment(&ctx->path, base_path_length + i,
+                                 cache->buf + offset);
+        assert(offset < sizeof(cache->buf));
+        cache->segment_end[i] = offset;
+    }
+    cache->buf[offset] = '\0';
+    cache->path = ctx->path;
+    cache->segment_count = count;
+    return cache->buf;
 }
 
 static int finish_ret_bytes(senml_out_t *ctx) {
@@ -140,10 +201,8 @@ static int element_begin(senml_out_t *ctx) {
     }
 
     char basename_buf[MAX_PATH_STRING_SIZE];
-    char name_buf[MAX_PATH_STRING_SIZE];
-    char *name = maybe_get_name(ctx, name_buf, sizeof(name_buf));
-    char *basename =
-            maybe_get_basename(ctx, basename_buf, sizeof(basename_buf));
+    const char *name = maybe_get_name(ctx);
+    char *basename = maybe_get_basename(ctx, basename_buf);
     ctx->basename_written = true;
     int result = _anjay_senml_like_element_begin(ctx->encoder, basename, name,
                                                  ctx->timestamp);
@@ -358,8 +417,7 @@ _anjay_output_senml_like_create(avs_stream_t *stream,
 #    ifdef ANJAY_WITH_LWM2M_JSON
     case AVS_COAP_FORMAT_OMA_LWM2M_JSON: {
         char basename_buf[MAX_PATH_STRING_SIZE];
-        char *basename =
-                maybe_get_basename(ctx, basename_buf, sizeof(basename_buf));
+        char *basename = maybe_get_basename(ctx, basename_buf);
         ctx->encoder = _anjay_lwm2m_json_encoder_new(stream, basename);
         ctx->basename_written = true;
         break;
@@ -111,11 +111,12 @@ static int text_ret_double(anjay_unlocked_output_ctx_t *ctx_, double value) {
     }
     // FIXME: The spec calls for a "decimal" representation, which, in my
     // understanding, excludes exponential representation.
-    // As printing floating-point numbers in C as pure decimal with sane
-    // precision is tricky, let's take the spec a bit loosely for now.
+    // ANJAY_DOUBLE_TO_STRING() uses plain decimal notation for all values that
+    // have a reasonably short exact representation, but very large or very
+    // small values may still be printed in the exponential notation.
     if (ctx->state == STATE_PATH_SET
             && avs_is_ok(avs_stream_write_f(ctx->stream, "%s",
-                                            AVS_DOUBLE_AS_STRING(value, 17)))) {
+                                            ANJAY_DOUBLE_TO_STRING(value)))) {
         ctx->state = STATE_FINISHED;
         return 0;
     }
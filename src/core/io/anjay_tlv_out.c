@@ -14,7 +14,6 @@
 #    include <assert.h>
 #    include <string.h>
 
-#    include <avsystem/commons/avs_list.h>
 #    include <avsystem/commons/avs_memory.h>
 #    include <avsystem/commons/avs_stream.h>
 #    include <avsystem/commons/avs_utils.h>
@@ -26,31 +25,30 @@
 
 VISIBILITY_SOURCE_BEGIN
 
-typedef struct {
-    tlv_id_type_t type;
-    uint16_t id;
-} tlv_id_t;
-
 #    define TLV_MAX_LENGTH ((1 << 24) - 1)
 
 typedef struct {
-    size_t data_length;
-    tlv_id_t id;
-    char data[];
-} tlv_entry_t;
+    char *data;
+    size_t size;
+    size_t capacity;
+} tlv_buffer_t;
 
 typedef struct {
     const anjay_ret_bytes_ctx_vtable_t *vtable;
     union {
-        char *buffer_ptr;
+        struct {
+            tlv_buffer_t *buffer;
+            size_t offset;
+        } buffered;
         avs_stream_t *stream;
     } output;
     size_t bytes_left;
 } tlv_bytes_t;
 
 typedef struct {
-    AVS_LIST(tlv_entry_t) entries;
-    AVS_LIST(tlv_entry_t) *next_entry_ptr;
+    // Offset in the buffer at which the header of the aggregate represented
+    // by this level starts. Only meaningful for levels above the root one.
+    size_t header_offset;
 
     // ID that will be used when serializing the next element.
     // ANJAY_ID_INVALID if it's not set.
@@ -72,6 +70,12 @@ typedef struct tlv_out_struct {
     anjay_uri_path_t root_path;
     tlv_out_level_t levels[_TLV_OUT_LEVEL_LIMIT];
     tlv_out_level_id_t level;
+
+    // Entries nested below the root level are serialized into this single
+    // buffer, which is reused for consecutive top-level aggregates. Headers of
+    // nested aggregates are written with a maximum-width length field first,
+    // and shrunk in place once the aggregate is finished.
+    tlv_buffer_t buffer;
 } tlv_out_t;
 
 static inline uint8_t u32_length(uint32_t value) {
@@ -130,6 +134,40 @@ static int write_header(avs_stream_t *stream,
     return 0;
 }
 
+static int write_header_to_memory(char *dst,
+                                  size_t dst_size,
+                                  tlv_id_type_t type,
+                                  uint16_t id,
+                                  size_t length,
+                                  size_t *out_header_size) {
+    avs_stream_outbuf_t outbuf = AVS_STREAM_OUTBUF_STATIC_INITIALIZER;
+    avs_stream_outbuf_set_buffer(&outbuf, dst, dst_size);
+    if (write_header((avs_stream_t *) &outbuf, type, id, length)) {
+        return -1;
+    }
+    if (out_header_size) {
+        *out_header_size = avs_stream_outbuf_offset(&outbuf);
+    }
+    return 0;
+}
+
+static char *buffer_grow(tlv_buffer_t *buffer, size_t length) {
+    assert(length > 0);
+    if (length > buffer->capacity - buffer->size) {
+        size_t new_capacity =
+                AVS_MAX(2 * buffer->capacity, buffer->size + length);
+        char *new_data = (char *) avs_realloc(buffer->data, new_capacity);
+        if (!new_data) {
+            return NULL;
+        }
+        buffer->data = new_data;
+        buffer->capacity = new_capacity;
+    }
+    char *result = buffer->data + buffer->size;
+    buffer->size += length;
+    return result;
+}
+
 static int get_root_level(const anjay_uri_path_t *root_path,
                           tlv_out_level_id_t *out) {
     switch (_anjay_uri_path_length(root_path)) {
@@ -172,33 +210,6 @@ static int get_current_level_value_type(tlv_out_t *ctx, tlv_id_type_t *out) {
     }
 }
 
-static int write_entry(avs_stream_t *stream,
-                       const tlv_id_t *id,
-                       const void *buf,
-                       size_t length) {
-    if (write_header(stream, id->type, id->id, length)
-            || avs_is_err(avs_stream_write(stream, buf, length))) {
-        return -1;
-    }
-    return 0;
-}
-
-static char *
-add_buffered_entry(tlv_out_t *ctx, tlv_id_type_t type, size_t length) {
-    tlv_entry_t *new_entry =
-            (tlv_entry_t *) AVS_LIST_NEW_BUFFER(sizeof(tlv_entry_t) + length);
-    if (!new_entry) {
-        return NULL;
-    }
-    new_entry->data_length = length;
-    new_entry->id.type = type;
-    new_entry->id.id = current_level(ctx)->next_id;
-    current_level(ctx)->next_id = ANJAY_ID_INVALID;
-    *current_level(ctx)->next_entry_ptr = new_entry;
-    AVS_LIST_ADVANCE_PTR(&current_level(ctx)->next_entry_ptr);
-    return new_entry->data;
-}
-
 static int streamed_bytes_append(anjay_unlocked_ret_bytes_ctx_t *ctx_,
                                  const void *data,
                                  size_t length);
@@ -241,8 +252,10 @@ static int buffered_bytes_append(anjay_unlocked_ret_bytes_ctx_t *ctx_,
         if (length > ctx->bytes_left) {
             retval = -1;
         } else {
-            memcpy(ctx->output.buffer_ptr, data, length);
-            ctx->output.buffer_ptr += length;
+            memcpy(ctx->output.buffered.buffer->data
+                           + ctx->output.buffered.offset,
+                   data, length);
+            ctx->output.buffered.offset += length;
         }
     }
     if (!retval) {
@@ -260,12 +273,23 @@ add_entry(tlv_out_t *ctx, tlv_id_type_t type, size_t length) {
         return NULL;
     }
     if (ctx->level > root_level) {
-        if ((out_level->bytes_ctx.output.buffer_ptr =
-                     add_buffered_entry(ctx, type, length))) {
+        const size_t entry_header_size =
+                header_size(out_level->next_id, length);
+        char *header = buffer_grow(&ctx->buffer, entry_header_size + length);
+        if (header
+                && !write_header_to_memory(header, entry_header_size, type,
+                                           out_level->next_id, length, NULL)) {
+            out_level->next_id = ANJAY_ID_INVALID;
             out_level->bytes_ctx.vtable = &BUFFERED_BYTES_VTABLE;
+            out_level->bytes_ctx.output.buffered.buffer = &ctx->buffer;
+            out_level->bytes_ctx.output.buffered.offset =
+                    (size_t) (header - ctx->buffer.data) + entry_header_size;
             out_level->bytes_ctx.bytes_left = length;
             return (anjay_unlocked_ret_bytes_ctx_t *) &out_level->bytes_ctx;
         }
+        if (header) {
+            ctx->buffer.size -= entry_header_size + length;
+        }
     } else {
         int retval =
                 write_header(ctx->stream, type, out_level->next_id, length);
@@ -367,7 +391,7 @@ static int tlv_ret_objlnk(anjay_unlocked_output_ctx_t *ctx,
     return _anjay_ret_bytes_unlocked(ctx, &portable, sizeof(portable));
 }
 
-static void tlv_slave_start(tlv_out_t *ctx);
+static int tlv_slave_start(tlv_out_t *ctx);
 
 static int tlv_slave_finish(tlv_out_t *ctx) {
     tlv_out_level_id_t root_level;
@@ -376,44 +400,59 @@ static int tlv_slave_finish(tlv_out_t *ctx) {
         AVS_UNREACHABLE("Already at root level of TLV structure");
         return -1;
     }
-    size_t data_size = 0;
-    {
-        tlv_entry_t *entry = NULL;
-        AVS_LIST_FOREACH(entry, current_level(ctx)->entries) {
-            data_size += header_size(entry->id.id, entry->data_length)
-                         + entry->data_length;
-        }
+    const size_t header_offset = current_level(ctx)->header_offset;
+    ctx->level = (tlv_out_level_id_t) (ctx->level - 1);
+
+    tlv_id_type_t type;
+    switch (ctx->level) {
+    case TLV_OUT_LEVEL_RID:
+        type = TLV_ID_RID_ARRAY;
+        break;
+    case TLV_OUT_LEVEL_IID:
+        type = TLV_ID_IID;
+        break;
+    default:
+        return -1;
     }
-    char *buffer = (char *) (data_size ? avs_malloc(data_size) : NULL);
-    int retval = ((!data_size || buffer) ? 0 : -1);
-    avs_stream_outbuf_t outbuf = AVS_STREAM_OUTBUF_STATIC_INITIALIZER;
-    avs_stream_outbuf_set_buffer(&outbuf, buffer, data_size);
-    AVS_LIST_CLEAR(&current_level(ctx)->entries) {
-        if (!retval) {
-            retval = write_entry((avs_stream_t *) &outbuf,
-                                 &current_level(ctx)->entries->id,
-                                 current_level(ctx)->entries->data,
-                                 current_level(ctx)->entries->data_length);
+    const uint16_t id = current_level(ctx)->next_id;
+    current_level(ctx)->next_id = ANJAY_ID_INVALID;
+    int retval = (current_level(ctx)->bytes_ctx.bytes_left ? -1 : 0);
+
+    if (ctx->level == root_level) {
+        // outermost aggregate - it is complete, so it can be streamed
+        assert(header_offset == 0);
+        const size_t length = ctx->buffer.size;
+        if (!retval
+                && (length > TLV_MAX_LENGTH
+                    || write_header(ctx->stream, type, id, length)
+                    || (length
+                        && avs_is_err(avs_stream_write(
+                                   ctx->stream, ctx->buffer.data, length))))) {
+            retval = -1;
         }
-    }
-    ctx->level = (tlv_out_level_id_t) (ctx->level - 1);
-    if (!retval) {
-        size_t length = avs_stream_outbuf_offset(&outbuf);
-        anjay_unlocked_ret_bytes_ctx_t *bytes = NULL;
-        switch (ctx->level) {
-        case TLV_OUT_LEVEL_RID:
-            bytes = add_entry(ctx, TLV_ID_RID_ARRAY, length);
-            break;
-        case TLV_OUT_LEVEL_IID:
-            bytes = add_entry(ctx, TLV_ID_IID, length);
-            break;
-        default:;
+        ctx->buffer.size = 0;
+    } else {
+        // nested aggregate - back-patch the header reserved in tlv_slave_start
+        const size_t reserved_size = header_size(id, TLV_MAX_LENGTH);
+        const size_t data_offset = header_offset + reserved_size;
+        assert(ctx->buffer.size >= data_offset);
+        const size_t length = ctx->buffer.size - data_offset;
+        size_t actual_size = 0;
+        if (!retval
+                && (length > TLV_MAX_LENGTH
+                    || write_header_to_memory(ctx->buffer.data + header_offset,
+                                              reserved_size, type, id, length,
+                                              &actual_size))) {
+            retval = -1;
+        }
+        if (retval) {
+            ctx->buffer.size = header_offset;
+        } else {
+            memmove(ctx->buffer.data + header_offset + actual_size,
+                    ctx->buffer.data + data_offset, length);
+            ctx->buffer.size = header_offset + actual_size + length;
         }
-        retval = !bytes ? -1
-                        : _anjay_ret_bytes_append_unlocked(bytes, buffer,
-                                                           length);
     }
-    avs_free(buffer);
     return retval;
 }
 
@@ -428,7 +467,7 @@ static int tlv_start_aggregate(anjay_unlocked_output_ctx_t *ctx_) {
             // Resource Instances - so we're starting the slave context that
             // will expect Resource Instance entries, or serialize to an empty
             // array if no Resource Instances will follow.
-            tlv_slave_start(ctx);
+            return tlv_slave_start(ctx);
         } else {
             AVS_ASSERT(_anjay_uri_path_leaf_is(&ctx->root_path, ANJAY_ID_IID),
                        "Called tlv_start_aggregate in inappropriate state");
@@ -452,7 +491,7 @@ static int tlv_start_aggregate(anjay_unlocked_output_ctx_t *ctx_) {
         // starting aggregate on the Instance level, i.e. an array of Resources
         // - so we're starting the slave context that will expect Resource
         // entries, or serialize to an empty array if no Resources will follow.
-        tlv_slave_start(ctx);
+        return tlv_slave_start(ctx);
     } else {
         AVS_UNREACHABLE("tlv_start_aggregate called in invalid state");
         return -1;
@@ -549,7 +588,9 @@ static int tlv_set_path(anjay_unlocked_output_ctx_t *ctx_,
                                        &ctx->levels[i].next_id))) {
             return result;
         }
-        tlv_slave_start(ctx);
+        if ((result = tlv_slave_start(ctx))) {
+            return result;
+        }
     }
     assert(ctx->level == AVS_MAX(new_level, lowest_level));
     if (new_level >= lowest_level) {
@@ -584,9 +625,8 @@ static int tlv_output_close(anjay_unlocked_output_ctx_t *ctx_) {
             _anjay_update_ret(&result, tlv_slave_finish(ctx));
         }
     }
-    for (uint8_t i = 0; i < AVS_ARRAY_SIZE(ctx->levels); ++i) {
-        AVS_LIST_CLEAR(&ctx->levels[i].entries);
-    }
+    avs_free(ctx->buffer.data);
+    ctx->buffer = (tlv_buffer_t) { NULL };
     return result;
 }
 
@@ -606,12 +646,26 @@ static const anjay_output_ctx_vtable_t TLV_OUT_VTABLE = {
     .close = tlv_output_close
 };
 
-static void tlv_slave_start(tlv_out_t *ctx) {
+static int tlv_slave_start(tlv_out_t *ctx) {
     assert((size_t) (ctx->level + 1) <= AVS_ARRAY_SIZE(ctx->levels));
+    tlv_out_level_id_t root_level;
+    if (get_root_level(&ctx->root_path, &root_level)) {
+        return -1;
+    }
+    const size_t header_offset = ctx->buffer.size;
+    if (ctx->level > root_level) {
+        // the actual length is not known yet, so reserve space for the
+        // longest possible header; see tlv_slave_finish()
+        if (!buffer_grow(&ctx->buffer,
+                         header_size(current_level(ctx)->next_id,
+                                     TLV_MAX_LENGTH))) {
+            return -1;
+        }
+    }
     ctx->level = (tlv_out_level_id_t) (ctx->level + 1);
-    assert(!current_level(ctx)->entries);
-    current_level(ctx)->next_entry_ptr = &current_level(ctx)->entries;
+    current_level(ctx)->header_offset = header_offset;
     current_level(ctx)->next_id = ANJAY_ID_INVALID;
+    return 0;
 }
 
 anjay_unlocked_output_ctx_t *
@@ -629,7 +683,6 @@ _anjay_output_tlv_create(avs_stream_t *stream, const anjay_uri_path_t *uri) {
     ctx->base.vtable = &TLV_OUT_VTABLE;
     ctx->stream = stream;
     ctx->root_path = *uri;
-    current_level(ctx)->next_entry_ptr = &current_level(ctx)->entries;
     current_level(ctx)->next_id = ANJAY_ID_INVALID;
     return (anjay_unlocked_output_ctx_t *) ctx;
 }
@@ -78,6 +78,8 @@ void _anjay_observe_init(anjay_observe_state_t *observe,
                          bool confirmable_notifications,
                          size_t stored_notification_limit) {
     assert(!observe->connection_entries);
+    // 0 is reserved for anjay_observe_attrs_cache_t entries never filled
+    observe->attrs_generation = 1;
     observe->confirmable_notifications = confirmable_notifications;
 
     if (stored_notification_limit == 0) {
@@ -114,12 +116,36 @@ path_entry_query(const anjay_uri_path_t *path) {
     return AVS_CONTAINER_OF(path, anjay_observe_path_entry_t, path);
 }
 
+static inline void root_path_of(anjay_uri_path_t *out_root_path,
+                                const anjay_uri_path_t *path) {
+    // NOTE: this copies the LwM2M Gateway prefix, if any
+    *out_root_path = *path;
+    for (size_t i = 0; i < AVS_ARRAY_SIZE(out_root_path->ids); ++i) {
+        out_root_path->ids[i] = ANJAY_ID_INVALID;
+    }
+}
+
+static inline bool
+path_entry_empty(const anjay_observe_path_entry_t *path_entry) {
+    return !path_entry->conn_entries
+           && (!path_entry->children
+               || !AVS_SORTED_SET_FIRST(path_entry->children));
+}
+
 static AVS_SORTED_SET_ELEM(anjay_observe_path_entry_t)
-find_or_create_observe_path_entry(anjay_observe_connection_entry_t *connection,
-                                  const anjay_uri_path_t *path) {
+find_or_create_observe_path_entry(
+        AVS_SORTED_SET(anjay_observe_path_entry_t) *set_ptr,
+        const anjay_uri_path_t *path) {
+    if (!*set_ptr
+            && !(*set_ptr = AVS_SORTED_SET_NEW(
+                         anjay_observe_path_entry_t,
+                         _anjay_observe_path_entry_cmp))) {
+        _anjay_log_oom();
+        return NULL;
+    }
+
     AVS_SORTED_SET_ELEM(anjay_observe_path_entry_t) entry =
-            AVS_SORTED_SET_FIND(connection->observed_paths,
-                                path_entry_query(path));
+            AVS_SORTED_SET_FIND(*set_ptr, path_entry_query(path));
     if (!entry) {
         AVS_SORTED_SET_ELEM(anjay_observe_path_entry_t) new_entry =
                 AVS_SORTED_SET_ELEM_NEW(anjay_observe_path_entry_t);
@@ -130,29 +156,135 @@ find_or_create_observe_path_entry(anjay_observe_connection_entry_t *connection,
 
         memcpy((void *) (intptr_t) (const void *) &new_entry->path, path,
                sizeof(*path));
-        entry = AVS_SORTED_SET_INSERT(connection->observed_paths, new_entry);
+        entry = AVS_SORTED_SET_INSERT(*set_ptr, new_entry);
         assert(entry == new_entry);
     }
     return entry;
 }
 
+static AVS_SORTED_SET_ELEM(anjay_observe_path_entry_t)
+find_observe_path_entry(anjay_observe_state_t *observe,
+                        const anjay_uri_path_t *path) {
+    anjay_uri_path_t node_path;
+    root_path_of(&node_path, path);
+    const size_t path_length = _anjay_uri_path_length(path);
+    AVS_SORTED_SET(anjay_observe_path_entry_t) set = observe->observed_paths;
+    for (size_t depth = 0; set; ++depth) {
+        AVS_SORTED_SET_ELEM(anjay_observe_path_entry_t) entry =
+                AVS_SORTED_SET_FIND(set, path_entry_query(&node_path));
+        if (!entry || depth == path_length) {
+            return entry;
+        }
+        node_path.ids[depth] = path->ids[depth];
+        set = entry->children;
+    }
+    return NULL;
+}
+
+/**
+ * Removes trie nodes on the way from <c>node_path</c> (which is at the given
+ * <c>depth</c>) to <c>path</c> that have neither any observations attached nor
+ * any children left.
+ */
+static void
+prune_observed_path(AVS_SORTED_SET(anjay_observe_path_entry_t) set,
+                    anjay_uri_path_t *node_path,
+                    const anjay_uri_path_t *path,
+                    size_t depth) {
+    AVS_SORTED_SET_ELEM(anjay_observe_path_entry_t) entry =
+            set ? AVS_SORTED_SET_FIND(set, path_entry_query(node_path)) : NULL;
+    if (!entry) {
+        return;
+    }
+    if (depth < _anjay_uri_path_length(path) && entry->children) {
+        node_path->ids[depth] = path->ids[depth];
+        prune_observed_path(entry->children, node_path, path, depth + 1);
+        if (!AVS_SORTED_SET_FIRST(entry->children)) {
+            AVS_SORTED_SET_DELETE(&entry->children);
+        }
+    }
+    if (path_entry_empty(entry)) {
+        if (entry->children) {
+            AVS_SORTED_SET_DELETE(&entry->children);
+        }
+        AVS_SORTED_SET_DELETE_ELEM(set, &entry);
+    }
+}
+
+static void prune_observed_paths(anjay_observe_state_t *observe,
+                                 const anjay_uri_path_t *path) {
+    anjay_uri_path_t node_path;
+    root_path_of(&node_path, path);
+    prune_observed_path(observe->observed_paths, &node_path, path, 0);
+}
+
+static AVS_LIST(anjay_observe_path_conn_entry_t) *
+find_path_conn_entry_ptr(anjay_observe_path_entry_t *observed_path,
+                         anjay_observe_connection_entry_t *conn) {
+    AVS_LIST(anjay_observe_path_conn_entry_t) *conn_entry_ptr;
+    AVS_LIST_FOREACH_PTR(conn_entry_ptr, &observed_path->conn_entries) {
+        if ((*conn_entry_ptr)->conn == conn) {
+            return conn_entry_ptr;
+        }
+    }
+    return NULL;
+}
+
+static AVS_LIST(anjay_observe_path_conn_entry_t)
+find_or_create_path_conn_entry(anjay_observe_path_entry_t *observed_path,
+                               anjay_observe_connection_entry_t *conn) {
+    AVS_LIST(anjay_observe_path_conn_entry_t) *conn_entry_ptr =
+            find_path_conn_entry_ptr(observed_path, conn);
+    if (conn_entry_ptr) {
+        return *conn_entry_ptr;
+    }
+    AVS_LIST(anjay_observe_path_conn_entry_t) conn_entry =
+            AVS_LIST_NEW_ELEMENT(anjay_observe_path_conn_entry_t);
+    if (!conn_entry) {
+        _anjay_log_oom();
+        return NULL;
+    }
+    memcpy((void *) (intptr_t) (const void *) &conn_entry->conn, &conn,
+           sizeof(conn));
+    AVS_LIST_INSERT(&observed_path->conn_entries, conn_entry);
+    return conn_entry;
+}
+
 static int add_path_to_observed_paths(
         anjay_observe_connection_entry_t *conn,
         const anjay_uri_path_t *path,
         AVS_SORTED_SET_ELEM(anjay_observation_t) observation) {
-    AVS_SORTED_SET_ELEM(anjay_observe_path_entry_t) observed_path =
-            find_or_create_observe_path_entry(conn, path);
-    if (!observed_path) {
-        return -1;
+    anjay_uri_path_t node_path;
+    root_path_of(&node_path, path);
+    const size_t path_length = _anjay_uri_path_length(path);
+    AVS_SORTED_SET(anjay_observe_path_entry_t) *set_ptr =
+            &conn->observe->observed_paths;
+    AVS_SORTED_SET_ELEM(anjay_observe_path_entry_t) observed_path = NULL;
+    for (size_t depth = 0;; ++depth) {
+        if (!(observed_path =
+                      find_or_create_observe_path_entry(set_ptr, &node_path))) {
+            prune_observed_paths(conn->observe, path);
+            return -1;
+        }
+        if (depth == path_length) {
+            break;
+        }
+        node_path.ids[depth] = path->ids[depth];
+        set_ptr = &observed_path->children;
     }
-    AVS_LIST(AVS_SORTED_SET_ELEM(anjay_observation_t)) entry =
-            AVS_LIST_INSERT_NEW(AVS_SORTED_SET_ELEM(anjay_observation_t),
-                                &observed_path->refs);
-    if (!entry) {
+
+    AVS_LIST(anjay_observe_path_conn_entry_t) conn_entry =
+            find_or_create_path_conn_entry(observed_path, conn);
+    AVS_LIST(AVS_SORTED_SET_ELEM(anjay_observation_t)) entry = NULL;
+    if (!conn_entry
+            || !(entry = AVS_LIST_INSERT_NEW(
+                         AVS_SORTED_SET_ELEM(anjay_observation_t),
+                         &conn_entry->refs))) {
         _anjay_log_oom();
-        if (!observed_path->refs) {
-            AVS_SORTED_SET_DELETE_ELEM(conn->observed_paths, &observed_path);
+        if (conn_entry && !conn_entry->refs) {
+            AVS_LIST_DELETE(find_path_conn_entry_ptr(observed_path, conn));
         }
+        prune_observed_paths(conn->observe, path);
         return -1;
     }
     *entry = observation;
@@ -164,15 +296,20 @@ static void remove_path_from_observed_paths(
         const anjay_uri_path_t *path,
         AVS_SORTED_SET_ELEM(anjay_observation_t) observation) {
     AVS_SORTED_SET_ELEM(anjay_observe_path_entry_t) observed_path =
-            AVS_SORTED_SET_FIND(conn->observed_paths, path_entry_query(path));
+            find_observe_path_entry(conn->observe, path);
     assert(observed_path);
+    AVS_LIST(anjay_observe_path_conn_entry_t) *conn_entry_ptr =
+            find_path_conn_entry_ptr(observed_path, conn);
+    assert(conn_entry_ptr);
     AVS_LIST(AVS_SORTED_SET_ELEM(anjay_observation_t)) *ref_ptr;
-    AVS_LIST_FOREACH_PTR(ref_ptr, &observed_path->refs) {
+    AVS_LIST_FOREACH_PTR(ref_ptr, &(*conn_entry_ptr)->refs) {
         if (**ref_ptr == observation) {
             AVS_LIST_DELETE(ref_ptr);
-            if (!observed_path->refs) {
-                AVS_SORTED_SET_DELETE_ELEM(conn->observed_paths,
-                                           &observed_path);
+            if (!(*conn_entry_ptr)->refs) {
+                AVS_LIST_DELETE(conn_entry_ptr);
+                if (!observed_path->conn_entries) {
+                    prune_observed_paths(conn->observe, path);
+                }
             }
             return;
         }
@@ -206,10 +343,195 @@ static void remove_from_observed_paths(
     }
 }
 
+/**
+ * Granularity of planned notification triggers, in nanoseconds. Triggers
+ * planned for the future are rounded up to a multiple of it, so that all
+ * observations of a connection that fall due within the same tick are handled
+ * in a single run of the trigger job. It needs to be a divisor of one second.
+ */
+#    define TRIGGER_TICK_NS 100000000
+
+static int trigger_bucket_cmp(const void *left, const void *right) {
+    const avs_time_monotonic_t left_time =
+            ((const anjay_observe_trigger_bucket_t *) left)->time;
+    const avs_time_monotonic_t right_time =
+            ((const anjay_observe_trigger_bucket_t *) right)->time;
+    if (avs_time_monotonic_before(left_time, right_time)) {
+        return -1;
+    } else if (avs_time_monotonic_before(right_time, left_time)) {
+        return 1;
+    }
+    return 0;
+}
+
+static inline const anjay_observe_trigger_bucket_t *
+trigger_bucket_query(const avs_time_monotonic_t *time) {
+    return AVS_CONTAINER_OF(time, anjay_observe_trigger_bucket_t, time);
+}
+
+static avs_time_monotonic_t
+round_up_to_trigger_tick(avs_time_monotonic_t time) {
+    int32_t remainder =
+            time.since_monotonic_epoch.nanoseconds % TRIGGER_TICK_NS;
+    if (remainder) {
+        time = avs_time_monotonic_add(
+                time, avs_time_duration_from_scalar(TRIGGER_TICK_NS - remainder,
+                                                    AVS_TIME_NS));
+    }
+    return time;
+}
+
+static void trigger_observe(avs_sched_t *sched, const void *conn_ref_ptr);
+
+static int update_trigger_task(anjay_observe_connection_entry_t *conn) {
+    AVS_SORTED_SET_ELEM(anjay_observe_trigger_bucket_t) first =
+            conn->trigger_buckets ? AVS_SORTED_SET_FIRST(conn->trigger_buckets)
+                                  : NULL;
+    if (!first) {
+        avs_sched_del(&conn->trigger_task);
+        return 0;
+    }
+    if (conn->trigger_task) {
+        const avs_time_monotonic_t task_time =
+                avs_sched_time(&conn->trigger_task);
+        if (!avs_time_monotonic_before(task_time, first->time)
+                && !avs_time_monotonic_before(first->time, task_time)) {
+            // already scheduled at the right time
+            return 0;
+        }
+    }
+    avs_sched_del(&conn->trigger_task);
+    return AVS_SCHED_AT(_anjay_from_server(conn->conn_ref.server)->sched,
+                        &conn->trigger_task, first->time, trigger_observe,
+                        &conn->conn_ref, sizeof(conn->conn_ref));
+}
+
+static void unplan_trigger(anjay_observe_connection_entry_t *conn,
+                           anjay_observation_t *observation) {
+    if (!avs_time_monotonic_valid(observation->trigger_time)) {
+        return;
+    }
+    assert(conn->trigger_buckets);
+    AVS_SORTED_SET_ELEM(anjay_observe_trigger_bucket_t) bucket =
+            AVS_SORTED_SET_FIND(conn->trigger_buckets,
+                                trigger_bucket_query(
+                                        &observation->trigger_time));
+    assert(bucket);
+    if (observation->trigger_prev) {
+        observation->trigger_prev->trigger_next = observation->trigger_next;
+    } else {
+        assert(bucket->first == observation);
+        bucket->first = observation->trigger_next;
+    }
+    if (observation->trigger_next) {
+        observation->trigger_next->trigger_prev = observation->trigger_prev;
+    } else {
+        assert(bucket->last == observation);
+        bucket->last = observation->trigger_prev;
+    }
+    observation->trigger_time = AVS_TIME_MONOTONIC_INVALID;
+    observation->trigger_prev = NULL;
+    observation->trigger_next = NULL;
+
+    if (!bucket->first) {
+        AVS_SORTED_SET_DELETE_ELEM(conn->trigger_buckets, &bucket);
+        if (!AVS_SORTED_SET_FIRST(conn->trigger_buckets)) {
+            avs_sched_del(&conn->trigger_task);
+        }
+    }
+}
+
+/**
+ * Plans the notification trigger for <c>observation</c> at <c>time</c>,
+ * replacing the previously planned one, if any.
+ */
+static int plan_trigger(anjay_observe_connection_entry_t *conn,
+                        anjay_observation_t *observation,
+                        avs_time_monotonic_t time) {
+    unplan_trigger(conn, observation);
+    if (!conn->trigger_buckets
+            && !(conn->trigger_buckets =
+                         AVS_SORTED_SET_NEW(anjay_observe_trigger_bucket_t,
+                                            trigger_bucket_cmp))) {
+        _anjay_log_oom();
+        return -1;
+    }
+
+    AVS_SORTED_SET_ELEM(anjay_observe_trigger_bucket_t) bucket =
+            AVS_SORTED_SET_FIND(conn->trigger_buckets,
+                                trigger_bucket_query(&time));
+    if (!bucket) {
+        AVS_SORTED_SET_ELEM(anjay_observe_trigger_bucket_t) new_bucket =
+                AVS_SORTED_SET_ELEM_NEW(anjay_observe_trigger_bucket_t);
+        if (!new_bucket) {
+            _anjay_log_oom();
+            return -1;
+        }
+        memcpy((void *) (intptr_t) (const void *) &new_bucket->time, &time,
+               sizeof(time));
+        bucket = AVS_SORTED_SET_INSERT(conn->trigger_buckets, new_bucket);
+        assert(bucket == new_bucket);
+    }
+
+    observation->trigger_time = time;
+    observation->trigger_prev = bucket->last;
+    if (bucket->last) {
+        bucket->last->trigger_next = observation;
+    } else {
+        bucket->first = observation;
+    }
+    bucket->last = observation;
+
+    int result = update_trigger_task(conn);
+    if (result) {
+        unplan_trigger(conn, observation);
+    }
+    return result;
+}
+
+/**
+ * Returns the number of observations whose triggers are planned no later than
+ * <c>now</c>.
+ */
+static size_t count_due_triggers(anjay_observe_connection_entry_t *conn,
+                                 avs_time_monotonic_t now) {
+    size_t result = 0;
+    if (conn->trigger_buckets) {
+        AVS_SORTED_SET_ELEM(anjay_observe_trigger_bucket_t) bucket;
+        AVS_SORTED_SET_FOREACH(bucket, conn->trigger_buckets) {
+            if (avs_time_monotonic_before(now, bucket->time)) {
+                break;
+            }
+            for (anjay_observation_t *observation = bucket->first; observation;
+                 observation = observation->trigger_next) {
+                ++result;
+            }
+        }
+    }
+    return result;
+}
+
+static anjay_observation_t *
+pop_due_trigger(anjay_observe_connection_entry_t *conn,
+                avs_time_monotonic_t now) {
+    AVS_SORTED_SET_ELEM(anjay_observe_trigger_bucket_t) first =
+            conn->trigger_buckets ? AVS_SORTED_SET_FIRST(conn->trigger_buckets)
+                                  : NULL;
+    if (!first || avs_time_monotonic_before(now, first->time)) {
+        return NULL;
+    }
+    anjay_observation_t *observation = first->first;
+    assert(observation);
+    unplan_trigger(conn, observation);
+    return observation;
+}
+
 static void clear_observation(anjay_observe_connection_entry_t *connection,
                               anjay_observation_t *observation) {
     anjay_unlocked_t *anjay = _anjay_from_server(connection->conn_ref.server);
-    avs_sched_del(&observation->notify_task);
+    unplan_trigger(connection, observation);
+    avs_free(observation->attrs_cache);
+    observation->attrs_cache = NULL;
     while (observation->last_sent) {
         delete_value(anjay, &observation->last_sent);
     }
@@ -241,10 +563,10 @@ detach_observation(anjay_observe_connection_entry_t *conn,
 static void
 cleanup_observation(anjay_observe_connection_entry_t *conn,
                     AVS_SORTED_SET_ELEM(anjay_observation_t) observation) {
-    if (conn->observed_paths) {
-        remove_from_observed_paths(conn, observation);
-    }
-    avs_sched_del(&observation->notify_task);
+    remove_from_observed_paths(conn, observation);
+    unplan_trigger(conn, observation);
+    avs_free(observation->attrs_cache);
+    observation->attrs_cache = NULL;
     if (observation->last_sent) {
         delete_value(_anjay_from_server(conn->conn_ref.server),
                      &observation->last_sent);
@@ -265,13 +587,14 @@ static void cleanup_connection_without_observations_set(
     AVS_SORTED_SET_FOREACH(observation, conn->observations) {
         cleanup_observation(conn, observation);
     }
-    if (conn->observed_paths) {
-        assert(!AVS_SORTED_SET_FIRST(conn->observed_paths));
-        AVS_SORTED_SET_DELETE(&conn->observed_paths);
-    }
     if (conn->flush_task) {
         avs_sched_del(&conn->flush_task);
     }
+    avs_sched_del(&conn->trigger_task);
+    if (conn->trigger_buckets) {
+        assert(!AVS_SORTED_SET_FIRST(conn->trigger_buckets));
+        AVS_SORTED_SET_DELETE(&conn->trigger_buckets);
+    }
 }
 
 void _anjay_observe_cleanup_connection(anjay_observe_connection_entry_t *conn) {
@@ -327,6 +650,10 @@ void _anjay_observe_cleanup(anjay_observe_state_t *observe) {
     AVS_LIST_CLEAR(&observe->connection_entries) {
         _anjay_observe_cleanup_connection(observe->connection_entries);
     }
+    if (observe->observed_paths) {
+        assert(!AVS_SORTED_SET_FIRST(observe->observed_paths));
+        AVS_SORTED_SET_DELETE(&observe->observed_paths);
+    }
 }
 
 static void
@@ -338,20 +665,12 @@ delete_connection(AVS_LIST(anjay_observe_connection_entry_t) *conn_ptr) {
 static void delete_connection_if_empty(
         AVS_LIST(anjay_observe_connection_entry_t) *conn_ptr) {
     if (!AVS_SORTED_SET_FIRST((*conn_ptr)->observations)) {
-        assert(!AVS_SORTED_SET_FIRST((*conn_ptr)->observed_paths));
         assert(!(*conn_ptr)->unsent);
         assert(!(*conn_ptr)->unsent_last);
         delete_connection(conn_ptr);
     }
 }
 
-typedef struct {
-    anjay_observe_connection_entry_t *conn_state;
-    anjay_observation_t *observation;
-} trigger_observe_args_t;
-
-static void trigger_observe(avs_sched_t *sched, const void *args_);
-
 static const anjay_observation_value_t *
 newest_value(const anjay_observation_t *observation) {
     if (observation->last_unsent) {
@@ -400,7 +719,11 @@ static int schedule_trigger(anjay_observe_connection_entry_t *conn_state,
 
     avs_time_monotonic_t trigger_instant_monotonic = avs_time_monotonic_add(
             monotonic_now, avs_time_real_diff(trigger_instant_real, real_now));
-    if (avs_time_monotonic_before(avs_sched_time(&observation->notify_task),
+    if (avs_time_monotonic_before(monotonic_now, trigger_instant_monotonic)) {
+        trigger_instant_monotonic =
+                round_up_to_trigger_tick(trigger_instant_monotonic);
+    }
+    if (avs_time_monotonic_before(observation->trigger_time,
                                   trigger_instant_monotonic)) {
         anjay_log(
                 LAZY_TRACE,
@@ -421,14 +744,7 @@ static int schedule_trigger(anjay_observe_connection_entry_t *conn_state,
             (long) trigger_instant_monotonic.since_monotonic_epoch.nanoseconds);
 
     int retval =
-            AVS_SCHED_AT(_anjay_from_server(conn_state->conn_ref.server)->sched,
-                         &observation->notify_task, trigger_instant_monotonic,
-                         trigger_observe,
-                         (&(const trigger_observe_args_t) {
-                             .conn_state = conn_state,
-                             .observation = observation
-                         }),
-                         sizeof(trigger_observe_args_t));
+            plan_trigger(conn_state, observation, trigger_instant_monotonic);
     if (retval) {
         anjay_log(ERROR,
                   _("Could not schedule automatic notification trigger, "
@@ -674,7 +990,7 @@ insert_new_value(anjay_observe_connection_entry_t *conn_state,
 static int insert_error(anjay_observe_connection_entry_t *conn_state,
                         anjay_observation_t *observation,
                         int outer_result) {
-    avs_sched_del(&observation->notify_task);
+    unplan_trigger(conn_state, observation);
     const anjay_msg_details_t details = {
         .msg_code = _anjay_make_error_response_code(outer_result),
         .format = AVS_COAP_FORMAT_NONE
@@ -691,22 +1007,17 @@ static int insert_error(anjay_observe_connection_entry_t *conn_state,
                    : 0;
 }
 
-static int get_effective_attrs(anjay_unlocked_t *anjay,
-                               anjay_dm_r_attributes_t *out_attrs,
-                               const anjay_uri_path_t *path,
-                               anjay_ssid_t ssid) {
-    const anjay_dm_t *dm;
-#    ifdef ANJAY_WITH_LWM2M_GATEWAY
-    if (_anjay_uri_path_has_prefix(path)) {
-        if (_anjay_lwm2m_gateway_prefix_to_dm(anjay, path->prefix, &dm)) {
-            return ANJAY_ERR_NOT_FOUND;
-        }
-    } else
-#    endif // ANJAY_WITH_LWM2M_GATEWAY
-    {
-        dm = &anjay->dm;
-    }
-    anjay_dm_attrs_query_details_t details = {
+/**
+ * Fills @p details for querying effective attributes of @p path. If any part
+ * of it is not present in the data model, the longest present prefix is used
+ * instead, and false is returned.
+ */
+static bool get_attrs_query_details(anjay_unlocked_t *anjay,
+                                    const anjay_dm_t *dm,
+                                    const anjay_uri_path_t *path,
+                                    anjay_ssid_t ssid,
+                                    anjay_dm_attrs_query_details_t *details) {
+    *details = (anjay_dm_attrs_query_details_t) {
         .obj = _anjay_uri_path_has(path, ANJAY_ID_OID)
                        ? _anjay_dm_find_object_by_oid(dm,
                                                       path->ids[ANJAY_ID_OID])
@@ -718,30 +1029,121 @@ static int get_effective_attrs(anjay_unlocked_t *anjay,
         .with_server_level_attrs = true
     };
 
-    if (details.obj && _anjay_uri_path_has(path, ANJAY_ID_IID)
-            && !_anjay_dm_verify_instance_present(anjay, details.obj,
+    if (details->obj && _anjay_uri_path_has(path, ANJAY_ID_IID)
+            && !_anjay_dm_verify_instance_present(anjay, details->obj,
                                                   path->ids[ANJAY_ID_IID])) {
-        details.iid = path->ids[ANJAY_ID_IID];
+        details->iid = path->ids[ANJAY_ID_IID];
     } else {
-        return _anjay_dm_effective_attrs(anjay, &details, out_attrs);
+        return (details->obj || !_anjay_uri_path_has(path, ANJAY_ID_OID))
+               && !_anjay_uri_path_has(path, ANJAY_ID_IID);
     }
 
     if (_anjay_uri_path_has(path, ANJAY_ID_RID)
             && !_anjay_dm_verify_resource_present(
-                       anjay, details.obj, path->ids[ANJAY_ID_IID],
+                       anjay, details->obj, path->ids[ANJAY_ID_IID],
                        path->ids[ANJAY_ID_RID], NULL)) {
-        details.rid = path->ids[ANJAY_ID_RID];
+        details->rid = path->ids[ANJAY_ID_RID];
     } else {
-        return _anjay_dm_effective_attrs(anjay, &details, out_attrs);
+        return !_anjay_uri_path_has(path, ANJAY_ID_RID);
     }
 
     if (_anjay_uri_path_has(path, ANJAY_ID_RIID)
             && !_anjay_dm_verify_resource_instance_present(
-                       anjay, details.obj, path->ids[ANJAY_ID_IID],
+                       anjay, details->obj, path->ids[ANJAY_ID_IID],
                        path->ids[ANJAY_ID_RID], path->ids[ANJAY_ID_RIID])) {
-        details.riid = path->ids[ANJAY_ID_RIID];
+        details->riid = path->ids[ANJAY_ID_RIID];
     }
-    return _anjay_dm_effective_attrs(anjay, &details, out_attrs);
+    return details->riid != ANJAY_ID_INVALID
+           || !_anjay_uri_path_has(path, ANJAY_ID_RIID);
+}
+
+static bool
+implements_any_attrs_handlers(const anjay_dm_installed_object_t *obj) {
+    return _anjay_dm_handler_implemented(
+                   obj, ANJAY_DM_HANDLER_object_read_default_attrs)
+           || _anjay_dm_handler_implemented(
+                      obj, ANJAY_DM_HANDLER_instance_read_default_attrs)
+           || _anjay_dm_handler_implemented(
+                      obj, ANJAY_DM_HANDLER_resource_read_attrs)
+#    ifdef ANJAY_WITH_LWM2M11
+           || _anjay_dm_handler_implemented(
+                      obj, ANJAY_DM_HANDLER_resource_instance_read_attrs)
+#    endif // ANJAY_WITH_LWM2M11
+            ;
+}
+
+/**
+ * Resolves effective attributes of @p path. @p out_cacheable is set to true
+ * if they may be reused until anjay_observe_state_t::attrs_generation changes.
+ * That is not the case if the path is not fully present in the data model
+ * (presence of Resources is not tracked), or if the Object implements its own
+ * attribute handlers (Anjay cannot tell when these change).
+ */
+static int get_effective_attrs(anjay_unlocked_t *anjay,
+                               anjay_dm_r_attributes_t *out_attrs,
+                               const anjay_uri_path_t *path,
+                               anjay_ssid_t ssid,
+                               bool *out_cacheable) {
+    *out_cacheable = false;
+    const anjay_dm_t *dm;
+#    ifdef ANJAY_WITH_LWM2M_GATEWAY
+    if (_anjay_uri_path_has_prefix(path)) {
+        if (_anjay_lwm2m_gateway_prefix_to_dm(anjay, path->prefix, &dm)) {
+            return ANJAY_ERR_NOT_FOUND;
+        }
+    } else
+#    endif // ANJAY_WITH_LWM2M_GATEWAY
+    {
+        dm = &anjay->dm;
+    }
+    anjay_dm_attrs_query_details_t details;
+    bool path_present =
+            get_attrs_query_details(anjay, dm, path, ssid, &details);
+    int result = _anjay_dm_effective_attrs(anjay, &details, out_attrs);
+    *out_cacheable = !result && path_present && details.obj
+                     && !implements_any_attrs_handlers(details.obj);
+    return result;
+}
+
+/**
+ * Variant of get_effective_attrs() that reuses attributes stored in @p cache,
+ * unless anjay_observe_state_t::attrs_generation has changed since they were
+ * resolved. @p cache may be NULL, in which case nothing is cached.
+ */
+static int get_effective_attrs_cached(anjay_unlocked_t *anjay,
+                                      anjay_observe_attrs_cache_t *cache,
+                                      anjay_dm_r_attributes_t *out_attrs,
+                                      const anjay_uri_path_t *path,
+                                      anjay_ssid_t ssid) {
+    if (cache && cache->generation == anjay->observe.attrs_generation) {
+        *out_attrs = cache->attrs;
+        return 0;
+    }
+    bool cacheable;
+    int result = get_effective_attrs(anjay, out_attrs, path, ssid, &cacheable);
+    if (cache && cacheable) {
+        cache->attrs = *out_attrs;
+        cache->generation = anjay->observe.attrs_generation;
+    }
+    return result;
+}
+
+static anjay_observe_attrs_cache_t *
+observation_attrs_cache(anjay_observation_t *observation, size_t path_idx) {
+    assert(path_idx < observation->paths_count);
+    if (!observation->attrs_cache
+            && !(observation->attrs_cache =
+                         (anjay_observe_attrs_cache_t *) avs_calloc(
+                                 observation->paths_count,
+                                 sizeof(anjay_observe_attrs_cache_t)))) {
+        // not fatal - attributes will just be resolved each time
+        return NULL;
+    }
+    return &observation->attrs_cache[path_idx];
+}
+
+void _anjay_observe_attrs_changed(anjay_unlocked_t *anjay) {
+    ++anjay->observe.attrs_generation;
 }
 
 static inline bool is_pmax_valid(anjay_dm_oi_attributes_t attr) {
@@ -795,8 +1197,9 @@ int _anjay_observe_schedule_pmax_trigger(
 #    endif // ANJAY_WITH_OBSERVATION_ATTRIBUTES
         for (size_t i = 0; i < observation->paths_count; ++i) {
             anjay_dm_r_attributes_t attrs;
-            int result = get_effective_attrs(
-                    _anjay_from_server(conn_state->conn_ref.server), &attrs,
+            int result = get_effective_attrs_cached(
+                    _anjay_from_server(conn_state->conn_ref.server),
+                    observation_attrs_cache(observation, i), &attrs,
                     &observation->paths[i],
                     _anjay_server_ssid(conn_state->conn_ref.server));
             if (result) {
@@ -888,6 +1291,7 @@ create_detached_observation(const avs_coap_token_t *token,
         memcpy((void *) (intptr_t) (const void *) &new_observation->paths[0],
                paths->paths, sizeof(*paths->paths));
     }
+    new_observation->trigger_time = AVS_TIME_MONOTONIC_INVALID;
     new_observation->next_pmax_trigger = AVS_TIME_REAL_INVALID;
 #    ifdef ANJAY_WITH_LWM2M12
     new_observation->historical_queue_size = -1;
@@ -926,10 +1330,7 @@ find_or_create_connection_state(anjay_connection_ref_t ref) {
     if (!*conn_ptr || connection_ref_cmp(&(*conn_ptr)->conn_ref, &ref) != 0) {
         if (!AVS_LIST_INSERT_NEW(anjay_observe_connection_entry_t, conn_ptr)
                 || !((*conn_ptr)->observations = AVS_SORTED_SET_NEW(
-                             anjay_observation_t, _anjay_observation_cmp))
-                || !((*conn_ptr)->observed_paths = AVS_SORTED_SET_NEW(
-                             anjay_observe_path_entry_t,
-                             _anjay_observe_path_entry_cmp))) {
+                             anjay_observation_t, _anjay_observation_cmp))) {
             _anjay_log_oom();
             if (*conn_ptr) {
                 AVS_SORTED_SET_DELETE(&(*conn_ptr)->observations);
@@ -939,6 +1340,10 @@ find_or_create_connection_state(anjay_connection_ref_t ref) {
         }
         memcpy((void *) (intptr_t) (const void *) &(*conn_ptr)->conn_ref, &ref,
                sizeof(ref));
+        anjay_observe_state_t *observe =
+                &_anjay_from_server(ref.server)->observe;
+        memcpy((void *) (intptr_t) (const void *) &(*conn_ptr)->observe,
+               &observe, sizeof(observe));
         (*conn_ptr)->next_trigger = AVS_TIME_REAL_INVALID;
         (*conn_ptr)->next_pmax_trigger = AVS_TIME_REAL_INVALID;
     }
@@ -949,7 +1354,7 @@ static int schedule_all_triggers(anjay_observe_connection_entry_t *conn) {
     int result = 0;
     AVS_SORTED_SET_ELEM(anjay_observation_t) observation;
     AVS_SORTED_SET_FOREACH(observation, conn->observations) {
-        if (!observation->notify_task) {
+        if (!avs_time_monotonic_valid(observation->trigger_time)) {
             _anjay_update_ret(&result, _anjay_observe_schedule_pmax_trigger(
                                                conn, observation));
         }
@@ -1027,10 +1432,8 @@ recalculate_conn_trigger_times(anjay_observe_connection_entry_t *conn) {
             conn->next_pmax_trigger = observation->next_pmax_trigger;
         }
         avs_time_real_t next_trigger = avs_time_real_add(
-                real_now,
-                avs_time_monotonic_diff(avs_sched_time(
-                                                &observation->notify_task),
-                                        monotonic_now));
+                real_now, avs_time_monotonic_diff(observation->trigger_time,
+                                                  monotonic_now));
         if (avs_time_real_valid(next_trigger)
                 && !avs_time_real_before(conn->next_trigger, next_trigger)) {
             conn->next_trigger = next_trigger;
@@ -1376,6 +1779,90 @@ static int read_observation_path(anjay_unlocked_t *anjay,
     return result;
 }
 
+typedef struct {
+    const anjay_uri_path_t path;
+    const anjay_request_action_t action;
+    anjay_batch_t *batch;
+} observe_read_cache_entry_t;
+
+/**
+ * Values read from the data model during a single run of trigger_observe().
+ * Observations that include the same path share the same batch, so that each
+ * path is read at most once per run.
+ */
+typedef struct {
+    avs_time_real_t timestamp;
+    AVS_SORTED_SET(observe_read_cache_entry_t) entries;
+} observe_read_cache_t;
+
+static int observe_read_cache_entry_cmp(const void *left_,
+                                        const void *right_) {
+    const observe_read_cache_entry_t *left =
+            (const observe_read_cache_entry_t *) left_;
+    const observe_read_cache_entry_t *right =
+            (const observe_read_cache_entry_t *) right_;
+    int result = _anjay_uri_path_compare(&left->path, &right->path);
+    if (!result) {
+        result = (int) left->action - (int) right->action;
+    }
+    return result;
+}
+
+static void observe_read_cache_cleanup(observe_read_cache_t *cache) {
+    if (cache->entries) {
+        AVS_SORTED_SET_DELETE(&cache->entries) {
+            _anjay_batch_release(&(*cache->entries)->batch);
+        }
+    }
+}
+
+static int read_observation_path_cached(anjay_unlocked_t *anjay,
+                                        observe_read_cache_t *cache,
+                                        const anjay_uri_path_t *path,
+                                        anjay_request_action_t action,
+                                        anjay_ssid_t connection_ssid,
+                                        anjay_batch_t **out_batch) {
+    assert(out_batch && !*out_batch);
+    if (!cache->entries
+            && !(cache->entries =
+                         AVS_SORTED_SET_NEW(observe_read_cache_entry_t,
+                                            observe_read_cache_entry_cmp))) {
+        _anjay_log_oom();
+        return -1;
+    }
+
+    AVS_SORTED_SET_ELEM(observe_read_cache_entry_t) entry =
+            AVS_SORTED_SET_FIND(cache->entries,
+                                &(const observe_read_cache_entry_t) {
+                                    .path = *path,
+                                    .action = action
+                                });
+    if (entry) {
+        return (*out_batch = _anjay_batch_acquire(entry->batch)) ? 0 : -1;
+    }
+
+    int result = read_observation_path(anjay, path, action, connection_ssid,
+                                       &cache->timestamp, out_batch);
+    if (result) {
+        return result;
+    }
+    if (!(entry = AVS_SORTED_SET_ELEM_NEW(observe_read_cache_entry_t))) {
+        // not caching the value is not fatal
+        _anjay_log_oom();
+        return 0;
+    }
+    memcpy((void *) (intptr_t) (const void *) &entry->path, path,
+           sizeof(*path));
+    memcpy((void *) (intptr_t) (const void *) &entry->action, &action,
+           sizeof(action));
+    if (!(entry->batch = _anjay_batch_acquire(*out_batch))) {
+        AVS_SORTED_SET_ELEM_DELETE_DETACHED(&entry);
+        return 0;
+    }
+    AVS_SORTED_SET_INSERT(cache->entries, entry);
+    return 0;
+}
+
 static int read_observation_values(anjay_unlocked_t *anjay,
                                    const paths_arg_t *paths,
                                    anjay_request_action_t action,
@@ -2035,7 +2522,8 @@ int _anjay_observe_sched_flush(anjay_connection_ref_t ref) {
 
 static int
 update_notification_value(anjay_observe_connection_entry_t *conn_state,
-                          anjay_observation_t *observation) {
+                          anjay_observation_t *observation,
+                          observe_read_cache_t *read_cache) {
     if (is_error_value(newest_value(observation))) {
         return 0;
     }
@@ -2057,7 +2545,7 @@ update_notification_value(anjay_observe_connection_entry_t *conn_state,
         return -1;
     }
 
-    const avs_time_real_t timestamp = avs_time_real_now();
+    const avs_time_real_t timestamp = read_cache->timestamp;
 
     int result = 0;
     for (size_t i = 0; i < observation->paths_count; ++i) {
@@ -2070,8 +2558,9 @@ update_notification_value(anjay_observe_connection_entry_t *conn_state,
             _anjay_dm_read_combined_server_attrs(anjay, ssid, &attrs.common);
         } else
 #    endif // ANJAY_WITH_OBSERVATION_ATTRIBUTES
-                if ((result = get_effective_attrs(
-                             anjay, &attrs, &observation->paths[i], ssid))) {
+                if ((result = get_effective_attrs_cached(
+                             anjay, observation_attrs_cache(observation, i),
+                             &attrs, &observation->paths[i], ssid))) {
             anjay_log(ERROR, _("Could not get attributes of path ") "%s",
                       ANJAY_DEBUG_MAKE_PATH(&observation->paths[i]));
             goto finish;
@@ -2091,9 +2580,9 @@ update_notification_value(anjay_observe_connection_entry_t *conn_state,
 
         if (has_epmin_expired(newest_value(observation)->values[i],
                               &attrs.common)) {
-            if ((result = read_observation_path(anjay, &observation->paths[i],
-                                                observation->action, ssid,
-                                                &timestamp, &batches[i]))) {
+            if ((result = read_observation_path_cached(
+                         anjay, read_cache, &observation->paths[i],
+                         observation->action, ssid, &batches[i]))) {
                 anjay_log(ERROR,
                           _("Could not read path ") "%s" _(" for notifying"),
                           ANJAY_DEBUG_MAKE_PATH(&observation->paths[i]));
@@ -2160,88 +2649,115 @@ finish:
     return result;
 }
 
-static void trigger_observe(avs_sched_t *sched, const void *args_) {
-    anjay_t *anjay_locked = _anjay_get_from_sched(sched);
-    ANJAY_MUTEX_LOCK(anjay, anjay_locked);
-    const trigger_observe_args_t *args = (const trigger_observe_args_t *) args_;
-    assert(args->conn_state);
-    assert(args->observation);
-    args->observation->next_pmax_trigger = AVS_TIME_REAL_INVALID;
-    recalculate_conn_trigger_times(args->conn_state);
+static void trigger_observation(anjay_observe_connection_entry_t *conn_state,
+                                anjay_observation_t *observation,
+                                observe_read_cache_t *read_cache) {
+    observation->next_pmax_trigger = AVS_TIME_REAL_INVALID;
+    recalculate_conn_trigger_times(conn_state);
     bool ready_for_notifying =
-            _anjay_connection_ready_for_outgoing_message(
-                    args->conn_state->conn_ref)
+            _anjay_connection_ready_for_outgoing_message(conn_state->conn_ref)
             && _anjay_socket_transport_is_online(
-                       _anjay_from_server(args->conn_state->conn_ref.server),
-                       _anjay_connection_transport(args->conn_state->conn_ref));
+                       _anjay_from_server(conn_state->conn_ref.server),
+                       _anjay_connection_transport(conn_state->conn_ref));
     if (!ready_for_notifying
             && _anjay_server_registration_expired(
-                       args->conn_state->conn_ref.server)) {
+                       conn_state->conn_ref.server)) {
         // Registration expired - notifications would be cleared at the time of
         // Register anyway, so we might as well do it here to conserve memory
-        _anjay_observe_invalidate(args->conn_state->conn_ref);
+        _anjay_observe_invalidate(conn_state->conn_ref);
     } else {
         if (ready_for_notifying
-                || notification_storing_enabled(args->conn_state->conn_ref)) {
-            int result = update_notification_value(args->conn_state,
-                                                   args->observation);
+                || notification_storing_enabled(conn_state->conn_ref)) {
+            int result = update_notification_value(conn_state, observation,
+                                                   read_cache);
             if (result) {
-                insert_error(args->conn_state, args->observation, result);
+                insert_error(conn_state, observation, result);
             }
         }
-        if (args->conn_state->unsent) {
+        if (conn_state->unsent) {
             if (ready_for_notifying
                     && !avs_coap_exchange_id_valid(
-                               args->conn_state->notify_exchange_id)) {
-                avs_sched_del(&args->conn_state->flush_task);
-                assert(!args->conn_state->flush_task);
-                if (_anjay_connection_get_online_socket(
-                            args->conn_state->conn_ref)) {
-                    flush_next_unsent(args->conn_state);
+                               conn_state->notify_exchange_id)) {
+                avs_sched_del(&conn_state->flush_task);
+                assert(!conn_state->flush_task);
+                if (_anjay_connection_get_online_socket(conn_state->conn_ref)) {
+                    flush_next_unsent(conn_state);
                 } else if (_anjay_server_registration_info(
-                                   args->conn_state->conn_ref.server)
+                                   conn_state->conn_ref.server)
                                    ->queue_mode) {
-                    _anjay_connection_bring_online(args->conn_state->conn_ref);
+                    _anjay_connection_bring_online(conn_state->conn_ref);
                     // once the connection is up, _anjay_observe_sched_flush()
                     // will be called; we're done here
                 } else if (!notification_storing_enabled(
-                                   args->conn_state->conn_ref)) {
-                    remove_all_unsent_values(args->conn_state);
+                                   conn_state->conn_ref)) {
+                    remove_all_unsent_values(conn_state);
                 }
             }
 #    ifdef ANJAY_WITH_LWM2M12
-            else if (args->observation->historical_queue_size == 0
-                     && notification_storing_enabled(
-                                args->conn_state->conn_ref)) {
-                remove_last_unsent_value_from_observation(args->conn_state,
-                                                          args->observation);
+            else if (observation->historical_queue_size == 0
+                     && notification_storing_enabled(conn_state->conn_ref)) {
+                remove_last_unsent_value_from_observation(conn_state,
+                                                          observation);
             }
 #    endif // ANJAY_WITH_LWM2M12
         }
     }
+}
+
+static void trigger_observe(avs_sched_t *sched, const void *conn_ref_ptr) {
+    anjay_t *anjay_locked = _anjay_get_from_sched(sched);
+    ANJAY_MUTEX_LOCK(anjay, anjay_locked);
+    const anjay_connection_ref_t conn_ref =
+            *(const anjay_connection_ref_t *) conn_ref_ptr;
+    AVS_LIST(anjay_observe_connection_entry_t) *conn_ptr =
+            _anjay_observe_find_connection_state(conn_ref);
+    assert(conn_ptr);
+    const avs_time_monotonic_t now = avs_time_monotonic_now();
+    observe_read_cache_t read_cache = {
+        .timestamp = avs_time_real_now()
+    };
+    // Triggers planned anew while handling the due ones are left for the next
+    // run of the job, even if they are due already.
+    size_t triggers_left = count_due_triggers(*conn_ptr, now);
+    anjay_observation_t *observation;
+    while (triggers_left-- > 0
+           && (observation = pop_due_trigger(*conn_ptr, now))) {
+        trigger_observation(*conn_ptr, observation, &read_cache);
+        // the connection entry might have been removed in the meantime
+        if (!(conn_ptr = _anjay_observe_find_connection_state(conn_ref))) {
+            break;
+        }
+    }
+    if (conn_ptr && update_trigger_task(*conn_ptr)) {
+        anjay_log(ERROR, _("Could not reschedule notification triggers"));
+    }
+    observe_read_cache_cleanup(&read_cache);
     ANJAY_MUTEX_UNLOCK(anjay_locked);
 }
 
 static anjay_dm_oi_attributes_t
-get_oi_attributes(anjay_observe_connection_entry_t *connection,
+get_oi_attributes(anjay_observe_path_conn_entry_t *conn_entry,
                   anjay_observe_path_entry_t *path_entry) {
+    anjay_observe_connection_entry_t *connection = conn_entry->conn;
     anjay_dm_r_attributes_t attrs = ANJAY_DM_R_ATTRIBUTES_EMPTY;
-    if (get_effective_attrs(_anjay_from_server(connection->conn_ref.server),
-                            &attrs, &path_entry->path,
-                            _anjay_server_ssid(connection->conn_ref.server))) {
+    if (get_effective_attrs_cached(
+                _anjay_from_server(connection->conn_ref.server),
+                &conn_entry->attrs_cache, &attrs, &path_entry->path,
+                _anjay_server_ssid(connection->conn_ref.server))) {
         return ANJAY_DM_OI_ATTRIBUTES_EMPTY;
     }
     return attrs.common;
 }
 
-static int notify_path_changed(anjay_observe_connection_entry_t *connection,
-                               anjay_observe_path_entry_t *path_entry,
+static int notify_path_changed(anjay_observe_path_entry_t *path_entry,
+                               anjay_observe_path_conn_entry_t *conn_entry,
                                void *result_ptr) {
-    int32_t period = get_oi_attributes(connection, path_entry).min_period;
+    anjay_observe_connection_entry_t *connection = conn_entry->conn;
+    int32_t period = get_oi_attributes(conn_entry, path_entry).min_period;
     period = AVS_MAX(period, 0);
 
     AVS_LIST(AVS_SORTED_SET_ELEM(anjay_observation_t)) ref;
-    AVS_LIST_FOREACH(ref, path_entry->refs) {
+    AVS_LIST_FOREACH(ref, conn_entry->refs) {
         assert(ref);
         assert(*ref);
         int observation_period = period;
@@ -2275,116 +2791,121 @@ static int notify_path_changed(anjay_observe_connection_entry_t *connection,
 }
 
 typedef int
-observe_for_each_matching_clb_t(anjay_observe_connection_entry_t *connection,
-                                anjay_observe_path_entry_t *path_entry,
+observe_for_each_matching_clb_t(anjay_observe_path_entry_t *path_entry,
+                                anjay_observe_path_conn_entry_t *conn_entry,
                                 void *arg);
 
 static int
-observe_for_each_in_bounds(anjay_observe_connection_entry_t *connection,
-                           const anjay_uri_path_t *lower_bound,
-                           const anjay_uri_path_t *upper_bound,
-                           observe_for_each_matching_clb_t *clb,
-                           void *clb_arg) {
-    int retval = 0;
-    AVS_SORTED_SET_ELEM(anjay_observe_path_entry_t) it =
-            AVS_SORTED_SET_LOWER_BOUND(connection->observed_paths,
-                                       path_entry_query(lower_bound));
-    AVS_SORTED_SET_ELEM(anjay_observe_path_entry_t) end =
-            AVS_SORTED_SET_UPPER_BOUND(connection->observed_paths,
-                                       path_entry_query(upper_bound));
-    // if it == NULL, end must also be NULL
-    assert(it || !end);
-
-    for (; it != end; it = AVS_SORTED_SET_ELEM_NEXT(it)) {
-        assert(it);
-        if ((retval = clb(connection, it, clb_arg))) {
+observe_for_each_conn_entry(anjay_observe_path_entry_t *path_entry,
+                            observe_for_each_matching_clb_t *clb,
+                            void *clb_arg) {
+    AVS_LIST(anjay_observe_path_conn_entry_t) conn_entry;
+    AVS_LIST_FOREACH(conn_entry, path_entry->conn_entries) {
+        int retval = clb(path_entry, conn_entry, clb_arg);
+        if (retval) {
             return retval;
         }
     }
     return 0;
 }
 
-static int
-observe_for_each_in_wildcard(anjay_observe_connection_entry_t *connection,
-                             const anjay_uri_path_t *specimen_path,
-                             anjay_id_type_t wildcard_level,
-                             observe_for_each_matching_clb_t *clb,
-                             void *clb_arg) {
-    anjay_uri_path_t path = *specimen_path;
-    for (int i = wildcard_level; i < _ANJAY_URI_PATH_MAX_LENGTH; ++i) {
-        path.ids[i] = ANJAY_ID_INVALID;
+static int observe_for_each_descendant(
+        AVS_SORTED_SET(anjay_observe_path_entry_t) children,
+        observe_for_each_matching_clb_t *clb,
+        void *clb_arg) {
+    if (!children) {
+        return 0;
     }
-    return observe_for_each_in_bounds(connection, &path, &path, clb, clb_arg);
+    AVS_SORTED_SET_ELEM(anjay_observe_path_entry_t) child;
+    AVS_SORTED_SET_FOREACH(child, children) {
+        int retval;
+        if ((retval = observe_for_each_descendant(child->children, clb,
+                                                  clb_arg))
+                || (retval = observe_for_each_conn_entry(child, clb,
+                                                         clb_arg))) {
+            return retval;
+        }
+    }
+    return 0;
 }
 
 /**
  * Calls <c>clb()</c> on all registered Observe path entries that match
- * <c>path</c>.
- *
- * This is harder than may seem at the first glance, because both
- * <c>path</c> (the query) and keys of the registered Observe path entries
- * may contain wildcards.
+ * <c>path</c>, i.e. ones that are either its ancestors, or <c>path</c> itself,
+ * or its descendants - once for each connection that observes such a path.
  *
  * An observation may be registered for either of:
+ * - The root path
  * - A whole object (OID)
  * - A whole object instance (OID+IID)
  * - A specific resource (OID+IID+RID)
  * - A specific resource instance (OID+IID+RID+RIID)
  *
- * Each of these cases needs to be addressed in a slightly different manner.
- *
- * Wildcard representation
- * -----------------------
- * A wildcard for any type of ID is represented as the number 65535. The
- * registered observation entries for any given connection are stored in a
- * sorted tree, with the sort key being ((prefix), OID, IID, RID, RIID) - in
- * lexicographical order over all elements of that tuple - much like C++11's
- * <c>std::tuple</c> comparison operators.
+ * Paths observed by all connections are organized in a single trie, in which
+ * each level corresponds to one ID of the path. A single descent from the root
+ * towards <c>path</c> visits all the strict ancestor entries, from the root
+ * downwards. Then the whole subtree rooted at the entry for <c>path</c> is
+ * traversed in post-order, with children sorted by ID. Connections that do not
+ * observe any matching path are never visited.
  *
- * Example: querying for OID+IID
- * -----------------------------
- * When the queried path is only OID+IID, we actually perform three
- * searches:
- * - the entry for the root path, i.e. (U16_MAX, U16_MAX, U16_MAX, U16_MAX)
- * - the entry for the Object, i.e. (OID, U16_MAX, U16_MAX, U16_MAX)
- * - entries between (OID, IID, 0, 0) and (OID, IID, U16_MAX, U16_MAX), i.e.
- *   entries for the Instance or any Resources or Resource Instances under
- * that Object Instance
- *
- * For paths of different lengths, there will be appropriately more or less
- * wildcard searches. If the search term is the root path, only the final
- * bounded search (between (0, 0, 0, 0) and
- * (U16_MAX, U16_MAX, U16_MAX, U16_MAX)) will be performed. If the search
- * term is OID+IID+RID+RIID, there will be five searches - for parent paths
- * of all lengths up to OID+IID+RID, and the final search for the actual
- * search term path.
+ * The subtree is thus visited in the order of _anjay_uri_path_compare(), which
+ * sorts ANJAY_ID_INVALID after any valid ID, i.e. each parent path after all
+ * of its descendants - the same order as would result from iterating over a
+ * sorted set of all the matching paths. Intermediate trie nodes that have no
+ * observations attached are not passed to <c>clb()</c>.
  */
-static int
-observe_for_each_matching(anjay_observe_connection_entry_t *connection,
-                          const anjay_uri_path_t *path,
-                          observe_for_each_matching_clb_t *clb,
-                          void *clb_arg) {
+static int observe_for_each_matching(anjay_observe_state_t *observe,
+                                     const anjay_uri_path_t *path,
+                                     observe_for_each_matching_clb_t *clb,
+                                     void *clb_arg) {
     int retval = 0;
-    anjay_uri_path_t lower_bound = *path;
-    anjay_uri_path_t upper_bound = *path;
-
-    size_t path_length = _anjay_uri_path_length(path);
-    for (size_t i = 0; i < path_length; ++i) {
-        if ((retval = observe_for_each_in_wildcard(
-                     connection, path, (anjay_id_type_t) i, clb, clb_arg))) {
-            goto finish;
+    anjay_uri_path_t node_path;
+    root_path_of(&node_path, path);
+    const size_t path_length = _anjay_uri_path_length(path);
+    AVS_SORTED_SET(anjay_observe_path_entry_t) set = observe->observed_paths;
+    for (size_t depth = 0; set; ++depth) {
+        AVS_SORTED_SET_ELEM(anjay_observe_path_entry_t) entry =
+                AVS_SORTED_SET_FIND(set, path_entry_query(&node_path));
+        if (!entry) {
+            break;
+        }
+        if (depth == path_length) {
+            if (!(retval = observe_for_each_descendant(entry->children, clb,
+                                                       clb_arg))) {
+                retval = observe_for_each_conn_entry(entry, clb, clb_arg);
+            }
+            break;
+        }
+        if ((retval = observe_for_each_conn_entry(entry, clb, clb_arg))) {
+            break;
         }
+        node_path.ids[depth] = path->ids[depth];
+        set = entry->children;
     }
+    return retval == ANJAY_FOREACH_BREAK ? 0 : retval;
+}
 
-    for (size_t i = path_length; i < _ANJAY_URI_PATH_MAX_LENGTH; ++i) {
-        lower_bound.ids[i] = 0;
-        upper_bound.ids[i] = ANJAY_ID_INVALID;
+typedef struct {
+    anjay_ssid_t ssid;
+    bool invert_server_match;
+    observe_for_each_matching_clb_t *clb;
+    int result;
+} observe_notify_args_t;
+
+static int observe_notify_clb(anjay_observe_path_entry_t *path_entry,
+                              anjay_observe_path_conn_entry_t *conn_entry,
+                              void *args_) {
+    observe_notify_args_t *args = (observe_notify_args_t *) args_;
+    /* Some compilers complain about promotion of comparison result, so
+     * we're casting it to bool explicitly */
+    if ((bool) (_anjay_server_ssid(conn_entry->conn->conn_ref.server)
+                == args->ssid)
+            != args->invert_server_match) {
+        // errors are only relevant to the connection they occurred for, so
+        // they shall not stop notifying other connections
+        (void) args->clb(path_entry, conn_entry, &args->result);
     }
-
-    retval = observe_for_each_in_bounds(connection, &lower_bound, &upper_bound,
-                                        clb, clb_arg);
-finish:
-    return retval == ANJAY_FOREACH_BREAK ? 0 : retval;
+    return 0;
 }
 
 static int observe_notify_impl(anjay_unlocked_t *anjay,
@@ -2392,19 +2913,15 @@ static int observe_notify_impl(anjay_unlocked_t *anjay,
                                anjay_ssid_t ssid,
                                bool invert_server_match,
                                observe_for_each_matching_clb_t *clb) {
-    // iterate through all SSIDs we have
-    int result = 0;
-    AVS_LIST(anjay_observe_connection_entry_t) connection;
-    AVS_LIST_FOREACH(connection, anjay->observe.connection_entries) {
-        /* Some compilers complain about promotion of comparison result, so
-         * we're casting it to bool explicitly */
-        if ((bool) (_anjay_server_ssid(connection->conn_ref.server) == ssid)
-                == invert_server_match) {
-            continue;
-        }
-        observe_for_each_matching(connection, path, clb, &result);
-    }
-    return result;
+    observe_notify_args_t args = {
+        .ssid = ssid,
+        .invert_server_match = invert_server_match,
+        .clb = clb,
+        .result = 0
+    };
+    observe_for_each_matching(&anjay->observe, path, observe_notify_clb,
+                              &args);
+    return args.result;
 }
 
 int _anjay_observe_notify(anjay_unlocked_t *anjay,
@@ -2419,12 +2936,13 @@ int _anjay_observe_notify(anjay_unlocked_t *anjay,
 }
 
 #    ifdef ANJAY_WITH_OBSERVATION_STATUS
-static int get_observe_status(anjay_observe_connection_entry_t *connection,
-                              anjay_observe_path_entry_t *entry,
+static int get_observe_status(anjay_observe_path_entry_t *entry,
+                              anjay_observe_path_conn_entry_t *conn_entry,
                               void *out_status_) {
     anjay_resource_observation_status_t *out_status =
             (anjay_resource_observation_status_t *) out_status_;
-    anjay_dm_oi_attributes_t attrs = get_oi_attributes(connection, entry);
+    anjay_observe_connection_entry_t *connection = conn_entry->conn;
+    anjay_dm_oi_attributes_t attrs = get_oi_attributes(conn_entry, entry);
     out_status->is_observed = true;
     if (attrs.min_period != ANJAY_ATTRIB_INTEGER_NONE
             && (attrs.min_period < out_status->min_period
@@ -2459,13 +2977,10 @@ _anjay_observe_status(anjay_unlocked_t *anjay, const anjay_uri_path_t *path) {
         .max_eval_period = ANJAY_ATTRIB_INTEGER_NONE
     };
 
-    AVS_LIST(anjay_observe_connection_entry_t) connection;
-    AVS_LIST_FOREACH(connection, anjay->observe.connection_entries) {
-        int retval = observe_for_each_matching(connection, path,
-                                               get_observe_status, &result);
-        assert(!retval);
-        (void) retval;
-    }
+    int retval = observe_for_each_matching(&anjay->observe, path,
+                                           get_observe_status, &result);
+    assert(!retval);
+    (void) retval;
 
     result.min_period = AVS_MAX(result.min_period, 0);
 
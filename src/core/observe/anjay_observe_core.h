@@ -22,6 +22,7 @@ VISIBILITY_PRIVATE_HEADER_BEGIN
 typedef struct anjay_observation_struct anjay_observation_t;
 typedef struct anjay_observe_connection_entry_struct
         anjay_observe_connection_entry_t;
+typedef struct anjay_observe_path_entry_struct anjay_observe_path_entry_t;
 
 typedef enum {
     NOTIFY_QUEUE_UNLIMITED,
@@ -30,6 +31,12 @@ typedef enum {
 
 typedef struct {
     AVS_LIST(anjay_observe_connection_entry_t) connection_entries;
+    // roots of the trie of paths observed by any of connection_entries;
+    // allocated on first use
+    AVS_SORTED_SET(anjay_observe_path_entry_t) observed_paths;
+    // incremented each time effective attributes of any path may have changed,
+    // invalidating all the cached ones
+    uint64_t attrs_generation;
     bool confirmable_notifications;
 
     notify_queue_limit_mode_t notify_queue_limit_mode;
@@ -88,6 +95,13 @@ int _anjay_observe_notify(anjay_unlocked_t *anjay,
                           anjay_ssid_t ssid,
                           bool invert_ssid_match);
 
+/**
+ * Invalidates effective attributes cached for all observations. Needs to be
+ * called whenever attributes are written, or the data model changes in a way
+ * that could affect them (e.g. Server object defaults, set of instances).
+ */
+void _anjay_observe_attrs_changed(anjay_unlocked_t *anjay);
+
 #    ifdef ANJAY_WITH_OBSERVATION_STATUS
 anjay_resource_observation_status_t
 _anjay_observe_status(anjay_unlocked_t *anjay, const anjay_uri_path_t *path);
@@ -103,6 +117,7 @@ _anjay_observe_status(anjay_unlocked_t *anjay, const anjay_uri_path_t *path);
 #    define _anjay_observe_confirmable_in_delivery(...) false
 #    define _anjay_observe_needs_flushing(...) false
 #    define _anjay_observe_sched_flush(...) 0
+#    define _anjay_observe_attrs_changed(...) ((void) 0)
 
 #    ifdef ANJAY_WITH_OBSERVATION_STATUS
 #        define _anjay_observe_status(...)         \
@@ -18,12 +18,25 @@
 
 VISIBILITY_PRIVATE_HEADER_BEGIN
 
+typedef struct {
+    // Value of anjay_observe_state_t::attrs_generation at the time attrs were
+    // resolved; 0 if they never were
+    uint64_t generation;
+    anjay_dm_r_attributes_t attrs;
+} anjay_observe_attrs_cache_t;
+
 struct anjay_observation_struct {
     const avs_coap_token_t token;
 
     const anjay_request_action_t action;
 
-    avs_sched_handle_t notify_task;
+    // Instant at which the notification trigger is planned for this
+    // observation, or AVS_TIME_MONOTONIC_INVALID if none is. Planned
+    // observations are linked into the anjay_observe_trigger_bucket_t for that
+    // instant through trigger_prev and trigger_next.
+    avs_time_monotonic_t trigger_time;
+    anjay_observation_t *trigger_prev;
+    anjay_observation_t *trigger_next;
     avs_time_real_t last_confirmable;
     avs_time_real_t next_pmax_trigger;
 
@@ -39,6 +52,10 @@ struct anjay_observation_struct {
     // to this resource+format or not)
     AVS_LIST(anjay_observation_value_t) last_unsent;
 
+    // Effective attributes of each of paths; array of paths_count elements,
+    // allocated on first use
+    anjay_observe_attrs_cache_t *attrs_cache;
+
 #ifdef ANJAY_WITH_LWM2M12
     int32_t historical_queue_size;
     size_t notifications_count;
@@ -51,12 +68,45 @@ struct anjay_observation_struct {
 };
 
 typedef struct {
-    const anjay_uri_path_t path;
+    anjay_observe_connection_entry_t *const conn;
 
     // List of observations (pointers to elements inside
-    // anjay_observe_connection_entry_t::observations) that include "path"
+    // anjay_observe_connection_entry_t::observations) that include the path
+    // of the anjay_observe_path_entry_t this entry belongs to
     AVS_LIST(AVS_SORTED_SET_ELEM(anjay_observation_t)) refs;
-} anjay_observe_path_entry_t;
+
+    // Effective attributes of the path for the server of conn
+    anjay_observe_attrs_cache_t attrs_cache;
+} anjay_observe_path_conn_entry_t;
+
+/**
+ * Node of the trie of paths observed by any of the connections. The trie is
+ * rooted at an entry for the root path (one per LwM2M Gateway prefix, if
+ * applicable), and each level descends by one ID: OID, IID, RID and RIID.
+ */
+struct anjay_observe_path_entry_struct {
+    const anjay_uri_path_t path;
+
+    // Connections that have any observations that include "path"; may be empty
+    // for intermediate nodes
+    AVS_LIST(anjay_observe_path_conn_entry_t) conn_entries;
+
+    // Nodes for paths one level deeper than "path"; may be NULL
+    AVS_SORTED_SET(anjay_observe_path_entry_t) children;
+};
+
+/**
+ * Set of observations of a single connection that are due at the same tick.
+ * All of them are handled by a single run of the connection's trigger job.
+ */
+typedef struct {
+    const avs_time_monotonic_t time;
+
+    // Doubly linked through anjay_observation_t::trigger_prev and trigger_next,
+    // in the order in which the triggers were planned
+    anjay_observation_t *first;
+    anjay_observation_t *last;
+} anjay_observe_trigger_bucket_t;
 
 typedef struct {
     avs_stream_t *membuf_stream;
@@ -69,10 +119,14 @@ typedef struct {
 
 struct anjay_observe_connection_entry_struct {
     const anjay_connection_ref_t conn_ref;
+    anjay_observe_state_t *const observe;
 
     AVS_SORTED_SET(anjay_observation_t) observations;
-    AVS_SORTED_SET(anjay_observe_path_entry_t) observed_paths;
     avs_sched_handle_t flush_task;
+    // Planned notification triggers, ordered by time; may be NULL
+    AVS_SORTED_SET(anjay_observe_trigger_bucket_t) trigger_buckets;
+    // Job scheduled at the time of the first element of trigger_buckets
+    avs_sched_handle_t trigger_task;
     avs_coap_exchange_id_t notify_exchange_id;
     anjay_observation_serialization_state_t serialization_state;
     avs_time_real_t next_trigger;
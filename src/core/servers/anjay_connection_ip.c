@@ -117,12 +117,11 @@ prepare_connection(anjay_unlocked_t *anjay,
 
 static avs_error_t connect_socket(anjay_unlocked_t *anjay,
                                   anjay_server_connection_t *connection) {
-    (void) anjay;
-
     avs_net_socket_t *socket =
             _anjay_connection_internal_get_socket(connection);
     avs_error_t err = avs_net_socket_connect(socket, connection->uri.host,
                                              connection->uri.port);
+    _anjay_sockets_changed(anjay);
     if (avs_is_err(err)) {
         anjay_log(ERROR, _("could not connect to ") "%s" _(":") "%s",
                   connection->uri.host, connection->uri.port);
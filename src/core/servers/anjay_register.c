@@ -336,6 +336,7 @@ error:
 
 void _anjay_registration_info_cleanup(anjay_registration_info_t *info) {
     AVS_LIST_CLEAR(&info->endpoint_path);
+    avs_coap_options_cleanup(&info->endpoint_path_options);
     update_parameters_cleanup(&info->last_update_params);
 }
 
@@ -468,6 +469,23 @@ static anjay_registration_result_t map_coap_error(avs_error_t coap_err) {
     }
 }
 
+static avs_error_t
+init_endpoint_path_options(avs_coap_options_t *opts,
+                           const anjay_registration_info_t *info) {
+    if (info->endpoint_path_options.size > 0) {
+        return avs_coap_options_dynamic_init_from_template(
+                opts, &info->endpoint_path_options,
+                AVS_COAP_DYNAMIC_OPTIONS_DEFAULT_SIZE);
+    }
+
+    avs_error_t err;
+    (void) (avs_is_err((err = avs_coap_options_dynamic_init(opts)))
+            || avs_is_err((err = _anjay_coap_add_string_options(
+                                   opts, info->endpoint_path,
+                                   AVS_COAP_OPTION_URI_PATH))));
+    return err;
+}
+
 static avs_error_t
 setup_register_request_options(avs_coap_options_t *opts,
                                anjay_lwm2m_version_t lwm2m_version,
@@ -799,12 +817,10 @@ static inline bool dm_caches_equal(const char *left, const char *right) {
 static avs_error_t
 setup_update_request_options(anjay_unlocked_t *anjay,
                              avs_coap_options_t *opts,
-                             AVS_LIST(const anjay_string_t) endpoint_path,
                              const anjay_update_parameters_t *old_params,
                              const anjay_update_parameters_t *new_params,
                              bool *out_dm_changed_since_last_update) {
     (void) anjay;
-    assert(opts->size == 0);
 
     const int64_t *lifetime_s_ptr = NULL;
     assert(new_params->lifetime_s >= 0);
@@ -821,13 +837,11 @@ setup_update_request_options(anjay_unlocked_t *anjay,
     *out_dm_changed_since_last_update =
             !dm_caches_equal(old_params->dm, new_params->dm);
 
-    avs_error_t err;
+    // opts already contain Uri-Path options of the registration
+    avs_error_t err = AVS_OK;
     (void) ((*out_dm_changed_since_last_update
              && avs_is_err((err = avs_coap_options_set_content_format(
                                     opts, AVS_COAP_FORMAT_LINK_FORMAT))))
-            || avs_is_err(
-                       (err = _anjay_coap_add_string_options(
-                                opts, endpoint_path, AVS_COAP_OPTION_URI_PATH)))
             || avs_is_err((err = _anjay_coap_add_query_options(
                                    /* opts = */ opts, /* version = */ NULL,
                                    /* endpoint_name = */ NULL,
@@ -999,10 +1013,10 @@ static void send_update(anjay_server_info_t *server,
     bool dm_changed_since_last_update;
 
     avs_error_t err;
-    if (avs_is_err((err = avs_coap_options_dynamic_init(&request.options)))
+    if (avs_is_err((err = init_endpoint_path_options(&request.options,
+                                                     old_info)))
             || avs_is_err((err = setup_update_request_options(
                                    server->anjay, &request.options,
-                                   old_info->endpoint_path,
                                    &old_info->last_update_params, move_params,
                                    &dm_changed_since_last_update)))) {
         anjay_log(ERROR, _("could not setup update request"));
@@ -1161,17 +1175,13 @@ void _anjay_server_ensure_valid_registration(anjay_server_info_t *server) {
 #ifndef ANJAY_WITHOUT_DEREGISTER
 static avs_error_t
 setup_deregister_request(avs_coap_request_header_t *out_request,
-                         AVS_LIST(const anjay_string_t) endpoint_path) {
+                         const anjay_registration_info_t *info) {
     *out_request = (avs_coap_request_header_t) {
         .code = AVS_COAP_CODE_DELETE
     };
 
-    avs_error_t err;
-    if (avs_is_err((err = avs_coap_options_dynamic_init(&out_request->options)))
-            || avs_is_err((err = _anjay_coap_add_string_options(
-                                   &out_request->options,
-                                   endpoint_path,
-                                   AVS_COAP_OPTION_URI_PATH)))) {
+    avs_error_t err = init_endpoint_path_options(&out_request->options, info);
+    if (avs_is_err(err)) {
         anjay_log(ERROR, _("could not initialize request headers"));
     }
     return err;
@@ -1194,8 +1204,7 @@ static avs_error_t deregister(anjay_server_info_t *server) {
     avs_coap_request_header_t request = { 0 };
     avs_coap_response_header_t response = { 0 };
     avs_error_t err =
-            setup_deregister_request(&request,
-                                     server->registration_info.endpoint_path);
+            setup_deregister_request(&request, &server->registration_info);
     if (avs_is_err(err)) {
         goto end;
     }
@@ -1290,6 +1299,17 @@ void _anjay_server_update_registration_info(
         AVS_LIST_CLEAR(&info->endpoint_path);
         info->endpoint_path = *move_endpoint_path;
         *move_endpoint_path = NULL;
+
+        avs_coap_options_cleanup(&info->endpoint_path_options);
+        if (avs_is_err(avs_coap_options_dynamic_init(
+                    &info->endpoint_path_options))
+                || avs_is_err(_anjay_coap_add_string_options(
+                           &info->endpoint_path_options, info->endpoint_path,
+                           AVS_COAP_OPTION_URI_PATH))) {
+            // not fatal - init_endpoint_path_options() will fall back to
+            // encoding endpoint_path for each request
+            avs_coap_options_cleanup(&info->endpoint_path_options);
+        }
     }
 
     if (move_params) {
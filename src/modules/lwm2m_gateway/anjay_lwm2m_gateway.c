@@ -26,6 +26,7 @@
 #    include <avsystem/commons/avs_defs.h>
 #    include <avsystem/commons/avs_list.h>
 #    include <avsystem/commons/avs_memory.h>
+#    include <avsystem/commons/avs_sorted_set.h>
 
 #    include "../../core/anjay_dm_core.h"
 #    include "../../core/attr_storage/anjay_attr_storage.h"
@@ -64,6 +65,12 @@ VISIBILITY_SOURCE_BEGIN
  */
 #    define RID_IOT_DEVICE_OBJECTS 3
 
+/**
+ * Prefix Resources are always in the form of PREFIX_BASE followed by the
+ * decimal representation of the Instance ID.
+ */
+#    define PREFIX_BASE "dev"
+
 typedef struct lwm2m_gateway_instance_struct {
     anjay_iid_t iid;
 
@@ -79,41 +86,107 @@ typedef struct lwm2m_gateway_object_struct {
     anjay_dm_installed_object_t obj_def_ptr;
     const anjay_unlocked_dm_object_def_t *obj_def;
 
-    AVS_LIST(lwm2m_gateway_instance_t) instances;
+    AVS_SORTED_SET(lwm2m_gateway_instance_t) instances;
+
+    /**
+     * IIDs lower than next_unused_iid that are not used by any instance.
+     * Together with next_unused_iid, allows finding the lowest free IID
+     * without iterating over all instances.
+     */
+    AVS_SORTED_SET(anjay_iid_t) released_iids;
+    /**
+     * All IIDs lower than this one are either used or present in
+     * released_iids.
+     */
+    anjay_iid_t next_unused_iid;
 } lwm2m_gateway_obj_t;
 
-static inline void
-delete_instance(AVS_LIST(lwm2m_gateway_instance_t) *instances,
-                lwm2m_gateway_instance_t *inst) {
-    AVS_LIST(lwm2m_gateway_instance_t) *inst_ptr =
-            AVS_LIST_FIND_PTR(instances, inst);
-    AVS_LIST_DELETE(inst_ptr);
-}
-
-static anjay_iid_t get_new_iid(AVS_LIST(lwm2m_gateway_instance_t) instances) {
-    anjay_iid_t iid = 0;
-    AVS_LIST(lwm2m_gateway_instance_t) it;
-    AVS_LIST_FOREACH(it, instances) {
-        if (it->iid == iid) {
-            ++iid;
-        } else if (it->iid > iid) {
-            break;
-        }
-    }
-    return iid;
+static int instance_cmp(const void *left, const void *right) {
+    return (int) ((const lwm2m_gateway_instance_t *) left)->iid
+           - (int) ((const lwm2m_gateway_instance_t *) right)->iid;
+}
+
+static int iid_cmp(const void *left, const void *right) {
+    return (int) *(const anjay_iid_t *) left
+           - (int) *(const anjay_iid_t *) right;
+}
+
+static inline const lwm2m_gateway_instance_t *
+instance_query(const anjay_iid_t *iid) {
+    return AVS_CONTAINER_OF(iid, lwm2m_gateway_instance_t, iid);
 }
 
 static inline lwm2m_gateway_instance_t *find_instance(lwm2m_gateway_obj_t *gw,
                                                       anjay_iid_t iid) {
-    AVS_LIST(lwm2m_gateway_instance_t) it;
-    AVS_LIST_FOREACH(it, gw->instances) {
-        if (it->iid == iid) {
-            return it;
-        } else if (it->iid > iid) {
-            break;
+    return AVS_SORTED_SET_FIND(gw->instances, instance_query(&iid));
+}
+
+static anjay_iid_t get_new_iid(lwm2m_gateway_obj_t *gw) {
+    AVS_SORTED_SET_ELEM(anjay_iid_t) released =
+            AVS_SORTED_SET_FIRST(gw->released_iids);
+    if (released) {
+        return *released;
+    }
+    // skip IIDs that have been explicitly requested by the user
+    while (gw->next_unused_iid != ANJAY_ID_INVALID
+           && find_instance(gw, gw->next_unused_iid)) {
+        ++gw->next_unused_iid;
+    }
+    return gw->next_unused_iid;
+}
+
+static void mark_iid_used(lwm2m_gateway_obj_t *gw, anjay_iid_t iid) {
+    if (iid < gw->next_unused_iid) {
+        AVS_SORTED_SET_ELEM(anjay_iid_t) released =
+                AVS_SORTED_SET_FIND(gw->released_iids, &iid);
+        if (released) {
+            AVS_SORTED_SET_DELETE_ELEM(gw->released_iids, &released);
         }
+    } else if (iid == gw->next_unused_iid) {
+        ++gw->next_unused_iid;
     }
-    return NULL;
+}
+
+static void release_iid(lwm2m_gateway_obj_t *gw, anjay_iid_t iid) {
+    if (iid >= gw->next_unused_iid) {
+        return;
+    }
+    AVS_SORTED_SET_ELEM(anjay_iid_t) released =
+            AVS_SORTED_SET_ELEM_NEW(anjay_iid_t);
+    if (!released) {
+        // the IID will not be reused for automatically assigned instances
+        _anjay_log_oom();
+        return;
+    }
+    *released = iid;
+    if (AVS_SORTED_SET_INSERT(gw->released_iids, released) != released) {
+        AVS_UNREACHABLE("Internal error: cannot add tree element");
+    }
+}
+
+/**
+ * Inverse of the PREFIX_BASE "%u" format used by init_instance().
+ */
+static bool prefix_to_iid(const char *prefix, anjay_iid_t *out_iid) {
+    if (strncmp(prefix, PREFIX_BASE, sizeof(PREFIX_BASE) - 1)) {
+        return false;
+    }
+    const char *digits = prefix + sizeof(PREFIX_BASE) - 1;
+    if (!*digits || (digits[0] == '0' && digits[1])) {
+        return false;
+    }
+    uint32_t value = 0;
+    for (; *digits; ++digits) {
+        if (*digits < '0' || *digits > '9') {
+            return false;
+        }
+        value = 10 * value + (uint32_t) (*digits - '0');
+        if (value >= ANJAY_ID_INVALID) {
+            return false;
+        }
+    }
+    *out_iid = (anjay_iid_t) value;
+    return true;
 }
 
 static inline lwm2m_gateway_obj_t *
@@ -127,8 +200,8 @@ static int gateway_list_instances(anjay_unlocked_t *anjay,
                                   anjay_unlocked_dm_list_ctx_t *ctx) {
     (void) anjay;
 
-    AVS_LIST(lwm2m_gateway_instance_t) it;
-    AVS_LIST_FOREACH(it, get_obj(&obj_ptr)->instances) {
+    AVS_SORTED_SET_ELEM(lwm2m_gateway_instance_t) it;
+    AVS_SORTED_SET_FOREACH(it, get_obj(&obj_ptr)->instances) {
         _anjay_dm_emit_unlocked(ctx, it->iid);
     }
 
@@ -136,9 +209,9 @@ static int gateway_list_instances(anjay_unlocked_t *anjay,
 }
 
 static int init_instance(lwm2m_gateway_instance_t *inst, anjay_iid_t iid) {
-    if (avs_simple_snprintf(inst->prefix, sizeof(inst->prefix), "dev%" PRIu16,
-                            iid)
-            < (int) strlen("dev0")) {
+    if (avs_simple_snprintf(inst->prefix, sizeof(inst->prefix),
+                            PREFIX_BASE "%" PRIu16, iid)
+            < (int) strlen(PREFIX_BASE "0")) {
         return -1;
     }
     inst->iid = iid;
@@ -149,33 +222,29 @@ static lwm2m_gateway_instance_t *
 gateway_instance_create(lwm2m_gateway_obj_t *gw, anjay_iid_t iid) {
     assert(iid != ANJAY_ID_INVALID);
 
-    AVS_LIST(lwm2m_gateway_instance_t) created =
-            AVS_LIST_NEW_ELEMENT(lwm2m_gateway_instance_t);
+    AVS_SORTED_SET_ELEM(lwm2m_gateway_instance_t) created =
+            AVS_SORTED_SET_ELEM_NEW(lwm2m_gateway_instance_t);
     if (!created) {
         _anjay_log_oom();
         return NULL;
     }
     if (init_instance(created, iid)) {
-        // failed, clean up newly added instance
-        delete_instance(&gw->instances, created);
+        // failed, clean up newly created instance
+        AVS_SORTED_SET_ELEM_DELETE_DETACHED(&created);
         return NULL;
     }
 
 #    ifdef ANJAY_WITH_ATTR_STORAGE
     if (_anjay_attr_storage_init(&created->as, &created->dm)) {
-        delete_instance(&gw->instances, created);
+        AVS_SORTED_SET_ELEM_DELETE_DETACHED(&created);
         return NULL;
     }
 #    endif // ANJAY_WITH_ATTR_STORAGE
 
-    AVS_LIST(lwm2m_gateway_instance_t) *ptr;
-    AVS_LIST_FOREACH_PTR(ptr, &gw->instances) {
-        if ((*ptr)->iid > created->iid) {
-            break;
-        }
+    if (AVS_SORTED_SET_INSERT(gw->instances, created) != created) {
+        AVS_UNREACHABLE("Internal error: cannot add tree element");
     }
-
-    AVS_LIST_INSERT(ptr, created);
+    mark_iid_used(gw, iid);
     return created;
 }
 
@@ -253,11 +322,16 @@ static const anjay_unlocked_dm_object_def_t LWM2M_GATEWAY = {
 static void gateway_delete(void *lwm2m_gateway_) {
     lwm2m_gateway_obj_t *gw = (lwm2m_gateway_obj_t *) lwm2m_gateway_;
 
-    AVS_LIST_CLEAR(&gw->instances) {
+    if (gw->instances) {
+        AVS_SORTED_SET_DELETE(&gw->instances) {
 #    ifdef ANJAY_WITH_ATTR_STORAGE
-        _anjay_attr_storage_cleanup(&gw->instances->as);
+            _anjay_attr_storage_cleanup(&(*gw->instances)->as);
 #    endif // ANJAY_WITH_ATTR_STORAGE
-        _anjay_dm_cleanup(&gw->instances->dm);
+            _anjay_dm_cleanup(&(*gw->instances)->dm);
+        }
+    }
+    if (gw->released_iids) {
+        AVS_SORTED_SET_DELETE(&gw->released_iids);
     }
 }
 
@@ -268,6 +342,15 @@ int anjay_lwm2m_gateway_install(anjay_t *anjay_locked) {
     ANJAY_MUTEX_LOCK(anjay, anjay_locked);
     AVS_LIST(lwm2m_gateway_obj_t) lwm2m_gateway =
             AVS_LIST_NEW_ELEMENT(lwm2m_gateway_obj_t);
+    if (lwm2m_gateway
+            && (!(lwm2m_gateway->instances =
+                          AVS_SORTED_SET_NEW(lwm2m_gateway_instance_t,
+                                             instance_cmp))
+                || !(lwm2m_gateway->released_iids =
+                             AVS_SORTED_SET_NEW(anjay_iid_t, iid_cmp)))) {
+        gateway_delete(lwm2m_gateway);
+        AVS_LIST_CLEAR(&lwm2m_gateway);
+    }
     if (lwm2m_gateway) {
         lwm2m_gateway->obj_def = &LWM2M_GATEWAY;
         _anjay_dm_installed_object_init_unlocked(&lwm2m_gateway->obj_def_ptr,
@@ -286,6 +369,8 @@ int anjay_lwm2m_gateway_install(anjay_t *anjay_locked) {
             } else {
                 result = 0;
             }
+        } else {
+            gateway_delete(lwm2m_gateway);
         }
         if (result) {
             AVS_LIST_CLEAR(&lwm2m_gateway);
@@ -306,7 +391,7 @@ static lwm2m_gateway_instance_t *add_instance(lwm2m_gateway_obj_t *gw,
         }
     } else {
         // assign new, free iid
-        *inout_iid = get_new_iid(gw->instances);
+        *inout_iid = get_new_iid(gw);
         if (*inout_iid == ANJAY_ID_INVALID) {
             return NULL;
         }
@@ -373,7 +458,8 @@ int anjay_lwm2m_gateway_deregister_device(anjay_t *anjay_locked,
 #    ifdef ANJAY_WITH_ATTR_STORAGE
             _anjay_attr_storage_cleanup(&inst->as);
 #    endif // ANJAY_WITH_ATTR_STORAGE
-            delete_instance(&gw->instances, inst);
+            AVS_SORTED_SET_DELETE_ELEM(gw->instances, &inst);
+            release_iid(gw, iid);
 
             _anjay_notify_instances_changed_unlocked(
                     anjay, ANJAY_DM_OID_LWM2M_GATEWAY);
@@ -402,12 +488,9 @@ void _anjay_lwm2m_gateway_iid_to_dm(anjay_unlocked_t *anjay,
     if (!gw) {
         gw_log(WARNING, _("LwM2M Gateway object not installed"));
     } else {
-        AVS_LIST(lwm2m_gateway_instance_t) it;
-        AVS_LIST_FOREACH(it, gw->instances) {
-            if (it->iid == iid) {
-                *dm = &it->dm;
-                break;
-            }
+        lwm2m_gateway_instance_t *inst = find_instance(gw, iid);
+        if (inst) {
+            *dm = &inst->dm;
         }
     }
 }
@@ -553,11 +636,11 @@ find_instance_by_prefix(anjay_unlocked_t *anjay, const char *prefix) {
     if (!gw) {
         gw_log(WARNING, _("LwM2M Gateway object not installed"));
     } else {
-        AVS_LIST(lwm2m_gateway_instance_t) it;
-        AVS_LIST_FOREACH(it, gw->instances) {
-            if (!strcmp(it->prefix, prefix)) {
-                return it;
-            }
+        anjay_iid_t iid;
+        lwm2m_gateway_instance_t *inst;
+        if (prefix_to_iid(prefix, &iid) && (inst = find_instance(gw, iid))) {
+            assert(!strcmp(inst->prefix, prefix));
+            return inst;
         }
     }
     return NULL;
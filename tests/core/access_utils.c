@@ -295,4 +295,119 @@ AVS_UNIT_TEST(anjay_sync_access_control, adds_2nd_element_prefix) {
     _anjay_notify_clear_queue(&queue);
 }
 
+static anjay_access_mask_t check_mask(anjay_t *anjay,
+                                      anjay_oid_t oid,
+                                      anjay_iid_t iid,
+                                      anjay_ssid_t ssid) {
+    anjay_access_mask_t mask;
+    ANJAY_MUTEX_LOCK(anjay_unlocked, anjay);
+    mask = access_control_mask(anjay_unlocked, oid, iid, ssid);
+    ANJAY_MUTEX_UNLOCK(anjay);
+    return mask;
+}
+
+static bool index_valid(anjay_t *anjay) {
+    bool valid;
+    ANJAY_MUTEX_LOCK(anjay_unlocked, anjay);
+    valid = anjay_unlocked->access_control_index.valid;
+    ANJAY_MUTEX_UNLOCK(anjay);
+    return valid;
+}
+
+static void flush_scheduled_notifications(anjay_t *anjay) {
+    ANJAY_MUTEX_LOCK(anjay_unlocked, anjay);
+    AVS_UNIT_ASSERT_SUCCESS(
+            _anjay_notify_flush(anjay_unlocked, ANJAY_SSID_BOOTSTRAP,
+                                &anjay_unlocked->scheduled_notify.queue));
+    ANJAY_MUTEX_UNLOCK(anjay);
+}
+
+// TEST: ACL lookups through the Access Control index.
+// The index is not used while there are unprocessed changes to the Access
+// Control object, is rebuilt on first lookup after the set of Access Control
+// instances changed, and is updated in place when only the ACLs changed.
+AVS_UNIT_TEST(access_control_index, lookup_and_sync) {
+    SCOPED_CORE_ACCESS_TEST_ENV(env);
+    anjay_t *anjay = env->anjay;
+    flush_scheduled_notifications(anjay);
+
+    AVS_UNIT_ASSERT_SUCCESS(anjay_access_control_set_acl(
+            anjay, 1234, 1, 1, ANJAY_ACCESS_MASK_READ));
+    AVS_UNIT_ASSERT_SUCCESS(anjay_access_control_set_acl(
+            anjay, 1234, 2, ANJAY_SSID_ANY, ANJAY_ACCESS_MASK_WRITE));
+
+    // changes not yet flushed - data model is queried directly
+    AVS_UNIT_ASSERT_EQUAL(check_mask(anjay, 1234, 1, 1),
+                          ANJAY_ACCESS_MASK_READ);
+    AVS_UNIT_ASSERT_FALSE(index_valid(anjay));
+
+    flush_scheduled_notifications(anjay);
+    AVS_UNIT_ASSERT_FALSE(index_valid(anjay));
+    AVS_UNIT_ASSERT_EQUAL(check_mask(anjay, 1234, 1, 1),
+                          ANJAY_ACCESS_MASK_READ);
+    AVS_UNIT_ASSERT_TRUE(index_valid(anjay));
+    AVS_UNIT_ASSERT_EQUAL(check_mask(anjay, 1234, 1, 2),
+                          ANJAY_ACCESS_MASK_NONE);
+    AVS_UNIT_ASSERT_EQUAL(check_mask(anjay, 1234, 2, 1),
+                          ANJAY_ACCESS_MASK_WRITE);
+    AVS_UNIT_ASSERT_EQUAL(check_mask(anjay, 1234, 2, 2),
+                          ANJAY_ACCESS_MASK_WRITE);
+    AVS_UNIT_ASSERT_EQUAL(check_mask(anjay, 1234, 3, 1),
+                          ANJAY_ACCESS_MASK_NONE);
+
+    // modifying an ACL of an existing instance
+    AVS_UNIT_ASSERT_SUCCESS(anjay_access_control_set_acl(
+            anjay, 1234, 1, 2, ANJAY_ACCESS_MASK_EXECUTE));
+    AVS_UNIT_ASSERT_EQUAL(check_mask(anjay, 1234, 1, 2),
+                          ANJAY_ACCESS_MASK_EXECUTE);
+
+    flush_scheduled_notifications(anjay);
+    AVS_UNIT_ASSERT_TRUE(index_valid(anjay));
+    AVS_UNIT_ASSERT_EQUAL(check_mask(anjay, 1234, 1, 1),
+                          ANJAY_ACCESS_MASK_READ);
+    AVS_UNIT_ASSERT_EQUAL(check_mask(anjay, 1234, 1, 2),
+                          ANJAY_ACCESS_MASK_EXECUTE);
+
+    // modification of the Access Control object that has not been reported
+    // through the notification queue
+    ANJAY_MUTEX_LOCK(anjay_unlocked, anjay);
+    _anjay_access_control_index_object_modified(
+            anjay_unlocked, get_access_control(anjay_unlocked));
+    AVS_UNIT_ASSERT_TRUE(anjay_unlocked->access_control_index.sync_pending);
+    anjay_notify_queue_t queue = NULL;
+    AVS_UNIT_ASSERT_SUCCESS(
+            _anjay_sync_access_control(anjay_unlocked, 1, &queue));
+    AVS_UNIT_ASSERT_FALSE(anjay_unlocked->access_control_index.sync_pending);
+    ANJAY_MUTEX_UNLOCK(anjay);
+    AVS_UNIT_ASSERT_FALSE(index_valid(anjay));
+}
+
+// TEST: after a failed attempt to build the Access Control index, lookups go
+// straight to the data model instead of retrying, until the Access Control
+// object changes.
+AVS_UNIT_TEST(access_control_index, rebuild_failure) {
+    SCOPED_CORE_ACCESS_TEST_ENV(env);
+    anjay_t *anjay = env->anjay;
+    AVS_UNIT_ASSERT_SUCCESS(anjay_access_control_set_acl(
+            anjay, 1234, 1, 1, ANJAY_ACCESS_MASK_READ));
+    flush_scheduled_notifications(anjay);
+
+    ANJAY_MUTEX_LOCK(anjay_unlocked, anjay);
+    anjay_unlocked->access_control_index.rebuild_failed = true;
+    ANJAY_MUTEX_UNLOCK(anjay);
+    AVS_UNIT_ASSERT_EQUAL(check_mask(anjay, 1234, 1, 1),
+                          ANJAY_ACCESS_MASK_READ);
+    AVS_UNIT_ASSERT_FALSE(index_valid(anjay));
+
+    AVS_UNIT_ASSERT_SUCCESS(anjay_access_control_set_acl(
+            anjay, 1234, 1, 1, ANJAY_ACCESS_MASK_WRITE));
+    flush_scheduled_notifications(anjay);
+    ANJAY_MUTEX_LOCK(anjay_unlocked, anjay);
+    AVS_UNIT_ASSERT_FALSE(anjay_unlocked->access_control_index.rebuild_failed);
+    ANJAY_MUTEX_UNLOCK(anjay);
+    AVS_UNIT_ASSERT_EQUAL(check_mask(anjay, 1234, 1, 1),
+                          ANJAY_ACCESS_MASK_WRITE);
+    AVS_UNIT_ASSERT_TRUE(index_valid(anjay));
+}
+
 #endif // ANJAY_WITH_ACCESS_CONTROL
@@ -1573,3 +1573,36 @@ AVS_UNIT_TEST(schedule_register, all_servers) {
                          >= 1000);
     DM_TEST_FINISH;
 }
+
+#ifdef ANJAY_WITH_NET_STATS
+AVS_UNIT_TEST(net_stats, incoming_packets_per_serve_call) {
+    DM_TEST_INIT;
+    const uint64_t initial_packets = anjay_get_num_incoming_packets(anjay);
+    const uint64_t initial_serve_calls = anjay_get_num_serve_calls(anjay);
+
+    for (uint16_t i = 0; i < 2; ++i) {
+        DM_TEST_REQUEST(mocksocks[0], CON, GET, ID(0xFA3E + i),
+                        PATH("42", "69", "4"), NO_PAYLOAD);
+        _anjay_mock_dm_expect_list_instances(
+                anjay, &OBJ, 0, (const anjay_iid_t[]) { 69, ANJAY_ID_INVALID });
+        _anjay_mock_dm_expect_list_resources(
+                anjay, &OBJ, 69, 0,
+                (const anjay_mock_dm_res_entry_t[]) {
+                        { 4, ANJAY_DM_RES_RW, ANJAY_DM_RES_PRESENT },
+                        ANJAY_MOCK_DM_RES_END });
+        _anjay_mock_dm_expect_resource_read(anjay, &OBJ, 69, 4,
+                                            ANJAY_ID_INVALID, 0,
+                                            ANJAY_MOCK_DM_INT(0, 514));
+        DM_TEST_EXPECT_RESPONSE(mocksocks[0], ACK, CONTENT, ID(0xFA3E + i),
+                                CONTENT_FORMAT(PLAINTEXT), PAYLOAD("514"));
+        expect_has_buffered_data_check(mocksocks[0], false);
+        AVS_UNIT_ASSERT_SUCCESS(anjay_serve(anjay, mocksocks[0]));
+    }
+
+    AVS_UNIT_ASSERT_EQUAL(anjay_get_num_incoming_packets(anjay),
+                          initial_packets + 2);
+    AVS_UNIT_ASSERT_EQUAL(anjay_get_num_serve_calls(anjay),
+                          initial_serve_calls + 2);
+    DM_TEST_FINISH;
+}
+#endif // ANJAY_WITH_NET_STATS
@@ -1753,6 +1753,107 @@ AVS_UNIT_TEST(attr_storage, read_resource_attrs) {
     DM_ATTR_STORAGE_TEST_FINISH;
 }
 
+AVS_UNIT_TEST(attr_storage, read_index) {
+    DM_ATTR_STORAGE_TEST_INIT;
+
+    AVS_LIST_APPEND(&anjay_unlocked->attr_storage.objects,
+                    test_object_entry(
+                            69,
+                            test_default_attrs(42, 1, 2, -1, -1,
+#ifdef ANJAY_WITH_LWM2M12
+                                               -1,
+#endif // ANJAY_WITH_LWM2M12
+                                               ANJAY_DM_CON_ATTR_NONE),
+                            test_instance_entry(
+                                    3,
+                                    test_default_attrs(
+                                            42, 3, 4, -1, -1,
+#ifdef ANJAY_WITH_LWM2M12
+                                            -1,
+#endif // ANJAY_WITH_LWM2M12
+                                            ANJAY_DM_CON_ATTR_NONE),
+                                    test_resource_entry(
+                                            1,
+                                            test_resource_attrs(
+                                                    42, 5, 6, -1, -1,
+#ifdef ANJAY_WITH_LWM2M12
+                                                    -1,
+#endif // ANJAY_WITH_LWM2M12
+                                                    5.0, 6.0, 7.0,
+#ifdef ANJAY_WITH_LWM2M12
+                                                    ANJAY_DM_EDGE_ATTR_NONE,
+#endif // ANJAY_WITH_LWM2M12
+                                                    ANJAY_DM_CON_ATTR_NONE),
+                                            NULL),
+                                    test_resource_entry(2, NULL), NULL),
+                            NULL));
+    anjay_attr_storage_t *as = &anjay_unlocked->attr_storage;
+    AVS_UNIT_ASSERT_FALSE(as->index_valid);
+
+    anjay_dm_r_attributes_t attrs;
+    AVS_UNIT_ASSERT_SUCCESS(_anjay_dm_call_resource_read_attrs(
+            anjay_unlocked, WRAP_OBJ_PTR(&OBJ2), 3, 1, 42, &attrs));
+    AVS_UNIT_ASSERT_EQUAL(attrs.common.min_period, 5);
+    AVS_UNIT_ASSERT_EQUAL(attrs.common.max_period, 6);
+    AVS_UNIT_ASSERT_TRUE(as->index_valid);
+    // Resource 2 has no attributes, so it is not indexed
+    AVS_UNIT_ASSERT_EQUAL(as->index_size, 3);
+    for (size_t i = 1; i < as->index_size; ++i) {
+        AVS_UNIT_ASSERT_TRUE(as->index[i - 1].key < as->index[i].key);
+    }
+
+    anjay_dm_oi_attributes_t oi_attrs;
+    AVS_UNIT_ASSERT_SUCCESS(_anjay_dm_call_object_read_default_attrs(
+            anjay_unlocked, WRAP_OBJ_PTR(&OBJ2), 42, &oi_attrs));
+    AVS_UNIT_ASSERT_EQUAL(oi_attrs.min_period, 1);
+    AVS_UNIT_ASSERT_SUCCESS(_anjay_dm_call_instance_read_default_attrs(
+            anjay_unlocked, WRAP_OBJ_PTR(&OBJ2), 3, 42, &oi_attrs));
+    AVS_UNIT_ASSERT_EQUAL(oi_attrs.min_period, 3);
+    AVS_UNIT_ASSERT_SUCCESS(_anjay_dm_call_instance_read_default_attrs(
+            anjay_unlocked, WRAP_OBJ_PTR(&OBJ2), 4, 42, &oi_attrs));
+    assert_attrs_equal(&oi_attrs, &ANJAY_DM_OI_ATTRIBUTES_EMPTY);
+    AVS_UNIT_ASSERT_SUCCESS(_anjay_dm_call_resource_read_attrs(
+            anjay_unlocked, WRAP_OBJ_PTR(&OBJ2), 3, 2, 42, &attrs));
+    assert_res_attrs_equal(&attrs, &ANJAY_DM_R_ATTRIBUTES_EMPTY);
+    AVS_UNIT_ASSERT_SUCCESS(_anjay_dm_call_resource_read_attrs(
+            anjay_unlocked, WRAP_OBJ_PTR(&OBJ2), 3, 1, 7, &attrs));
+    assert_res_attrs_equal(&attrs, &ANJAY_DM_R_ATTRIBUTES_EMPTY);
+
+    AVS_UNIT_ASSERT_SUCCESS(_anjay_dm_call_resource_write_attrs(
+            anjay_unlocked, WRAP_OBJ_PTR(&OBJ2), 3, 2, 42,
+            &(const anjay_dm_r_attributes_t) {
+                .common = {
+                    .min_period = 7,
+                    .max_period = ANJAY_ATTRIB_INTEGER_NONE,
+                    .min_eval_period = ANJAY_ATTRIB_INTEGER_NONE,
+                    .max_eval_period = ANJAY_ATTRIB_INTEGER_NONE
+#ifdef ANJAY_WITH_CON_ATTR
+                    ,
+                    .con = ANJAY_DM_CON_ATTR_NONE
+#endif // ANJAY_WITH_CON_ATTR
+#ifdef ANJAY_WITH_LWM2M12
+                    ,
+                    .hqmax = ANJAY_ATTRIB_INTEGER_NONE
+#endif // ANJAY_WITH_LWM2M12
+                },
+                .greater_than = ANJAY_ATTRIB_DOUBLE_NONE,
+                .less_than = ANJAY_ATTRIB_DOUBLE_NONE,
+                .step = ANJAY_ATTRIB_DOUBLE_NONE
+#ifdef ANJAY_WITH_LWM2M12
+                ,
+                .edge = ANJAY_DM_EDGE_ATTR_NONE
+#endif // ANJAY_WITH_LWM2M12
+            }));
+    AVS_UNIT_ASSERT_FALSE(as->index_valid);
+    AVS_UNIT_ASSERT_SUCCESS(_anjay_dm_call_resource_read_attrs(
+            anjay_unlocked, WRAP_OBJ_PTR(&OBJ2), 3, 2, 42, &attrs));
+    AVS_UNIT_ASSERT_EQUAL(attrs.common.min_period, 7);
+    AVS_UNIT_ASSERT_TRUE(as->index_valid);
+    AVS_UNIT_ASSERT_EQUAL(as->index_size, 4);
+
+    DM_ATTR_STORAGE_TEST_FINISH;
+}
+
 AVS_UNIT_TEST(attr_storage, write_resource_attrs) {
     DM_ATTR_STORAGE_TEST_INIT;
     AVS_UNIT_ASSERT_FALSE(anjay_unlocked->attr_storage.modified_since_persist);
@@ -970,7 +970,55 @@ AVS_UNIT_TEST(downloader, abort_http) {
 
     teardown_simple();
 }
-#endif // ANJAY_WITH_HTTP_DOWNLOAD
+
+#    ifdef ANJAY_WITH_EVENT_LOOP_EPOLL
+AVS_UNIT_TEST(downloader, http_reconnect_changes_sockets) {
+    setup_simple("http://127.0.0.1");
+    anjay_downloader_t *dl = &SIMPLE_ENV.base->anjay->downloader;
+
+    anjay_download_handle_t handle = NULL;
+    AVS_UNIT_ASSERT_SUCCESS(
+            _anjay_downloader_download(dl, &handle, &SIMPLE_ENV.cfg, NULL,
+                                       NULL));
+    AVS_UNIT_ASSERT_NOT_NULL(handle);
+
+    // the event loop shall refresh its epoll registrations whenever the HTTP
+    // stream is closed, as its socket might be replaced by one that has the
+    // same descriptor number and address
+    uint64_t generation = SIMPLE_ENV.base->anjay->sockets_generation;
+    _anjay_downloader_suspend(dl, handle);
+    AVS_UNIT_ASSERT_TRUE(SIMPLE_ENV.base->anjay->sockets_generation
+                         != generation);
+
+    generation = SIMPLE_ENV.base->anjay->sockets_generation;
+    AVS_UNIT_ASSERT_SUCCESS(
+            _anjay_downloader_sched_reconnect_by_handle(dl, handle));
+    // run the reconnect job directly, so that the request is not sent
+    const uintptr_t id = (uintptr_t) handle;
+    ANJAY_MUTEX_UNLOCK_FOR_CALLBACK(anjay_locked, SIMPLE_ENV.base->anjay);
+    _anjay_downloader_reconnect_job(SIMPLE_ENV.base->anjay->sched, &id);
+    ANJAY_MUTEX_LOCK_AFTER_CALLBACK(anjay_locked);
+    AVS_UNIT_ASSERT_TRUE(SIMPLE_ENV.base->anjay->sockets_generation
+                         != generation);
+
+    expect_download_finished(&SIMPLE_ENV.data,
+                             _anjay_download_status_aborted());
+    _anjay_downloader_abort(dl, handle);
+
+    // cleanup_http_stream is run through the scheduler
+    ANJAY_MUTEX_UNLOCK_FOR_CALLBACK(anjay_locked, SIMPLE_ENV.base->anjay);
+    avs_sched_run(SIMPLE_ENV.base->anjay->sched);
+    ANJAY_MUTEX_LOCK_AFTER_CALLBACK(anjay_locked);
+
+    // both the reconnect job and send_request are canceled
+    AVS_UNIT_ASSERT_FALSE(avs_time_duration_valid(
+            avs_sched_time_to_next(SIMPLE_ENV.base->anjay->sched)));
+    AVS_UNIT_ASSERT_EQUAL(0, num_downloads_in_progress());
+
+    teardown_simple();
+}
+#    endif // ANJAY_WITH_EVENT_LOOP_EPOLL
+#endif     // ANJAY_WITH_HTTP_DOWNLOAD
 
 static void expect_uri_path_query(avs_net_socket_t *socket, void *dummy) {
     assert(socket == SIMPLE_ENV.mocksock);
@@ -52,7 +52,7 @@ AVS_UNIT_TEST(batch_builder, single_int_entry) {
     AVS_UNIT_ASSERT_SUCCESS(_anjay_batch_add_int(
             builder, &MAKE_RESOURCE_INSTANCE_PATH(0, 0, 0, 0),
             AVS_TIME_REAL_INVALID, 0));
-    AVS_UNIT_ASSERT_EQUAL(AVS_LIST_SIZE(builder->list), 1);
+    AVS_UNIT_ASSERT_EQUAL(builder->entry_count, 1);
 
     builder_teardown(builder);
 }
@@ -66,7 +66,7 @@ AVS_UNIT_TEST(batch_builder, two_entries) {
     AVS_UNIT_ASSERT_SUCCESS(_anjay_batch_add_int(
             builder, &MAKE_RESOURCE_INSTANCE_PATH(0, 0, 0, 0),
             AVS_TIME_REAL_INVALID, 0));
-    AVS_UNIT_ASSERT_EQUAL(AVS_LIST_SIZE(builder->list), 2);
+    AVS_UNIT_ASSERT_EQUAL(builder->entry_count, 2);
 
     builder_teardown(builder);
 }
@@ -83,12 +83,12 @@ AVS_UNIT_TEST(batch_builder, string_copy) {
     AVS_UNIT_ASSERT_SUCCESS(_anjay_batch_add_string(
             builder, &MAKE_RESOURCE_INSTANCE_PATH(0, 0, 0, 0),
             AVS_TIME_REAL_INVALID, str));
-    AVS_UNIT_ASSERT_EQUAL(AVS_LIST_SIZE(builder->list), 1);
+    AVS_UNIT_ASSERT_EQUAL(builder->entry_count, 1);
 
     // Passed string shouldn't be required anymore.
     avs_free(str);
 
-    AVS_LIST(anjay_batch_entry_t) entry = AVS_LIST_TAIL(builder->list);
+    anjay_batch_entry_t *entry = &builder->entries[builder->entry_count - 1];
     AVS_UNIT_ASSERT_EQUAL_STRING(entry->data.value.string, test_string.data);
 
     builder_teardown(builder);
@@ -106,12 +106,12 @@ AVS_UNIT_TEST(batch_builder, bytes_copy) {
 
     _anjay_batch_add_bytes(builder, &MAKE_RESOURCE_INSTANCE_PATH(0, 0, 0, 0),
                            AVS_TIME_REAL_INVALID, bytes, test_bytes.size);
-    AVS_UNIT_ASSERT_EQUAL(AVS_LIST_SIZE(builder->list), 1);
+    AVS_UNIT_ASSERT_EQUAL(builder->entry_count, 1);
 
     // Passed bytes shouldn't be required anymore.
     avs_free(bytes);
 
-    AVS_LIST(anjay_batch_entry_t) entry = AVS_LIST_TAIL(builder->list);
+    anjay_batch_entry_t *entry = &builder->entries[builder->entry_count - 1];
     AVS_UNIT_ASSERT_EQUAL_BYTES_SIZED(entry->data.value.bytes.data,
                                       test_bytes.data, test_bytes.size);
 
@@ -123,9 +123,9 @@ AVS_UNIT_TEST(batch_builder, empty_bytes) {
 
     _anjay_batch_add_bytes(builder, &MAKE_RESOURCE_INSTANCE_PATH(0, 0, 0, 0),
                            AVS_TIME_REAL_INVALID, NULL, 0);
-    AVS_UNIT_ASSERT_EQUAL(AVS_LIST_SIZE(builder->list), 1);
+    AVS_UNIT_ASSERT_EQUAL(builder->entry_count, 1);
 
-    AVS_LIST(anjay_batch_entry_t) entry = AVS_LIST_TAIL(builder->list);
+    anjay_batch_entry_t *entry = &builder->entries[builder->entry_count - 1];
     AVS_UNIT_ASSERT_NULL(entry->data.value.bytes.data);
     AVS_UNIT_ASSERT_EQUAL(entry->data.value.bytes.length, 0);
 
@@ -139,14 +139,86 @@ AVS_UNIT_TEST(batch_builder, compile) {
     AVS_UNIT_ASSERT_SUCCESS(_anjay_batch_add_int(
             builder, &MAKE_RESOURCE_INSTANCE_PATH(0, 0, 0, 0),
             AVS_TIME_REAL_INVALID, 0));
-    AVS_UNIT_ASSERT_EQUAL(AVS_LIST_SIZE(builder->list), 1);
+    AVS_UNIT_ASSERT_EQUAL(builder->entry_count, 1);
 
     anjay_batch_t *batch = _anjay_batch_builder_compile(&builder);
     AVS_UNIT_ASSERT_NULL(builder);
 
-    AVS_UNIT_ASSERT_EQUAL(AVS_LIST_SIZE(batch->list), 1);
+    AVS_UNIT_ASSERT_EQUAL(batch->entry_count, 1);
     AVS_UNIT_ASSERT_EQUAL(batch->ref_count, 1);
 
     _anjay_batch_release(&batch);
     AVS_UNIT_ASSERT_NULL(batch);
 }
+
+AVS_UNIT_TEST(batch_builder, allocations) {
+    anjay_batch_builder_t *builder = builder_setup();
+
+    enum { ENTRY_COUNT = 100 };
+    for (int i = 0; i < ENTRY_COUNT; ++i) {
+        AVS_UNIT_ASSERT_SUCCESS(_anjay_batch_add_string(
+                builder, &MAKE_RESOURCE_INSTANCE_PATH(0, 0, 0, (uint16_t) i),
+                AVS_TIME_REAL_INVALID, "raz dwa trzy"));
+    }
+    AVS_UNIT_ASSERT_EQUAL(builder->entry_count, ENTRY_COUNT);
+    // Entries are grown geometrically and payloads are bump-allocated from
+    // chunks, so the number of allocations is far below the number of entries
+    AVS_UNIT_ASSERT_TRUE(builder->entry_capacity >= ENTRY_COUNT);
+    AVS_UNIT_ASSERT_TRUE(builder->entry_capacity < 2 * ENTRY_COUNT);
+    AVS_UNIT_ASSERT_TRUE(
+            AVS_LIST_SIZE(builder->arena)
+            <= ENTRY_COUNT / (BATCH_ARENA_CHUNK_SIZE / sizeof("raz dwa trzy"))
+                           + 1);
+
+    anjay_batch_t *batch = _anjay_batch_builder_compile(&builder);
+    AVS_UNIT_ASSERT_NULL(builder);
+    AVS_UNIT_ASSERT_EQUAL(batch->entry_count, ENTRY_COUNT);
+
+    // All payloads are stored within the same memory block as the batch
+    const char *payload_begin = (const char *) &batch->entries[ENTRY_COUNT];
+    const char *payload_end =
+            payload_begin + ENTRY_COUNT * sizeof("raz dwa trzy");
+    for (int i = 0; i < ENTRY_COUNT; ++i) {
+        const char *str = batch->entries[i].data.value.string;
+        AVS_UNIT_ASSERT_TRUE(str >= payload_begin && str < payload_end);
+        AVS_UNIT_ASSERT_EQUAL_STRING(str, "raz dwa trzy");
+    }
+
+    _anjay_batch_release(&batch);
+    AVS_UNIT_ASSERT_NULL(batch);
+}
+
+AVS_UNIT_TEST(batch_builder, rollback) {
+    anjay_batch_builder_t *builder = builder_setup();
+
+    AVS_UNIT_ASSERT_SUCCESS(_anjay_batch_add_string(
+            builder, &MAKE_RESOURCE_INSTANCE_PATH(0, 0, 0, 0),
+            AVS_TIME_REAL_INVALID, "raz"));
+    const anjay_batch_builder_mark_t mark = _anjay_batch_builder_mark(builder);
+
+    char long_string[2 * BATCH_ARENA_CHUNK_SIZE];
+    memset(long_string, 'x', sizeof(long_string) - 1);
+    long_string[sizeof(long_string) - 1] = '\0';
+    AVS_UNIT_ASSERT_SUCCESS(_anjay_batch_add_string(
+            builder, &MAKE_RESOURCE_INSTANCE_PATH(0, 0, 0, 1),
+            AVS_TIME_REAL_INVALID, "dwa"));
+    AVS_UNIT_ASSERT_SUCCESS(_anjay_batch_add_string(
+            builder, &MAKE_RESOURCE_INSTANCE_PATH(0, 0, 0, 2),
+            AVS_TIME_REAL_INVALID, long_string));
+    AVS_UNIT_ASSERT_EQUAL(builder->entry_count, 3);
+    AVS_UNIT_ASSERT_EQUAL(AVS_LIST_SIZE(builder->arena), 2);
+
+    _anjay_batch_builder_rollback(builder, mark);
+    AVS_UNIT_ASSERT_EQUAL(builder->entry_count, 1);
+    AVS_UNIT_ASSERT_EQUAL(AVS_LIST_SIZE(builder->arena), 1);
+    AVS_UNIT_ASSERT_EQUAL(builder->arena->used, sizeof("raz"));
+
+    // Values are not allowed on paths without a Resource ID; the payload
+    // shall not be leaked in the arena
+    AVS_UNIT_ASSERT_FAILED(_anjay_batch_add_string(
+            builder, &MAKE_INSTANCE_PATH(0, 0), AVS_TIME_REAL_INVALID, "trzy"));
+    AVS_UNIT_ASSERT_EQUAL(builder->entry_count, 1);
+    AVS_UNIT_ASSERT_EQUAL(builder->arena->used, sizeof("raz"));
+
+    builder_teardown(builder);
+}
@@ -355,6 +355,31 @@ AVS_UNIT_TEST(cbor_in_object, with_some_instances_and_some_resources) {
     TEST_TEARDOWN(OK);
 }
 
+AVS_UNIT_TEST(cbor_in_instance, basename_and_names) {
+    static const char RESOURCES[] = {
+        "\x82"       // array(2)
+        "\xA3"       // map(3)
+        "\x21"       // negative(1) => SenML Base Name
+        "\x66/13/26" // text(6)
+        "\x00"       // unsigned(0) => SenML Name
+        "\x62/1"     // text(2)
+        "\x02"       // unsigned(2) => SenML Value
+        "\x18\x2A"   // unsigned(42)
+                     // ,
+        "\xA2"       // map(2)
+        "\x00"       // unsigned(0) => SenML Name
+        "\x62/2"     // text(2)
+        "\x02"       // unsigned(2) => SenML Value
+        "\x18\x2B"   // unsigned(43)
+    };
+    TEST_ENV(RESOURCES, TEST_INSTANCE_PATH);
+    check_paths(in,
+                (const anjay_uri_path_t[2]) { MAKE_RESOURCE_PATH(13, 26, 1),
+                                              MAKE_RESOURCE_PATH(13, 26, 2) },
+                2);
+    TEST_TEARDOWN(OK);
+}
+
 #define TEST_VALUE_ENV(TypeAndValue)                                        \
     static const char RESOURCE[] = { "\x81" /* array(1) */                  \
                                      "\xA2" /* map(2) */                    \
@@ -49,6 +49,8 @@ const size_t int_array_size = sizeof(int_array) / sizeof(int_array[0]);
 #define MOCK_CLOCK_START_ABSOLUTE \
     (SENML_TIME_SECONDS_THRESHOLD + MOCK_CLOCK_START_RELATIVE)
 
+#define LAST_ENTRY(Builder) (&(Builder)->entries[(Builder)->entry_count - 1])
+
 static int test_list_resources(anjay_t *anjay,
                                const anjay_dm_object_def_t *const *obj_ptr,
                                anjay_iid_t iid,
@@ -263,8 +265,8 @@ AVS_UNIT_TEST(dm_batch, single_bytes) {
 
     AVS_UNIT_ASSERT_SUCCESS(add_current(builder, anjay, BYTES_RID));
 
-    AVS_UNIT_ASSERT_EQUAL(AVS_LIST_SIZE(builder->list), 1);
-    AVS_UNIT_ASSERT_TRUE(is_entry_valid(AVS_LIST_TAIL(builder->list),
+    AVS_UNIT_ASSERT_EQUAL(builder->entry_count, 1);
+    AVS_UNIT_ASSERT_TRUE(is_entry_valid(LAST_ENTRY(builder),
                                         BYTES_RID,
                                         ANJAY_ID_INVALID,
                                         (anjay_batch_data_t) {
@@ -282,8 +284,8 @@ AVS_UNIT_TEST(dm_batch, single_string) {
 
     AVS_UNIT_ASSERT_SUCCESS(add_current(builder, anjay, STRING_RID));
 
-    AVS_UNIT_ASSERT_EQUAL(AVS_LIST_SIZE(builder->list), 1);
-    AVS_UNIT_ASSERT_TRUE(is_entry_valid(AVS_LIST_TAIL(builder->list),
+    AVS_UNIT_ASSERT_EQUAL(builder->entry_count, 1);
+    AVS_UNIT_ASSERT_TRUE(is_entry_valid(LAST_ENTRY(builder),
                                         STRING_RID,
                                         ANJAY_ID_INVALID,
                                         (anjay_batch_data_t) {
@@ -300,8 +302,8 @@ AVS_UNIT_TEST(dm_batch, single_int) {
 
     AVS_UNIT_ASSERT_SUCCESS(add_current(builder, anjay, INT_RID));
 
-    AVS_UNIT_ASSERT_EQUAL(AVS_LIST_SIZE(builder->list), 1);
-    AVS_UNIT_ASSERT_TRUE(is_entry_valid(AVS_LIST_TAIL(builder->list),
+    AVS_UNIT_ASSERT_EQUAL(builder->entry_count, 1);
+    AVS_UNIT_ASSERT_TRUE(is_entry_valid(LAST_ENTRY(builder),
                                         INT_RID,
                                         ANJAY_ID_INVALID,
                                         (anjay_batch_data_t) {
@@ -318,8 +320,8 @@ AVS_UNIT_TEST(dm_batch, single_uint) {
 
     AVS_UNIT_ASSERT_SUCCESS(add_current(builder, anjay, UINT_RID));
 
-    AVS_UNIT_ASSERT_EQUAL(AVS_LIST_SIZE(builder->list), 1);
-    AVS_UNIT_ASSERT_TRUE(is_entry_valid(AVS_LIST_TAIL(builder->list),
+    AVS_UNIT_ASSERT_EQUAL(builder->entry_count, 1);
+    AVS_UNIT_ASSERT_TRUE(is_entry_valid(LAST_ENTRY(builder),
                                         UINT_RID,
                                         ANJAY_ID_INVALID,
                                         (anjay_batch_data_t) {
@@ -336,8 +338,8 @@ AVS_UNIT_TEST(dm_batch, single_double) {
 
     AVS_UNIT_ASSERT_SUCCESS(add_current(builder, anjay, DOUBLE_RID));
 
-    AVS_UNIT_ASSERT_EQUAL(AVS_LIST_SIZE(builder->list), 1);
-    AVS_UNIT_ASSERT_TRUE(is_entry_valid(AVS_LIST_TAIL(builder->list),
+    AVS_UNIT_ASSERT_EQUAL(builder->entry_count, 1);
+    AVS_UNIT_ASSERT_TRUE(is_entry_valid(LAST_ENTRY(builder),
                                         DOUBLE_RID,
                                         ANJAY_ID_INVALID,
                                         (anjay_batch_data_t) {
@@ -354,8 +356,8 @@ AVS_UNIT_TEST(dm_batch, single_bool) {
 
     AVS_UNIT_ASSERT_SUCCESS(add_current(builder, anjay, BOOL_RID));
 
-    AVS_UNIT_ASSERT_EQUAL(AVS_LIST_SIZE(builder->list), 1);
-    AVS_UNIT_ASSERT_TRUE(is_entry_valid(AVS_LIST_TAIL(builder->list),
+    AVS_UNIT_ASSERT_EQUAL(builder->entry_count, 1);
+    AVS_UNIT_ASSERT_TRUE(is_entry_valid(LAST_ENTRY(builder),
                                         BOOL_RID,
                                         ANJAY_ID_INVALID,
                                         (anjay_batch_data_t) {
@@ -372,8 +374,8 @@ AVS_UNIT_TEST(dm_batch, single_objlnk) {
 
     AVS_UNIT_ASSERT_SUCCESS(add_current(builder, anjay, OBJLNK_RID));
 
-    AVS_UNIT_ASSERT_EQUAL(AVS_LIST_SIZE(builder->list), 1);
-    AVS_UNIT_ASSERT_TRUE(is_entry_valid(AVS_LIST_TAIL(builder->list),
+    AVS_UNIT_ASSERT_EQUAL(builder->entry_count, 1);
+    AVS_UNIT_ASSERT_TRUE(is_entry_valid(LAST_ENTRY(builder),
                                         OBJLNK_RID,
                                         ANJAY_ID_INVALID,
                                         (anjay_batch_data_t) {
@@ -390,7 +392,7 @@ AVS_UNIT_TEST(dm_batch, two_resources) {
     TEST_SETUP(MOCK_CLOCK_START_RELATIVE);
 
     AVS_UNIT_ASSERT_SUCCESS(add_current(builder, anjay, INT_RID));
-    AVS_UNIT_ASSERT_TRUE(is_entry_valid(AVS_LIST_TAIL(builder->list),
+    AVS_UNIT_ASSERT_TRUE(is_entry_valid(LAST_ENTRY(builder),
                                         INT_RID,
                                         ANJAY_ID_INVALID,
                                         (anjay_batch_data_t) {
@@ -401,7 +403,7 @@ AVS_UNIT_TEST(dm_batch, two_resources) {
                                         }));
 
     AVS_UNIT_ASSERT_SUCCESS(add_current(builder, anjay, DOUBLE_RID));
-    AVS_UNIT_ASSERT_TRUE(is_entry_valid(AVS_LIST_TAIL(builder->list),
+    AVS_UNIT_ASSERT_TRUE(is_entry_valid(LAST_ENTRY(builder),
                                         DOUBLE_RID,
                                         ANJAY_ID_INVALID,
                                         (anjay_batch_data_t) {
@@ -411,7 +413,7 @@ AVS_UNIT_TEST(dm_batch, two_resources) {
                                             }
                                         }));
 
-    AVS_UNIT_ASSERT_EQUAL(AVS_LIST_SIZE(builder->list), 2);
+    AVS_UNIT_ASSERT_EQUAL(builder->entry_count, 2);
 
     TEST_TEARDOWN();
 }
@@ -420,18 +422,16 @@ AVS_UNIT_TEST(dm_batch, multiple_instance_resource) {
     TEST_SETUP(MOCK_CLOCK_START_RELATIVE);
 
     AVS_UNIT_ASSERT_SUCCESS(add_current(builder, anjay, INT_ARRAY_RID));
-    AVS_UNIT_ASSERT_EQUAL(AVS_LIST_SIZE(builder->list), int_array_size + 1);
-
-    AVS_UNIT_ASSERT_TRUE(
-            is_entry_valid(builder->list, INT_ARRAY_RID, ANJAY_ID_INVALID,
-                           (anjay_batch_data_t) {
-                               .type = ANJAY_BATCH_DATA_START_AGGREGATE
-                           }));
-
-    anjay_batch_entry_t *entry;
-    uint16_t riid = 0;
-    AVS_LIST_FOREACH(entry, AVS_LIST_NEXT(builder->list)) {
-        AVS_UNIT_ASSERT_TRUE(is_entry_valid(entry,
+    AVS_UNIT_ASSERT_EQUAL(builder->entry_count, int_array_size + 1);
+
+    AVS_UNIT_ASSERT_TRUE(is_entry_valid(
+            &builder->entries[0], INT_ARRAY_RID, ANJAY_ID_INVALID,
+            (anjay_batch_data_t) {
+                .type = ANJAY_BATCH_DATA_START_AGGREGATE
+            }));
+
+    for (uint16_t riid = 0; riid < int_array_size; ++riid) {
+        AVS_UNIT_ASSERT_TRUE(is_entry_valid(&builder->entries[riid + 1],
                                             INT_ARRAY_RID,
                                             riid,
                                             (anjay_batch_data_t) {
@@ -440,7 +440,6 @@ AVS_UNIT_TEST(dm_batch, multiple_instance_resource) {
                                                     .int_value = int_array[riid]
                                                 }
                                             }));
-        riid++;
     }
 
     TEST_TEARDOWN();
@@ -449,13 +448,10 @@ AVS_UNIT_TEST(dm_batch, multiple_instance_resource) {
 AVS_UNIT_TEST(dm_batch, illegal_op) {
     TEST_SETUP(MOCK_CLOCK_START_RELATIVE);
 
-    AVS_LIST(anjay_batch_entry_t) *initial_append_ptr = builder->append_ptr;
-
     AVS_UNIT_ASSERT_FAILED(add_current(builder, anjay, ILLEGAL_IMPL_RID));
 
-    AVS_UNIT_ASSERT_EQUAL(AVS_LIST_SIZE(builder->list), 0);
-    AVS_UNIT_ASSERT_TRUE(builder->append_ptr == initial_append_ptr);
-    AVS_UNIT_ASSERT_NULL(*builder->append_ptr);
+    AVS_UNIT_ASSERT_EQUAL(builder->entry_count, 0);
+    AVS_UNIT_ASSERT_NULL(builder->arena);
 
     TEST_TEARDOWN();
 }
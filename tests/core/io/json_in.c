@@ -239,6 +239,45 @@ AVS_UNIT_TEST(json_in_object, with_some_instances_and_some_resources) {
     TEST_TEARDOWN(OK);
 }
 
+AVS_UNIT_TEST(json_in_object, basename_and_names) {
+    static const char RESOURCES[] =
+            "[ { \"bn\": \"/13/26\", \"n\": \"/1\", \"v\": 42 }, "
+            "{ \"n\": \"/2/3\", \"v\": 43 }, "
+            "{ \"bn\": \"/13/\", \"n\": \"27/3\", \"v\": 44 }, "
+            "{ \"bn\": \"/13/27/4\", \"v\": 45 }, "
+            "{ \"bn\": \"\", \"n\": \"/13/28/5\", \"v\": 46 } ]";
+    TEST_ENV(RESOURCES, MAKE_OBJECT_PATH(13));
+    check_paths(in,
+                (const anjay_uri_path_t[5]) {
+                        MAKE_RESOURCE_PATH(13, 26, 1),
+                        MAKE_RESOURCE_INSTANCE_PATH(13, 26, 2, 3),
+                        MAKE_RESOURCE_PATH(13, 27, 3),
+                        MAKE_RESOURCE_PATH(13, 27, 4),
+                        MAKE_RESOURCE_PATH(13, 28, 5) },
+                5);
+    TEST_TEARDOWN(OK);
+}
+
+AVS_UNIT_TEST(json_in_object, invalid_basename_and_name) {
+    static const char RESOURCES[] =
+            "[ { \"bn\": \"/\", \"n\": \"/13/26/1\", \"v\": 42 } ]";
+    TEST_ENV(RESOURCES, MAKE_OBJECT_PATH(13));
+
+    anjay_uri_path_t path;
+    ASSERT_FAIL(_anjay_input_get_path(in, &path, NULL));
+    TEST_TEARDOWN(OK);
+}
+
+AVS_UNIT_TEST(json_in_object, basename_and_name_too_many_ids) {
+    static const char RESOURCES[] =
+            "[ { \"bn\": \"/13/26/1\", \"n\": \"/2/3\", \"v\": 42 } ]";
+    TEST_ENV(RESOURCES, MAKE_OBJECT_PATH(13));
+
+    anjay_uri_path_t path;
+    ASSERT_FAIL(_anjay_input_get_path(in, &path, NULL));
+    TEST_TEARDOWN(OK);
+}
+
 #define TEST_VALUE_ENV(TypeAndValue)                                           \
     static const char RESOURCE[] =                                             \
             "[ { \"n\": \"/13/26/1\", " TypeAndValue " } ]";                   \
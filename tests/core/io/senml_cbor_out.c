@@ -419,3 +419,33 @@ AVS_UNIT_TEST(senml_cbor_out, mixed_data_end_device_with_gateway) {
 }
 
 #endif // ANJAY_WITH_LWM2M_GATEWAY
+
+AVS_UNIT_TEST(senml_cbor_out, name_cache) {
+    TEST_ENV(TEST_OBJ_INST(13, 26), 0);
+    senml_out_t *ctx = (senml_out_t *) out;
+    ASSERT_OK(_anjay_output_clear_path(out));
+
+    // Iterate over paths in the order in which they are typically returned,
+    // so that consecutive names share most of the leading segments, and
+    // ensure that reusing them does not affect the generated names
+    for (anjay_rid_t rid = 0; rid < 3; ++rid) {
+        for (anjay_riid_t riid = 0; riid < 1200; riid = 2 * riid + 1) {
+            const anjay_uri_path_t path =
+                    TEST_OBJ_INST_RES_INST(13, 26, rid * 500, riid);
+            char expected[MAX_PATH_STRING_SIZE];
+            ASSERT_TRUE(avs_simple_snprintf(expected, sizeof(expected),
+                                            "/%u/%u", (unsigned) (rid * 500),
+                                            (unsigned) riid)
+                        > 0);
+            ASSERT_OK(_anjay_output_set_path(out, &path));
+            ASSERT_EQ_STR(maybe_get_name(ctx), expected);
+            ASSERT_OK(_anjay_output_clear_path(out));
+        }
+        const anjay_uri_path_t path = TEST_OBJ_INST_RES(13, 26, 65534);
+        ASSERT_OK(_anjay_output_set_path(out, &path));
+        ASSERT_EQ_STR(maybe_get_name(ctx), "/65534");
+        ASSERT_OK(_anjay_output_clear_path(out));
+    }
+
+    ASSERT_OK(_anjay_output_ctx_destroy(&out));
+}
@@ -114,17 +114,16 @@ AVS_UNIT_TEST(text_out, f64) {
     TEST_DOUBLE(1);
     TEST_DOUBLE(1.2);
     TEST_DOUBLE(1.3125);
-#ifdef AVS_COMMONS_WITHOUT_FLOAT_FORMAT_SPECIFIERS
-    // NOTE: This variant of AVS_DOUBLE_AS_STRING() is slightly inaccurate in
-    // order to keep the implementation simpler. This level of inaccuracy is
-    // unlikely to cause problems in real-world applications.
-    TEST_DOUBLE_IMPL(4.2229999965160742e+37, "4.2229999965160736e+37");
-#else  // AVS_COMMONS_WITHOUT_FLOAT_FORMAT_SPECIFIERS
-    TEST_DOUBLE(4.2229999965160742e+37);
-#endif // AVS_COMMONS_WITHOUT_FLOAT_FORMAT_SPECIFIERS
+    // Shortest representation that round-trips. NOTE: AVS_DOUBLE_AS_STRING()
+    // is slightly inaccurate in the 17th digit when
+    // AVS_COMMONS_WITHOUT_FLOAT_FORMAT_SPECIFIERS is enabled. That does not
+    // matter here, as 16 digits are enough for this value.
+    TEST_DOUBLE_IMPL(4.2229999965160742e+37, "4.222999996516074e+37");
     TEST_DOUBLE(10000.5);
     TEST_DOUBLE(10000000000000.5);
     TEST_DOUBLE(3.26e+218);
+    TEST_DOUBLE(21.5);
+    TEST_DOUBLE(-0.1);
 }
 
 #undef TEST_DOUBLE
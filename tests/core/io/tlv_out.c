@@ -332,6 +332,48 @@ AVS_UNIT_TEST(tlv_out, object_with_empty_bytes) {
     AVS_UNIT_ASSERT_SUCCESS(_anjay_output_ctx_destroy(&out));
 }
 
+AVS_UNIT_TEST(tlv_out, large_multi_instance_read) {
+    // Each Resource Instance is 8 bytes long; its header takes 3 bytes for
+    // RIIDs below 256 and 4 bytes otherwise. Both the Object Instance and the
+    // Multiple-Instance Resource have 4-byte headers (16-bit length).
+    enum {
+        INSTANCES = 3,
+        RESOURCE_INSTANCES = 1000,
+        ARRAY_LENGTH = 256 * 11 + (RESOURCE_INSTANCES - 256) * 12,
+        INSTANCE_LENGTH = 4 + ARRAY_LENGTH,
+        TOTAL_LENGTH = INSTANCES * (4 + INSTANCE_LENGTH)
+    };
+    TEST_ENV(TOTAL_LENGTH, &MAKE_OBJECT_PATH(0));
+
+    for (anjay_iid_t iid = 0; iid < INSTANCES; ++iid) {
+        for (anjay_riid_t riid = 0; riid < RESOURCE_INSTANCES; ++riid) {
+            AVS_UNIT_ASSERT_SUCCESS(_anjay_output_set_path(
+                    out, &MAKE_RESOURCE_INSTANCE_PATH(0, iid, 1, riid)));
+            AVS_UNIT_ASSERT_SUCCESS(
+                    _anjay_ret_string_unlocked(out, "abcdefgh"));
+        }
+    }
+    AVS_UNIT_ASSERT_SUCCESS(_anjay_output_ctx_destroy(&out));
+    AVS_UNIT_ASSERT_EQUAL(avs_stream_outbuf_offset(&outbuf), TOTAL_LENGTH);
+
+    for (anjay_iid_t iid = 0; iid < INSTANCES; ++iid) {
+        const char *instance = buf + iid * (4 + INSTANCE_LENGTH);
+        const char header[] = {
+            '\x10', (char) iid, '\x2D', '\xE4', // Object Instance, 11748 B
+            '\x90', '\x01', '\x2D', '\xE0',     // Resource 1, 11744 B
+            '\x48', '\x00', '\x08'              // Resource Instance 0, 8 B
+        };
+        AVS_UNIT_ASSERT_EQUAL_BYTES_SIZED(instance, header, sizeof(header));
+        AVS_UNIT_ASSERT_EQUAL_BYTES_SIZED(instance + sizeof(header), "abcdefgh",
+                                          8);
+        // Resource Instance 999
+        AVS_UNIT_ASSERT_EQUAL_BYTES_SIZED(instance + 4 + INSTANCE_LENGTH - 12,
+                                          "\x68\x03\xE7\x08"
+                                          "abcdefgh",
+                                          12);
+    }
+}
+
 //////////////////////////////////////////// ENCODING // ADDITIONAL CORNER CASES
 
 AVS_UNIT_TEST(tlv_out, riid_as_root) {
@@ -712,7 +712,7 @@ AVS_UNIT_TEST(anjay_send, add_multiple_successful) {
     AVS_UNIT_ASSERT_SUCCESS(anjay_send_batch_data_add_current_multiple(
             builder, anjay, paths, AVS_ARRAY_SIZE(paths)));
     AVS_UNIT_ASSERT_EQUAL(
-            AVS_LIST_SIZE(((anjay_batch_builder_t *) builder)->list), 2);
+            ((anjay_batch_builder_t *) builder)->entry_count, 2);
     anjay_send_batch_builder_cleanup(&builder);
     DM_TEST_FINISH;
 }
@@ -722,9 +722,6 @@ AVS_UNIT_TEST(anjay_send, add_multiple_single_resource_fail) {
     anjay_send_batch_builder_t *builder = anjay_send_batch_builder_new();
     AVS_UNIT_ASSERT_NOT_NULL(builder);
 
-    AVS_LIST(anjay_batch_entry_t) *initial_append_ptr =
-            ((anjay_batch_builder_t *) builder)->append_ptr;
-
     _anjay_mock_dm_expect_list_instances(
             anjay, &OBJ, 0, (const anjay_iid_t[]) { 1, ANJAY_ID_INVALID });
     _anjay_mock_dm_expect_list_resources(
@@ -741,10 +738,8 @@ AVS_UNIT_TEST(anjay_send, add_multiple_single_resource_fail) {
     AVS_UNIT_ASSERT_FAILED(anjay_send_batch_data_add_current_multiple(
             builder, anjay, paths, AVS_ARRAY_SIZE(paths)));
     AVS_UNIT_ASSERT_EQUAL(
-            AVS_LIST_SIZE(((anjay_batch_builder_t *) builder)->list), 0);
-    AVS_UNIT_ASSERT_TRUE(initial_append_ptr
-                         == ((anjay_batch_builder_t *) builder)->append_ptr);
-    AVS_UNIT_ASSERT_NULL(*((anjay_batch_builder_t *) builder)->append_ptr);
+            ((anjay_batch_builder_t *) builder)->entry_count, 0);
+    AVS_UNIT_ASSERT_NULL(((anjay_batch_builder_t *) builder)->arena);
     anjay_send_batch_builder_cleanup(&builder);
     DM_TEST_FINISH;
 }
@@ -803,16 +798,15 @@ AVS_UNIT_TEST(anjay_send, add_multiple_twice_with_fail) {
     AVS_UNIT_ASSERT_SUCCESS(anjay_send_batch_data_add_current_multiple(
             builder, anjay, paths, AVS_ARRAY_SIZE(paths)));
 
-    AVS_LIST(anjay_batch_entry_t) *pre_fail_append_ptr =
-            ((anjay_batch_builder_t *) builder)->append_ptr;
+    const anjay_batch_builder_mark_t pre_fail_mark =
+            _anjay_batch_builder_mark((anjay_batch_builder_t *) builder);
 
     AVS_UNIT_ASSERT_FAILED(anjay_send_batch_data_add_current_multiple(
             builder, anjay, paths, AVS_ARRAY_SIZE(paths)));
     AVS_UNIT_ASSERT_EQUAL(
-            AVS_LIST_SIZE(((anjay_batch_builder_t *) builder)->list), 2);
-    AVS_UNIT_ASSERT_TRUE(pre_fail_append_ptr
-                         == ((anjay_batch_builder_t *) builder)->append_ptr);
-    AVS_UNIT_ASSERT_NULL(*((anjay_batch_builder_t *) builder)->append_ptr);
+            ((anjay_batch_builder_t *) builder)->entry_count, 2);
+    AVS_UNIT_ASSERT_TRUE(pre_fail_mark.arena_head
+                         == ((anjay_batch_builder_t *) builder)->arena);
     anjay_send_batch_builder_cleanup(&builder);
     DM_TEST_FINISH;
 }
@@ -862,7 +856,7 @@ AVS_UNIT_TEST(anjay_send, add_multiple_ignore_not_found) {
             anjay_send_batch_data_add_current_multiple_ignore_not_found(
                     builder, anjay, paths, AVS_ARRAY_SIZE(paths)));
     AVS_UNIT_ASSERT_EQUAL(
-            AVS_LIST_SIZE(((anjay_batch_builder_t *) builder)->list), 1);
+            ((anjay_batch_builder_t *) builder)->entry_count, 1);
 
     _anjay_mock_dm_expect_list_instances(
             anjay, &OBJ, 0, (const anjay_iid_t[]) { 1, ANJAY_ID_INVALID });
@@ -878,7 +872,7 @@ AVS_UNIT_TEST(anjay_send, add_multiple_ignore_not_found) {
             anjay_send_batch_data_add_current_multiple_ignore_not_found(
                     builder, anjay, paths, 1));
     AVS_UNIT_ASSERT_EQUAL(
-            AVS_LIST_SIZE(((anjay_batch_builder_t *) builder)->list), 1);
+            ((anjay_batch_builder_t *) builder)->entry_count, 1);
 
     // This should not be ignored.
     _anjay_mock_dm_expect_list_instances(
@@ -894,7 +888,7 @@ AVS_UNIT_TEST(anjay_send, add_multiple_ignore_not_found) {
             anjay_send_batch_data_add_current_multiple_ignore_not_found(
                     builder, anjay, paths, 1));
     AVS_UNIT_ASSERT_EQUAL(
-            AVS_LIST_SIZE(((anjay_batch_builder_t *) builder)->list), 1);
+            ((anjay_batch_builder_t *) builder)->entry_count, 1);
 
     _anjay_mock_dm_expect_list_instances(
             anjay, &OBJ, 0, (const anjay_iid_t[]) { 1, ANJAY_ID_INVALID });
@@ -908,7 +902,7 @@ AVS_UNIT_TEST(anjay_send, add_multiple_ignore_not_found) {
     AVS_UNIT_ASSERT_SUCCESS(
             anjay_send_batch_data_add_current(builder, anjay, 42, 1, 1));
     AVS_UNIT_ASSERT_EQUAL(
-            AVS_LIST_SIZE(((anjay_batch_builder_t *) builder)->list), 2);
+            ((anjay_batch_builder_t *) builder)->entry_count, 2);
 
     anjay_send_batch_builder_cleanup(&builder);
     DM_TEST_FINISH;
@@ -24,26 +24,37 @@
 
 #define MSG_ID_BASE 0x0000
 
-static void assert_observe_consistency(anjay_t *anjay_locked) {
-    ANJAY_MUTEX_LOCK(anjay, anjay_locked);
-    AVS_LIST(anjay_observe_connection_entry_t) conn;
-    AVS_LIST_FOREACH(conn, anjay->observe.connection_entries) {
-        size_t path_refs_in_observations = 0;
-        AVS_SORTED_SET_ELEM(anjay_observation_t) observation;
-        AVS_SORTED_SET_FOREACH(observation, conn->observations) {
-            path_refs_in_observations += observation->paths_count;
-        }
+static size_t assert_observed_paths_consistency(
+        anjay_unlocked_t *anjay,
+        AVS_SORTED_SET(anjay_observe_path_entry_t) path_entries,
+        size_t depth) {
+    if (!path_entries) {
+        return 0;
+    }
+    AVS_UNIT_ASSERT_NOT_NULL(AVS_SORTED_SET_FIRST(path_entries));
+
+    size_t path_refs = 0;
+    AVS_SORTED_SET_ELEM(anjay_observe_path_entry_t) path_entry;
+    AVS_SORTED_SET_FOREACH(path_entry, path_entries) {
+        AVS_UNIT_ASSERT_EQUAL(_anjay_uri_path_length(&path_entry->path),
+                              depth);
+        AVS_UNIT_ASSERT_TRUE(path_entry->conn_entries || path_entry->children);
+
+        AVS_LIST(anjay_observe_path_conn_entry_t) conn_entry;
+        AVS_LIST_FOREACH(conn_entry, path_entry->conn_entries) {
+            AVS_UNIT_ASSERT_NOT_NULL(AVS_LIST_FIND_PTR(
+                    &anjay->observe.connection_entries, conn_entry->conn));
+            AVS_UNIT_ASSERT_NOT_NULL(conn_entry->refs);
 
-        size_t path_refs = 0;
-        AVS_SORTED_SET_ELEM(anjay_observe_path_entry_t) path_entry;
-        AVS_SORTED_SET_FOREACH(path_entry, conn->observed_paths) {
             AVS_LIST(AVS_SORTED_SET_ELEM(anjay_observation_t)) ref;
-            AVS_LIST_FOREACH(ref, path_entry->refs) {
+            AVS_LIST_FOREACH(ref, conn_entry->refs) {
                 ++path_refs;
                 AVS_UNIT_ASSERT_NOT_NULL(ref);
                 AVS_UNIT_ASSERT_NOT_NULL(*ref);
                 AVS_UNIT_ASSERT_TRUE(
-                        AVS_SORTED_SET_FIND(conn->observations, *ref) == *ref);
+                        AVS_SORTED_SET_FIND(conn_entry->conn->observations,
+                                            *ref)
+                        == *ref);
                 bool path_found = false;
                 for (size_t i = 0; i < (*ref)->paths_count; ++i) {
                     if (_anjay_uri_path_equal(&(*ref)->paths[i],
@@ -55,8 +66,74 @@ static void assert_observe_consistency(anjay_t *anjay_locked) {
                 AVS_UNIT_ASSERT_TRUE(path_found);
             }
         }
-        AVS_UNIT_ASSERT_EQUAL(path_refs_in_observations, path_refs);
+
+        if (path_entry->children) {
+            AVS_SORTED_SET_ELEM(anjay_observe_path_entry_t) child;
+            AVS_SORTED_SET_FOREACH(child, path_entry->children) {
+                AVS_UNIT_ASSERT_FALSE(_anjay_uri_path_outside_base(
+                        &child->path, &path_entry->path));
+            }
+        }
+        path_refs += assert_observed_paths_consistency(
+                anjay, path_entry->children, depth + 1);
+    }
+    return path_refs;
+}
+
+static void assert_observe_consistency(anjay_t *anjay_locked) {
+    ANJAY_MUTEX_LOCK(anjay, anjay_locked);
+    size_t path_refs_in_observations = 0;
+    AVS_LIST(anjay_observe_connection_entry_t) conn;
+    AVS_LIST_FOREACH(conn, anjay->observe.connection_entries) {
+        AVS_UNIT_ASSERT_TRUE(conn->observe == &anjay->observe);
+        size_t planned_triggers = 0;
+        AVS_SORTED_SET_ELEM(anjay_observation_t) observation;
+        AVS_SORTED_SET_FOREACH(observation, conn->observations) {
+            path_refs_in_observations += observation->paths_count;
+            if (avs_time_monotonic_valid(observation->trigger_time)) {
+                ++planned_triggers;
+            }
+        }
+
+        size_t triggers_in_buckets = 0;
+        AVS_SORTED_SET_ELEM(anjay_observe_trigger_bucket_t) bucket = NULL;
+        if (conn->trigger_buckets) {
+            AVS_SORTED_SET_FOREACH(bucket, conn->trigger_buckets) {
+                AVS_UNIT_ASSERT_NOT_NULL(bucket->first);
+                AVS_UNIT_ASSERT_NULL(bucket->first->trigger_prev);
+                AVS_UNIT_ASSERT_NULL(bucket->last->trigger_next);
+                for (observation = bucket->first; observation;
+                     observation = observation->trigger_next) {
+                    AVS_UNIT_ASSERT_TRUE(avs_time_duration_equal(
+                            observation->trigger_time.since_monotonic_epoch,
+                            bucket->time.since_monotonic_epoch));
+                    AVS_UNIT_ASSERT_TRUE(
+                            observation->trigger_next
+                                    ? observation->trigger_next->trigger_prev
+                                              == observation
+                                    : bucket->last == observation);
+                    ++triggers_in_buckets;
+                }
+            }
+            bucket = AVS_SORTED_SET_FIRST(conn->trigger_buckets);
+        }
+        AVS_UNIT_ASSERT_EQUAL(planned_triggers, triggers_in_buckets);
+        if (bucket) {
+            AVS_UNIT_ASSERT_NOT_NULL(conn->trigger_task);
+            AVS_UNIT_ASSERT_FALSE(avs_time_monotonic_before(
+                    bucket->time, avs_sched_time(&conn->trigger_task)));
+        } else {
+            AVS_UNIT_ASSERT_NULL(conn->trigger_task);
+        }
+    }
+
+    size_t path_refs = 0;
+    if (anjay->observe.observed_paths
+            && AVS_SORTED_SET_FIRST(anjay->observe.observed_paths)) {
+        path_refs = assert_observed_paths_consistency(
+                anjay, anjay->observe.observed_paths, 0);
     }
+    AVS_UNIT_ASSERT_EQUAL(path_refs_in_observations, path_refs);
     ANJAY_MUTEX_UNLOCK(anjay_locked);
 }
 
@@ -648,6 +725,115 @@ AVS_UNIT_TEST(observe, gc) {
     DM_TEST_FINISH;
 }
 
+typedef struct {
+    const anjay_uri_path_t *query;
+    size_t matched_refs;
+    const anjay_uri_path_t *last_path;
+} path_trie_matching_state_t;
+
+static int
+path_trie_matching_clb(anjay_observe_path_entry_t *path_entry,
+                       anjay_observe_path_conn_entry_t *conn_entry,
+                       void *state_) {
+    path_trie_matching_state_t *state = (path_trie_matching_state_t *) state_;
+    AVS_UNIT_ASSERT_NOT_NULL(conn_entry->refs);
+    const size_t query_length = _anjay_uri_path_length(state->query);
+    const size_t length = _anjay_uri_path_length(&path_entry->path);
+    if (state->last_path) {
+        const size_t last_length = _anjay_uri_path_length(state->last_path);
+        if (length < query_length) {
+            // ancestors of the query are visited first, from the root down
+            AVS_UNIT_ASSERT_TRUE(last_length <= length);
+        } else {
+            // then the subtree, in the same order as in a sorted set
+            AVS_UNIT_ASSERT_TRUE(
+                    last_length < query_length
+                    || _anjay_uri_path_compare(state->last_path,
+                                               &path_entry->path)
+                                   <= 0);
+        }
+    }
+    state->last_path = &path_entry->path;
+    state->matched_refs += AVS_LIST_SIZE(conn_entry->refs);
+    return 0;
+}
+
+static size_t path_trie_count_matching(anjay_observe_state_t *observe,
+                                       const anjay_uri_path_t *path) {
+    path_trie_matching_state_t state = {
+        .query = path
+    };
+    AVS_UNIT_ASSERT_SUCCESS(observe_for_each_matching(
+            observe, path, path_trie_matching_clb, &state));
+    return state.matched_refs;
+}
+
+AVS_UNIT_TEST(observe, path_trie_matching) {
+    static const anjay_uri_path_t PATHS[] = {
+        ROOT_PATH_INITIALIZER(),
+        OBJECT_PATH_INITIALIZER(42),
+        INSTANCE_PATH_INITIALIZER(42, 69),
+        RESOURCE_PATH_INITIALIZER(42, 69, 4),
+        RESOURCE_INSTANCE_PATH_INITIALIZER(42, 69, 4, 1),
+        RESOURCE_PATH_INITIALIZER(42, 69, 5),
+        INSTANCE_PATH_INITIALIZER(42, 70),
+        OBJECT_PATH_INITIALIZER(43)
+    };
+    // observations are only referenced by address in the trie
+    avs_max_align_t observations[AVS_ARRAY_SIZE(PATHS)];
+
+    anjay_observe_state_t observe = { 0 };
+    anjay_observe_connection_entry_t conns[] = {
+        { .observe = &observe },
+        { .observe = &observe }
+    };
+    for (size_t i = 0; i < AVS_ARRAY_SIZE(PATHS); ++i) {
+        AVS_UNIT_ASSERT_SUCCESS(add_path_to_observed_paths(
+                &conns[i % 2], &PATHS[i],
+                (anjay_observation_t *) &observations[i]));
+    }
+    // second connection observing the same path
+    AVS_UNIT_ASSERT_SUCCESS(add_path_to_observed_paths(
+            &conns[1], &PATHS[4], (anjay_observation_t *) &observations[4]));
+
+    AVS_UNIT_ASSERT_EQUAL(path_trie_count_matching(&observe, &MAKE_ROOT_PATH()),
+                          9);
+    AVS_UNIT_ASSERT_EQUAL(
+            path_trie_count_matching(&observe, &MAKE_INSTANCE_PATH(42, 69)), 7);
+    AVS_UNIT_ASSERT_EQUAL(
+            path_trie_count_matching(&observe, &MAKE_RESOURCE_PATH(42, 69, 4)),
+            6);
+    AVS_UNIT_ASSERT_EQUAL(path_trie_count_matching(
+                                  &observe, &MAKE_RESOURCE_PATH(42, 70, 1)),
+                          3);
+    AVS_UNIT_ASSERT_EQUAL(
+            path_trie_count_matching(&observe, &MAKE_INSTANCE_PATH(43, 1)), 2);
+    AVS_UNIT_ASSERT_EQUAL(
+            path_trie_count_matching(&observe, &MAKE_OBJECT_PATH(44)), 1);
+
+    remove_path_from_observed_paths(&conns[0], &PATHS[0],
+                                    (anjay_observation_t *) &observations[0]);
+    remove_path_from_observed_paths(&conns[0], &PATHS[2],
+                                    (anjay_observation_t *) &observations[2]);
+    remove_path_from_observed_paths(&conns[1], &PATHS[4],
+                                    (anjay_observation_t *) &observations[4]);
+    AVS_UNIT_ASSERT_EQUAL(
+            path_trie_count_matching(&observe, &MAKE_RESOURCE_PATH(42, 69, 4)),
+            3);
+    AVS_UNIT_ASSERT_EQUAL(
+            path_trie_count_matching(&observe, &MAKE_OBJECT_PATH(44)), 0);
+
+    for (size_t i = 1; i < AVS_ARRAY_SIZE(PATHS); ++i) {
+        if (i != 2) {
+            remove_path_from_observed_paths(
+                    &conns[i % 2], &PATHS[i],
+                    (anjay_observation_t *) &observations[i]);
+        }
+    }
+    AVS_UNIT_ASSERT_NULL(AVS_SORTED_SET_FIRST(observe.observed_paths));
+    AVS_SORTED_SET_DELETE(&observe.observed_paths);
+}
+
 static void expect_read_res_attrs(anjay_t *anjay,
                                   const anjay_dm_object_def_t *const *obj_ptr,
                                   anjay_ssid_t ssid,
@@ -791,10 +977,10 @@ static void notify_max_period_test(const char *con_notify_ack,
                    "Hello", 5);
 
     ANJAY_MUTEX_LOCK(anjay_unlocked, anjay);
-    AVS_UNIT_ASSERT_NOT_NULL(
+    AVS_UNIT_ASSERT_TRUE(avs_time_monotonic_valid(
             AVS_SORTED_SET_FIRST(
                     anjay_unlocked->observe.connection_entries->observations)
-                    ->notify_task);
+                    ->trigger_time));
     AVS_UNIT_ASSERT_EQUAL(
             AVS_SORTED_SET_FIRST(
                     anjay_unlocked->observe.connection_entries->observations)
@@ -935,14 +1121,287 @@ AVS_UNIT_TEST(notify, min_period) {
     assert_observe_consistency(anjay);
     assert_observe_size(anjay, 1);
     ANJAY_MUTEX_LOCK(anjay_unlocked, anjay);
-    AVS_UNIT_ASSERT_NOT_NULL(
+    AVS_UNIT_ASSERT_TRUE(avs_time_monotonic_valid(
             AVS_SORTED_SET_FIRST(
                     anjay_unlocked->observe.connection_entries->observations)
-                    ->notify_task);
+                    ->trigger_time));
+    ANJAY_MUTEX_UNLOCK(anjay);
+
+    DM_TEST_FINISH;
+}
+
+static bool monotonic_equal(avs_time_monotonic_t left,
+                            avs_time_monotonic_t right) {
+    return !avs_time_monotonic_before(left, right)
+           && !avs_time_monotonic_before(right, left);
+}
+
+AVS_UNIT_TEST(notify, coalesced_triggers) {
+    DM_TEST_INIT_WITH_SSIDS(14);
+    ANJAY_MUTEX_LOCK(anjay_unlocked, anjay);
+    anjay_observe_connection_entry_t conn = {
+        .conn_ref = {
+            .server = _anjay_servers_find_active(anjay_unlocked, 14),
+            .conn_type = ANJAY_CONNECTION_PRIMARY
+        },
+        .observe = &anjay_unlocked->observe
+    };
+    AVS_UNIT_ASSERT_NOT_NULL(conn.conn_ref.server);
+
+    anjay_observation_t *observations[4];
+    for (size_t i = 0; i < AVS_ARRAY_SIZE(observations); ++i) {
+        observations[i] = (anjay_observation_t *) avs_calloc(
+                1, sizeof(anjay_observation_t));
+        AVS_UNIT_ASSERT_NOT_NULL(observations[i]);
+        observations[i]->trigger_time = AVS_TIME_MONOTONIC_INVALID;
+    }
+
+    const avs_time_monotonic_t now = avs_time_monotonic_now();
+    const avs_time_monotonic_t t0 = avs_time_monotonic_add(
+            now, avs_time_duration_from_scalar(5, AVS_TIME_S));
+    const avs_time_monotonic_t t1 = avs_time_monotonic_add(
+            now, avs_time_duration_from_scalar(10, AVS_TIME_S));
+    const avs_time_monotonic_t t2 = avs_time_monotonic_add(
+            now, avs_time_duration_from_scalar(20, AVS_TIME_S));
+
+    // instants within a tick are rounded up to its end
+    AVS_UNIT_ASSERT_TRUE(monotonic_equal(round_up_to_trigger_tick(t1), t1));
+    AVS_UNIT_ASSERT_TRUE(monotonic_equal(
+            round_up_to_trigger_tick(avs_time_monotonic_add(
+                    t1, avs_time_duration_from_scalar(1, AVS_TIME_NS))),
+            avs_time_monotonic_add(
+                    t1, avs_time_duration_from_scalar(TRIGGER_TICK_NS,
+                                                      AVS_TIME_NS))));
+
+    // triggers due at the same instant share a bucket and a scheduler job
+    AVS_UNIT_ASSERT_SUCCESS(plan_trigger(&conn, observations[0], t1));
+    AVS_UNIT_ASSERT_SUCCESS(plan_trigger(&conn, observations[1], t1));
+    AVS_UNIT_ASSERT_SUCCESS(plan_trigger(&conn, observations[2], t2));
+    AVS_UNIT_ASSERT_EQUAL(AVS_SORTED_SET_SIZE(conn.trigger_buckets), 2);
+    AVS_UNIT_ASSERT_TRUE(
+            monotonic_equal(avs_sched_time(&conn.trigger_task), t1));
+
+    AVS_UNIT_ASSERT_SUCCESS(plan_trigger(&conn, observations[3], t0));
+    AVS_UNIT_ASSERT_EQUAL(AVS_SORTED_SET_SIZE(conn.trigger_buckets), 3);
+    AVS_UNIT_ASSERT_TRUE(
+            monotonic_equal(avs_sched_time(&conn.trigger_task), t0));
+
+    // replanning moves the observation to another bucket
+    AVS_UNIT_ASSERT_SUCCESS(plan_trigger(&conn, observations[3], t1));
+    AVS_UNIT_ASSERT_EQUAL(AVS_SORTED_SET_SIZE(conn.trigger_buckets), 2);
+    AVS_UNIT_ASSERT_SUCCESS(update_trigger_task(&conn));
+    AVS_UNIT_ASSERT_TRUE(
+            monotonic_equal(avs_sched_time(&conn.trigger_task), t1));
+
+    AVS_UNIT_ASSERT_NULL(pop_due_trigger(&conn, now));
+    AVS_UNIT_ASSERT_EQUAL(count_due_triggers(&conn, now), 0);
+    AVS_UNIT_ASSERT_EQUAL(count_due_triggers(&conn, t1), 3);
+    AVS_UNIT_ASSERT_EQUAL(count_due_triggers(&conn, t2), 4);
+
+    // due triggers are handed out in the order in which they were planned
+    AVS_UNIT_ASSERT_TRUE(pop_due_trigger(&conn, t1) == observations[0]);
+    AVS_UNIT_ASSERT_TRUE(pop_due_trigger(&conn, t1) == observations[1]);
+    AVS_UNIT_ASSERT_TRUE(pop_due_trigger(&conn, t1) == observations[3]);
+    AVS_UNIT_ASSERT_NULL(pop_due_trigger(&conn, t1));
+    AVS_UNIT_ASSERT_FALSE(
+            avs_time_monotonic_valid(observations[0]->trigger_time));
+    AVS_UNIT_ASSERT_EQUAL(AVS_SORTED_SET_SIZE(conn.trigger_buckets), 1);
+    AVS_UNIT_ASSERT_SUCCESS(update_trigger_task(&conn));
+    AVS_UNIT_ASSERT_TRUE(
+            monotonic_equal(avs_sched_time(&conn.trigger_task), t2));
+
+    unplan_trigger(&conn, observations[2]);
+    AVS_UNIT_ASSERT_NULL(AVS_SORTED_SET_FIRST(conn.trigger_buckets));
+    AVS_UNIT_ASSERT_NULL(conn.trigger_task);
+
+    AVS_SORTED_SET_DELETE(&conn.trigger_buckets);
+    for (size_t i = 0; i < AVS_ARRAY_SIZE(observations); ++i) {
+        avs_free(observations[i]);
+    }
+    ANJAY_MUTEX_UNLOCK(anjay);
+    DM_TEST_FINISH;
+}
+
+AVS_UNIT_TEST(notify, read_cache) {
+    DM_TEST_INIT_WITH_SSIDS(14);
+    // the resource is expected to be read only once
+    expect_read_res(anjay, &OBJ, 69, 4, ANJAY_MOCK_DM_INT(0, 42));
+
+    ANJAY_MUTEX_LOCK(anjay_unlocked, anjay);
+    observe_read_cache_t cache = {
+        .timestamp = avs_time_real_now()
+    };
+    anjay_batch_t *batches[2] = { NULL, NULL };
+    for (size_t i = 0; i < AVS_ARRAY_SIZE(batches); ++i) {
+        AVS_UNIT_ASSERT_SUCCESS(read_observation_path_cached(
+                anjay_unlocked, &cache, &MAKE_RESOURCE_PATH(42, 69, 4),
+                ANJAY_ACTION_READ, 14, &batches[i]));
+    }
+    AVS_UNIT_ASSERT_NOT_NULL(batches[0]);
+    AVS_UNIT_ASSERT_TRUE(batches[0] == batches[1]);
+    AVS_UNIT_ASSERT_EQUAL(AVS_SORTED_SET_SIZE(cache.entries), 1);
+
+    for (size_t i = 0; i < AVS_ARRAY_SIZE(batches); ++i) {
+        _anjay_batch_release(&batches[i]);
+    }
+    observe_read_cache_cleanup(&cache);
+    ANJAY_MUTEX_UNLOCK(anjay);
+    DM_TEST_FINISH;
+}
+
+#ifdef ANJAY_WITH_ATTR_STORAGE
+AVS_UNIT_TEST(notify, attrs_cache) {
+    DM_TEST_INIT_WITH_OBJECTS(&OBJ_NOATTRS, &FAKE_SECURITY2, &FAKE_SERVER);
+    ANJAY_MUTEX_LOCK(anjay_unlocked, anjay);
+    // full set of attributes, so that the Server object is not queried
+    AVS_UNIT_ASSERT_SUCCESS(_anjay_dm_call_object_write_default_attrs(
+            anjay_unlocked,
+            _anjay_dm_find_object_by_oid(&anjay_unlocked->dm, 93), 1,
+            &(const anjay_dm_oi_attributes_t) {
+                .min_period = 1,
+                .max_period = 10,
+                .min_eval_period = 2,
+                .max_eval_period = 5
+#    ifdef ANJAY_WITH_CON_ATTR
+                ,
+                .con = ANJAY_DM_CON_ATTR_NON
+#    endif // ANJAY_WITH_CON_ATTR
+#    ifdef ANJAY_WITH_LWM2M12
+                ,
+                .hqmax = 3
+#    endif // ANJAY_WITH_LWM2M12
+            }));
+
+    anjay_observe_attrs_cache_t cache = {
+        .generation = 0
+    };
+    anjay_dm_r_attributes_t attrs;
+
+    // presence of the Instance is checked only when filling the cache
+    _anjay_mock_dm_expect_list_instances(
+            anjay, &OBJ_NOATTRS, 0,
+            (const anjay_iid_t[]) { 1, ANJAY_ID_INVALID });
+    for (int i = 0; i < 2; ++i) {
+        AVS_UNIT_ASSERT_SUCCESS(get_effective_attrs_cached(
+                anjay_unlocked, &cache, &attrs, &MAKE_INSTANCE_PATH(93, 1),
+                1));
+        AVS_UNIT_ASSERT_EQUAL(attrs.common.max_period, 10);
+    }
+    AVS_UNIT_ASSERT_EQUAL(cache.generation,
+                          anjay_unlocked->observe.attrs_generation);
+
+    _anjay_observe_attrs_changed(anjay_unlocked);
+    _anjay_mock_dm_expect_list_instances(
+            anjay, &OBJ_NOATTRS, 0,
+            (const anjay_iid_t[]) { 1, ANJAY_ID_INVALID });
+    AVS_UNIT_ASSERT_SUCCESS(get_effective_attrs_cached(
+            anjay_unlocked, &cache, &attrs, &MAKE_INSTANCE_PATH(93, 1), 1));
+    AVS_UNIT_ASSERT_EQUAL(cache.generation,
+                          anjay_unlocked->observe.attrs_generation);
+
+    // attributes inherited in place of absent entities are not cached
+    anjay_observe_attrs_cache_t absent_cache = {
+        .generation = 0
+    };
+    _anjay_mock_dm_expect_list_instances(
+            anjay, &OBJ_NOATTRS, 0,
+            (const anjay_iid_t[]) { 1, ANJAY_ID_INVALID });
+    AVS_UNIT_ASSERT_SUCCESS(get_effective_attrs_cached(
+            anjay_unlocked, &absent_cache, &attrs, &MAKE_INSTANCE_PATH(93, 2),
+            1));
+    AVS_UNIT_ASSERT_EQUAL(attrs.common.max_period, 10);
+    AVS_UNIT_ASSERT_EQUAL(absent_cache.generation, 0);
+
     ANJAY_MUTEX_UNLOCK(anjay);
+    DM_TEST_FINISH;
+}
 
+AVS_UNIT_TEST(notify, attrs_cache_resource_removed) {
+    DM_TEST_INIT_WITH_OBJECTS(&OBJ_NOATTRS, &FAKE_SECURITY2, &FAKE_SERVER);
+    ANJAY_MUTEX_LOCK(anjay_unlocked, anjay);
+    const anjay_dm_installed_object_t *obj =
+            _anjay_dm_find_object_by_oid(&anjay_unlocked->dm, 93);
+    // full set of attributes, so that the Server object is not queried
+    AVS_UNIT_ASSERT_SUCCESS(_anjay_dm_call_object_write_default_attrs(
+            anjay_unlocked, obj, 1,
+            &(const anjay_dm_oi_attributes_t) {
+                .min_period = 1,
+                .max_period = 10,
+                .min_eval_period = 2,
+                .max_eval_period = 5
+#    ifdef ANJAY_WITH_CON_ATTR
+                ,
+                .con = ANJAY_DM_CON_ATTR_NON
+#    endif // ANJAY_WITH_CON_ATTR
+#    ifdef ANJAY_WITH_LWM2M12
+                ,
+                .hqmax = 3
+#    endif // ANJAY_WITH_LWM2M12
+            }));
+    anjay_dm_r_attributes_t resource_attrs = ANJAY_DM_R_ATTRIBUTES_EMPTY;
+    resource_attrs.common.max_period = 20;
+    AVS_UNIT_ASSERT_SUCCESS(_anjay_dm_call_resource_write_attrs(
+            anjay_unlocked, obj, 1, 5, 1, &resource_attrs));
+
+    static const anjay_mock_dm_res_entry_t PRESENT[] = {
+        { 5, ANJAY_DM_RES_R, ANJAY_DM_RES_PRESENT },
+        ANJAY_MOCK_DM_RES_END
+    };
+    static const anjay_mock_dm_res_entry_t ABSENT[] = {
+        { 5, ANJAY_DM_RES_R, ANJAY_DM_RES_ABSENT },
+        ANJAY_MOCK_DM_RES_END
+    };
+
+    anjay_observe_attrs_cache_t cache = {
+        .generation = 0
+    };
+    anjay_dm_r_attributes_t attrs;
+    _anjay_mock_dm_expect_list_instances(
+            anjay, &OBJ_NOATTRS, 0,
+            (const anjay_iid_t[]) { 1, ANJAY_ID_INVALID });
+    _anjay_mock_dm_expect_list_resources(anjay, &OBJ_NOATTRS, 1, 0, PRESENT);
+    AVS_UNIT_ASSERT_SUCCESS(get_effective_attrs_cached(
+            anjay_unlocked, &cache, &attrs, &MAKE_RESOURCE_PATH(93, 1, 5), 1));
+    AVS_UNIT_ASSERT_EQUAL(attrs.common.max_period, 20);
+    AVS_UNIT_ASSERT_EQUAL(cache.generation,
+                          anjay_unlocked->observe.attrs_generation);
+
+    anjay_notify_queue_t queue = NULL;
+    AVS_UNIT_ASSERT_SUCCESS(_anjay_notify_queue_resource_change(
+            &queue, &MAKE_RESOURCE_PATH(93, 1, 5)));
+
+    // Resource still present - nothing removed, cache stays valid
+    _anjay_mock_dm_expect_list_instances(
+            anjay, &OBJ_NOATTRS, 0,
+            (const anjay_iid_t[]) { 1, ANJAY_ID_INVALID });
+    _anjay_mock_dm_expect_list_resources(anjay, &OBJ_NOATTRS, 1, 0, PRESENT);
+    AVS_UNIT_ASSERT_SUCCESS(_anjay_attr_storage_notify(anjay_unlocked, queue));
+    AVS_UNIT_ASSERT_EQUAL(cache.generation,
+                          anjay_unlocked->observe.attrs_generation);
+
+    // Resource gone - its attributes are removed from Attribute Storage
+    _anjay_mock_dm_expect_list_instances(
+            anjay, &OBJ_NOATTRS, 0,
+            (const anjay_iid_t[]) { 1, ANJAY_ID_INVALID });
+    _anjay_mock_dm_expect_list_resources(anjay, &OBJ_NOATTRS, 1, 0, ABSENT);
+    AVS_UNIT_ASSERT_SUCCESS(_anjay_attr_storage_notify(anjay_unlocked, queue));
+    AVS_UNIT_ASSERT_NOT_EQUAL(cache.generation,
+                              anjay_unlocked->observe.attrs_generation);
+    _anjay_notify_clear_queue(&queue);
+
+    // Resource reappears - stored attributes must not come back
+    _anjay_mock_dm_expect_list_instances(
+            anjay, &OBJ_NOATTRS, 0,
+            (const anjay_iid_t[]) { 1, ANJAY_ID_INVALID });
+    _anjay_mock_dm_expect_list_resources(anjay, &OBJ_NOATTRS, 1, 0, PRESENT);
+    AVS_UNIT_ASSERT_SUCCESS(get_effective_attrs_cached(
+            anjay_unlocked, &cache, &attrs, &MAKE_RESOURCE_PATH(93, 1, 5), 1));
+    AVS_UNIT_ASSERT_EQUAL(attrs.common.max_period, 10);
+
+    ANJAY_MUTEX_UNLOCK(anjay);
     DM_TEST_FINISH;
 }
+#endif // ANJAY_WITH_ATTR_STORAGE
 
 AVS_UNIT_TEST(notify, epmin_greater_than_pmax) {
     static const anjay_dm_r_attributes_t ATTRS = {
@@ -1171,10 +1630,10 @@ AVS_UNIT_TEST(notify, extremes) {
     assert_observe_consistency(anjay);
     assert_observe_size(anjay, 1);
     ANJAY_MUTEX_LOCK(anjay_unlocked, anjay);
-    AVS_UNIT_ASSERT_NOT_NULL(
+    AVS_UNIT_ASSERT_TRUE(avs_time_monotonic_valid(
             AVS_SORTED_SET_FIRST(
                     anjay_unlocked->observe.connection_entries->observations)
-                    ->notify_task);
+                    ->trigger_time));
     ANJAY_MUTEX_UNLOCK(anjay);
 
     ////// EVEN LESS //////
@@ -1186,10 +1645,10 @@ AVS_UNIT_TEST(notify, extremes) {
     assert_observe_consistency(anjay);
     assert_observe_size(anjay, 1);
     ANJAY_MUTEX_LOCK(anjay_unlocked, anjay);
-    AVS_UNIT_ASSERT_NOT_NULL(
+    AVS_UNIT_ASSERT_TRUE(avs_time_monotonic_valid(
             AVS_SORTED_SET_FIRST(
                     anjay_unlocked->observe.connection_entries->observations)
-                    ->notify_task);
+                    ->trigger_time));
     ANJAY_MUTEX_UNLOCK(anjay);
 
     ////// IN BETWEEN //////
@@ -1206,10 +1665,10 @@ AVS_UNIT_TEST(notify, extremes) {
     assert_observe_consistency(anjay);
     assert_observe_size(anjay, 1);
     ANJAY_MUTEX_LOCK(anjay_unlocked, anjay);
-    AVS_UNIT_ASSERT_NOT_NULL(
+    AVS_UNIT_ASSERT_TRUE(avs_time_monotonic_valid(
             AVS_SORTED_SET_FIRST(
                     anjay_unlocked->observe.connection_entries->observations)
-                    ->notify_task);
+                    ->trigger_time));
     ANJAY_MUTEX_UNLOCK(anjay);
 
     ////// EQUAL - STILL NOT CROSSING //////
@@ -1221,10 +1680,10 @@ AVS_UNIT_TEST(notify, extremes) {
     assert_observe_consistency(anjay);
     assert_observe_size(anjay, 1);
     ANJAY_MUTEX_LOCK(anjay_unlocked, anjay);
-    AVS_UNIT_ASSERT_NOT_NULL(
+    AVS_UNIT_ASSERT_TRUE(avs_time_monotonic_valid(
             AVS_SORTED_SET_FIRST(
                     anjay_unlocked->observe.connection_entries->observations)
-                    ->notify_task);
+                    ->trigger_time));
     ANJAY_MUTEX_UNLOCK(anjay);
 
     ////// GREATER //////
@@ -1241,10 +1700,10 @@ AVS_UNIT_TEST(notify, extremes) {
     assert_observe_consistency(anjay);
     assert_observe_size(anjay, 1);
     ANJAY_MUTEX_LOCK(anjay_unlocked, anjay);
-    AVS_UNIT_ASSERT_NOT_NULL(
+    AVS_UNIT_ASSERT_TRUE(avs_time_monotonic_valid(
             AVS_SORTED_SET_FIRST(
                     anjay_unlocked->observe.connection_entries->observations)
-                    ->notify_task);
+                    ->trigger_time));
     ANJAY_MUTEX_UNLOCK(anjay);
 
     ////// STILL GREATER //////
@@ -1256,10 +1715,10 @@ AVS_UNIT_TEST(notify, extremes) {
     assert_observe_consistency(anjay);
     assert_observe_size(anjay, 1);
     ANJAY_MUTEX_LOCK(anjay_unlocked, anjay);
-    AVS_UNIT_ASSERT_NOT_NULL(
+    AVS_UNIT_ASSERT_TRUE(avs_time_monotonic_valid(
             AVS_SORTED_SET_FIRST(
                     anjay_unlocked->observe.connection_entries->observations)
-                    ->notify_task);
+                    ->trigger_time));
     ANJAY_MUTEX_UNLOCK(anjay);
 
     ////// LESS AGAIN //////
@@ -1276,10 +1735,10 @@ AVS_UNIT_TEST(notify, extremes) {
     assert_observe_consistency(anjay);
     assert_observe_size(anjay, 1);
     ANJAY_MUTEX_LOCK(anjay_unlocked, anjay);
-    AVS_UNIT_ASSERT_NOT_NULL(
+    AVS_UNIT_ASSERT_TRUE(avs_time_monotonic_valid(
             AVS_SORTED_SET_FIRST(
                     anjay_unlocked->observe.connection_entries->observations)
-                    ->notify_task);
+                    ->trigger_time));
     ANJAY_MUTEX_UNLOCK(anjay);
 
     DM_TEST_FINISH;
@@ -1329,10 +1788,10 @@ AVS_UNIT_TEST(notify, greater_only) {
     assert_observe_consistency(anjay);
     assert_observe_size(anjay, 1);
     ANJAY_MUTEX_LOCK(anjay_unlocked, anjay);
-    AVS_UNIT_ASSERT_NOT_NULL(
+    AVS_UNIT_ASSERT_TRUE(avs_time_monotonic_valid(
             AVS_SORTED_SET_FIRST(
                     anjay_unlocked->observe.connection_entries->observations)
-                    ->notify_task);
+                    ->trigger_time));
     ANJAY_MUTEX_UNLOCK(anjay);
 
     ////// LESS //////
@@ -1349,10 +1808,10 @@ AVS_UNIT_TEST(notify, greater_only) {
     assert_observe_consistency(anjay);
     assert_observe_size(anjay, 1);
     ANJAY_MUTEX_LOCK(anjay_unlocked, anjay);
-    AVS_UNIT_ASSERT_NOT_NULL(
+    AVS_UNIT_ASSERT_TRUE(avs_time_monotonic_valid(
             AVS_SORTED_SET_FIRST(
                     anjay_unlocked->observe.connection_entries->observations)
-                    ->notify_task);
+                    ->trigger_time));
     ANJAY_MUTEX_UNLOCK(anjay);
 
     ////// GREATER AGAIN //////
@@ -1369,10 +1828,10 @@ AVS_UNIT_TEST(notify, greater_only) {
     assert_observe_consistency(anjay);
     assert_observe_size(anjay, 1);
     ANJAY_MUTEX_LOCK(anjay_unlocked, anjay);
-    AVS_UNIT_ASSERT_NOT_NULL(
+    AVS_UNIT_ASSERT_TRUE(avs_time_monotonic_valid(
             AVS_SORTED_SET_FIRST(
                     anjay_unlocked->observe.connection_entries->observations)
-                    ->notify_task);
+                    ->trigger_time));
     ANJAY_MUTEX_UNLOCK(anjay);
 
     DM_TEST_FINISH;
@@ -1427,10 +1886,10 @@ AVS_UNIT_TEST(notify, less_only) {
     assert_observe_consistency(anjay);
     assert_observe_size(anjay, 1);
     ANJAY_MUTEX_LOCK(anjay_unlocked, anjay);
-    AVS_UNIT_ASSERT_NOT_NULL(
+    AVS_UNIT_ASSERT_TRUE(avs_time_monotonic_valid(
             AVS_SORTED_SET_FIRST(
                     anjay_unlocked->observe.connection_entries->observations)
-                    ->notify_task);
+                    ->trigger_time));
     ANJAY_MUTEX_UNLOCK(anjay);
 
     ////// STILL LESS //////
@@ -1442,10 +1901,10 @@ AVS_UNIT_TEST(notify, less_only) {
     assert_observe_consistency(anjay);
     assert_observe_size(anjay, 1);
     ANJAY_MUTEX_LOCK(anjay_unlocked, anjay);
-    AVS_UNIT_ASSERT_NOT_NULL(
+    AVS_UNIT_ASSERT_TRUE(avs_time_monotonic_valid(
             AVS_SORTED_SET_FIRST(
                     anjay_unlocked->observe.connection_entries->observations)
-                    ->notify_task);
+                    ->trigger_time));
     ANJAY_MUTEX_UNLOCK(anjay);
 
     ////// GREATER //////
@@ -1462,10 +1921,10 @@ AVS_UNIT_TEST(notify, less_only) {
     assert_observe_consistency(anjay);
     assert_observe_size(anjay, 1);
     ANJAY_MUTEX_LOCK(anjay_unlocked, anjay);
-    AVS_UNIT_ASSERT_NOT_NULL(
+    AVS_UNIT_ASSERT_TRUE(avs_time_monotonic_valid(
             AVS_SORTED_SET_FIRST(
                     anjay_unlocked->observe.connection_entries->observations)
-                    ->notify_task);
+                    ->trigger_time));
     ANJAY_MUTEX_UNLOCK(anjay);
 
     ////// LESS AGAIN //////
@@ -1482,10 +1941,10 @@ AVS_UNIT_TEST(notify, less_only) {
     assert_observe_consistency(anjay);
     assert_observe_size(anjay, 1);
     ANJAY_MUTEX_LOCK(anjay_unlocked, anjay);
-    AVS_UNIT_ASSERT_NOT_NULL(
+    AVS_UNIT_ASSERT_TRUE(avs_time_monotonic_valid(
             AVS_SORTED_SET_FIRST(
                     anjay_unlocked->observe.connection_entries->observations)
-                    ->notify_task);
+                    ->trigger_time));
     ANJAY_MUTEX_UNLOCK(anjay);
 
     DM_TEST_FINISH;
@@ -1534,10 +1993,10 @@ AVS_UNIT_TEST(notify, step) {
     assert_observe_consistency(anjay);
     assert_observe_size(anjay, 1);
     ANJAY_MUTEX_LOCK(anjay_unlocked, anjay);
-    AVS_UNIT_ASSERT_NOT_NULL(
+    AVS_UNIT_ASSERT_TRUE(avs_time_monotonic_valid(
             AVS_SORTED_SET_FIRST(
                     anjay_unlocked->observe.connection_entries->observations)
-                    ->notify_task);
+                    ->trigger_time));
     ANJAY_MUTEX_UNLOCK(anjay);
 
     ////// INCREASE BY EXACTLY stp //////
@@ -1554,10 +2013,10 @@ AVS_UNIT_TEST(notify, step) {
     assert_observe_consistency(anjay);
     assert_observe_size(anjay, 1);
     ANJAY_MUTEX_LOCK(anjay_unlocked, anjay);
-    AVS_UNIT_ASSERT_NOT_NULL(
+    AVS_UNIT_ASSERT_TRUE(avs_time_monotonic_valid(
             AVS_SORTED_SET_FIRST(
                     anjay_unlocked->observe.connection_entries->observations)
-                    ->notify_task);
+                    ->trigger_time));
     ANJAY_MUTEX_UNLOCK(anjay);
 
     ////// INCREASE BY OVER stp //////
@@ -1574,10 +2033,10 @@ AVS_UNIT_TEST(notify, step) {
     assert_observe_consistency(anjay);
     assert_observe_size(anjay, 1);
     ANJAY_MUTEX_LOCK(anjay_unlocked, anjay);
-    AVS_UNIT_ASSERT_NOT_NULL(
+    AVS_UNIT_ASSERT_TRUE(avs_time_monotonic_valid(
             AVS_SORTED_SET_FIRST(
                     anjay_unlocked->observe.connection_entries->observations)
-                    ->notify_task);
+                    ->trigger_time));
     ANJAY_MUTEX_UNLOCK(anjay);
 
     ////// NON-NUMERIC VALUE //////
@@ -1594,10 +2053,10 @@ AVS_UNIT_TEST(notify, step) {
     assert_observe_consistency(anjay);
     assert_observe_size(anjay, 1);
     ANJAY_MUTEX_LOCK(anjay_unlocked, anjay);
-    AVS_UNIT_ASSERT_NOT_NULL(
+    AVS_UNIT_ASSERT_TRUE(avs_time_monotonic_valid(
             AVS_SORTED_SET_FIRST(
                     anjay_unlocked->observe.connection_entries->observations)
-                    ->notify_task);
+                    ->trigger_time));
     ANJAY_MUTEX_UNLOCK(anjay);
 
     ////// BACK TO NUMBERS //////
@@ -1614,10 +2073,10 @@ AVS_UNIT_TEST(notify, step) {
     assert_observe_consistency(anjay);
     assert_observe_size(anjay, 1);
     ANJAY_MUTEX_LOCK(anjay_unlocked, anjay);
-    AVS_UNIT_ASSERT_NOT_NULL(
+    AVS_UNIT_ASSERT_TRUE(avs_time_monotonic_valid(
             AVS_SORTED_SET_FIRST(
                     anjay_unlocked->observe.connection_entries->observations)
-                    ->notify_task);
+                    ->trigger_time));
     ANJAY_MUTEX_UNLOCK(anjay);
 
     ////// TOO LITTLE DECREASE //////
@@ -1629,10 +2088,10 @@ AVS_UNIT_TEST(notify, step) {
     assert_observe_consistency(anjay);
     assert_observe_size(anjay, 1);
     ANJAY_MUTEX_LOCK(anjay_unlocked, anjay);
-    AVS_UNIT_ASSERT_NOT_NULL(
+    AVS_UNIT_ASSERT_TRUE(avs_time_monotonic_valid(
             AVS_SORTED_SET_FIRST(
                     anjay_unlocked->observe.connection_entries->observations)
-                    ->notify_task);
+                    ->trigger_time));
     ANJAY_MUTEX_UNLOCK(anjay);
 
     ////// DECREASE BY EXACTLY stp //////
@@ -1649,10 +2108,10 @@ AVS_UNIT_TEST(notify, step) {
     assert_observe_consistency(anjay);
     assert_observe_size(anjay, 1);
     ANJAY_MUTEX_LOCK(anjay_unlocked, anjay);
-    AVS_UNIT_ASSERT_NOT_NULL(
+    AVS_UNIT_ASSERT_TRUE(avs_time_monotonic_valid(
             AVS_SORTED_SET_FIRST(
                     anjay_unlocked->observe.connection_entries->observations)
-                    ->notify_task);
+                    ->trigger_time));
     ANJAY_MUTEX_UNLOCK(anjay);
 
     ////// DECREASE BY MORE THAN stp //////
@@ -1669,10 +2128,10 @@ AVS_UNIT_TEST(notify, step) {
     assert_observe_consistency(anjay);
     assert_observe_size(anjay, 1);
     ANJAY_MUTEX_LOCK(anjay_unlocked, anjay);
-    AVS_UNIT_ASSERT_NOT_NULL(
+    AVS_UNIT_ASSERT_TRUE(avs_time_monotonic_valid(
             AVS_SORTED_SET_FIRST(
                     anjay_unlocked->observe.connection_entries->observations)
-                    ->notify_task);
+                    ->trigger_time));
     ANJAY_MUTEX_UNLOCK(anjay);
 
     ////// INCREASE BY EXACTLY stp //////
@@ -1689,10 +2148,10 @@ AVS_UNIT_TEST(notify, step) {
     assert_observe_consistency(anjay);
     assert_observe_size(anjay, 1);
     ANJAY_MUTEX_LOCK(anjay_unlocked, anjay);
-    AVS_UNIT_ASSERT_NOT_NULL(
+    AVS_UNIT_ASSERT_TRUE(avs_time_monotonic_valid(
             AVS_SORTED_SET_FIRST(
                     anjay_unlocked->observe.connection_entries->observations)
-                    ->notify_task);
+                    ->trigger_time));
     ANJAY_MUTEX_UNLOCK(anjay);
 
     DM_TEST_FINISH;
@@ -336,3 +336,42 @@ AVS_UNIT_TEST(snprintf, no_space_for_terminating_nullbyte) {
 AVS_UNIT_TEST(binding_mode_valid, unsupported_binding_mode) {
     AVS_UNIT_ASSERT_FALSE(anjay_binding_mode_valid("☃"));
 }
+
+#define TEST_DOUBLE_TO_STRING(Value, Expected) \
+    AVS_UNIT_ASSERT_EQUAL_STRING(ANJAY_DOUBLE_TO_STRING(Value), Expected)
+
+AVS_UNIT_TEST(double_to_string, fixed_point) {
+    TEST_DOUBLE_TO_STRING(0.0, "0");
+    TEST_DOUBLE_TO_STRING(-0.0, "-0");
+    TEST_DOUBLE_TO_STRING(21.5, "21.5");
+    TEST_DOUBLE_TO_STRING(-21.5, "-21.5");
+    TEST_DOUBLE_TO_STRING(0.1, "0.1");
+    TEST_DOUBLE_TO_STRING(0.3, "0.3");
+    TEST_DOUBLE_TO_STRING(0.07, "0.07");
+    TEST_DOUBLE_TO_STRING(100.0, "100");
+    TEST_DOUBLE_TO_STRING(123456.789, "123456.789");
+    TEST_DOUBLE_TO_STRING(3.141592653589793, "3.141592653589793");
+    TEST_DOUBLE_TO_STRING(9007199254740991.0, "9007199254740991");
+    TEST_DOUBLE_TO_STRING(1e-20, "0.00000000000000000001");
+}
+
+AVS_UNIT_TEST(double_to_string, fallback) {
+    TEST_DOUBLE_TO_STRING(3.26e+218, "3.26e+218");
+    TEST_DOUBLE_TO_STRING(1.0 / 3.0, "0.3333333333333333");
+    TEST_DOUBLE_TO_STRING((double) 21.3f, "21.299999237060547");
+}
+
+AVS_UNIT_TEST(double_to_string, round_trip) {
+    static const double VALUES[] = {
+        1.5e20, 1e300, 2.2250738585072014e-308, 1.7976931348623157e308,
+        1.0 / 3.0, 22.0 / 7.0, -4.2229999965160742e+37
+    };
+    for (size_t i = 0; i < AVS_ARRAY_SIZE(VALUES); ++i) {
+        double parsed;
+        AVS_UNIT_ASSERT_SUCCESS(
+                _anjay_safe_strtod(ANJAY_DOUBLE_TO_STRING(VALUES[i]), &parsed));
+        AVS_UNIT_ASSERT_EQUAL_BYTES_SIZED(&parsed, &VALUES[i], sizeof(double));
+    }
+}
+
+#undef TEST_DOUBLE_TO_STRING
@@ -0,0 +1,53 @@
+/*
+ * Copyright 2017-2026 AVSystem <avsystem@avsystem.com>
+ * AVSystem Anjay LwM2M SDK
+ * All rights reserved.
+ *
+ * Licensed under AVSystem Anjay LwM2M Client SDK - Non-Commercial License.
+ * See the attached LICENSE file for details.
+ */
+
+#include <anjay_init.h>
+
+#include <math.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "src/core/anjay_utils_private.h"
+
+/**
+ * Interprets the input as the bit pattern of a double, and checks that
+ * formatting it with ANJAY_DOUBLE_TO_STRING() and parsing it back yields
+ * a bit-exact copy of the original value.
+ */
+int main(int argc, char **argv) {
+    (void) argc;
+    (void) argv;
+
+    uint64_t bits = 0;
+    uint8_t input[sizeof(bits)];
+    size_t input_size = fread(input, 1, sizeof(input), stdin);
+    for (size_t i = 0; i < input_size; ++i) {
+        bits |= (uint64_t) input[i] << (8 * i);
+    }
+    double value;
+    memcpy(&value, &bits, sizeof(value));
+
+    const char *str = ANJAY_DOUBLE_TO_STRING(value);
+    char *endptr = NULL;
+    double parsed = strtod(str, &endptr);
+    if (!endptr || *endptr) {
+        abort();
+    }
+    if (isnan(value)) {
+        // NaN payloads are not representable in text
+        if (!isnan(parsed)) {
+            abort();
+        }
+    } else if (memcmp(&parsed, &value, sizeof(value))) {
+        abort();
+    }
+    return 0;
+}
@@ -83,6 +83,71 @@ AVS_UNIT_TEST(lwm2m_gateway, add_and_remove_instances) {
     DM_TEST_FINISH;
 }
 
+AVS_UNIT_TEST(lwm2m_gateway, many_devices) {
+    LWM2M_GATEWAY_TESTS_INIT();
+    static const int DEVICE_COUNT = 10000;
+
+    for (int i = 0; i < DEVICE_COUNT; ++i) {
+        iid = ANJAY_ID_INVALID;
+        AVS_UNIT_ASSERT_SUCCESS(
+                anjay_lwm2m_gateway_register_device(anjay, "SN", &iid));
+        AVS_UNIT_ASSERT_EQUAL(iid, i);
+    }
+
+    ANJAY_MUTEX_LOCK(anjay_unlocked, anjay);
+    for (int i = 0; i < DEVICE_COUNT; ++i) {
+        char prefix[ANJAY_GATEWAY_MAX_PREFIX_LEN];
+        AVS_UNIT_ASSERT_TRUE(
+                avs_simple_snprintf(prefix, sizeof(prefix), "dev%d", i) > 0);
+        const anjay_dm_t *dm = NULL;
+        AVS_UNIT_ASSERT_SUCCESS(
+                _anjay_lwm2m_gateway_prefix_to_dm(anjay_unlocked, prefix, &dm));
+        AVS_UNIT_ASSERT_TRUE(dm == &find_instance(gw, (anjay_iid_t) i)->dm);
+    }
+    static const char *const INVALID_PREFIXES[] = {
+        "dev", "dev01", "dev-1", "dev1x", "dev10000", "dev65535", "Dev1"
+    };
+    for (size_t i = 0; i < AVS_ARRAY_SIZE(INVALID_PREFIXES); ++i) {
+        const anjay_dm_t *dm = NULL;
+        AVS_UNIT_ASSERT_FAILED(_anjay_lwm2m_gateway_prefix_to_dm(
+                anjay_unlocked, INVALID_PREFIXES[i], &dm));
+    }
+    ANJAY_MUTEX_UNLOCK(anjay);
+
+    // released IIDs are reused, lowest first
+    AVS_UNIT_ASSERT_SUCCESS(anjay_lwm2m_gateway_deregister_device(anjay, 5000));
+    AVS_UNIT_ASSERT_SUCCESS(anjay_lwm2m_gateway_deregister_device(anjay, 9999));
+    AVS_UNIT_ASSERT_SUCCESS(anjay_lwm2m_gateway_deregister_device(anjay, 17));
+    static const anjay_iid_t EXPECTED_IIDS[] = { 17, 5000, 9999, 10000 };
+    for (size_t i = 0; i < AVS_ARRAY_SIZE(EXPECTED_IIDS); ++i) {
+        iid = ANJAY_ID_INVALID;
+        AVS_UNIT_ASSERT_SUCCESS(
+                anjay_lwm2m_gateway_register_device(anjay, "SN", &iid));
+        AVS_UNIT_ASSERT_EQUAL(iid, EXPECTED_IIDS[i]);
+    }
+
+    // explicitly requested IIDs are not assigned again
+    iid = 10002;
+    AVS_UNIT_ASSERT_SUCCESS(
+            anjay_lwm2m_gateway_register_device(anjay, "SN", &iid));
+    iid = 4000;
+    AVS_UNIT_ASSERT_FAILED(
+            anjay_lwm2m_gateway_register_device(anjay, "SN", &iid));
+    AVS_UNIT_ASSERT_SUCCESS(anjay_lwm2m_gateway_deregister_device(anjay, 4000));
+    iid = 4000;
+    AVS_UNIT_ASSERT_SUCCESS(
+            anjay_lwm2m_gateway_register_device(anjay, "SN", &iid));
+    static const anjay_iid_t EXPECTED_IIDS_2[] = { 10001, 10003 };
+    for (size_t i = 0; i < AVS_ARRAY_SIZE(EXPECTED_IIDS_2); ++i) {
+        iid = ANJAY_ID_INVALID;
+        AVS_UNIT_ASSERT_SUCCESS(
+                anjay_lwm2m_gateway_register_device(anjay, "SN", &iid));
+        AVS_UNIT_ASSERT_EQUAL(iid, EXPECTED_IIDS_2[i]);
+    }
+
+    DM_TEST_FINISH;
+}
+
 AVS_UNIT_TEST(lwm2m_gateway, register_and_deregister_before_installing) {
     DM_TEST_INIT_WITH_OBJECTS(&FAKE_SECURITY, &FAKE_SERVER);
 